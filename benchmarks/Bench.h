@@ -0,0 +1,76 @@
+//
+// Created by SIMEON on 10/17/2026.
+//
+
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <limits>
+#include <random>
+#include <string>
+#include <type_traits>
+
+// Shared helpers for idk_bench. Every benchmark times the engine code
+// against the simplest reference implementation of the same job and prints
+// one row per case.
+namespace IDK::Bench
+{
+    // Seeded so runs are comparable between builds.
+    inline std::mt19937& Rng() {
+        static std::mt19937 rng(0x1D4Bu);
+        return rng;
+    }
+
+    // Best of `repeats` runs of fn, in milliseconds.
+    template<typename F>
+    double BestOf(int repeats, F&& fn) {
+        double best = std::numeric_limits<double>::max();
+        for (int i = 0; i < repeats; ++i) {
+            const auto start = std::chrono::steady_clock::now();
+            fn();
+            const auto end = std::chrono::steady_clock::now();
+            best = std::min(best, std::chrono::duration<double, std::milli>(end - start).count());
+        }
+        return best;
+    }
+
+    template<typename T>
+    inline volatile T KeepSink{};
+
+    // Keeps a result alive so the optimizer cannot drop the work behind it.
+    template<typename T>
+    void Keep(T value) {
+        static_assert(std::is_trivially_copyable_v<T>);
+        KeepSink<T> = value;
+    }
+
+    inline void Header(const char* title, const char* engineLabel, const char* referenceLabel) {
+        std::printf("\n== %s\n", title);
+        std::printf("%-28s %10s %12s %12s %9s\n", "case", "n", engineLabel, referenceLabel, "speedup");
+    }
+
+    // Times are in milliseconds; a negative reference time leaves the
+    // reference columns empty.
+    inline void Row(const std::string& name, size_t count, double engineMs, double referenceMs) {
+        if (referenceMs < 0.0) {
+            std::printf("%-28s %10zu %12.3f %12s %9s\n", name.c_str(), count, engineMs, "-", "-");
+            return;
+        }
+        std::printf("%-28s %10zu %12.3f %12.3f %8.2fx\n", name.c_str(), count, engineMs, referenceMs,
+                    engineMs > 0.0 ? referenceMs / engineMs : 0.0);
+    }
+
+    void RunECS();
+    void RunMeshOptimizer();
+    void RunRenderQueue();
+    void RunFrustumCulling();
+    void RunDynamicAABBTree();
+    void RunLightClusterer();
+    void RunBlockPool();
+}
+
+#endif //BENCH_H
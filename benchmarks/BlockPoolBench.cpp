@@ -0,0 +1,138 @@
+//
+// Created by SIMEON on 10/17/2026.
+//
+
+#include <cmath>
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "glm.hpp"
+#include "gtc/constants.hpp"
+
+#include "Bench.h"
+#include "PoolAllocator.h"
+
+// Mesh churn on BlockPool: a scene keeps a few hundred procedural meshes
+// alive and every frame replaces some with new ones of other sizes, as the
+// editor does when shapes are edited. BlockPool memory should stop growing
+// once the size classes have seen the largest working set.
+namespace
+{
+    using IDK::BlockPool;
+    using IDK::PoolAllocator;
+
+    struct Vertex {
+        glm::vec3 position;
+        glm::vec3 normal;
+    };
+
+    // Graphics::Mesh needs GLFW and a GL context, so this mirrors what it
+    // allocates: the object itself from BlockPool and both vectors through
+    // MeshPoolAllocator (PoolAllocator).
+    struct ChurnMesh {
+        std::string name;
+        std::vector<Vertex, PoolAllocator<Vertex>> vertices;
+        std::vector<unsigned int, PoolAllocator<unsigned int>> indices;
+
+        static void* operator new(std::size_t size) { return BlockPool::Allocate(size, alignof(ChurnMesh)); }
+        static void operator delete(void* ptr, std::size_t size) { BlockPool::Deallocate(ptr, size, alignof(ChurnMesh)); }
+    };
+
+    // Stack/sector layout of Mesh::CreateSphere, grown by push_back like it.
+    std::unique_ptr<ChurnMesh> MakeSphere(unsigned int stacks, unsigned int sectors) {
+        auto mesh = std::make_unique<ChurnMesh>();
+        mesh->name = "Sphere " + std::to_string(stacks) + "x" + std::to_string(sectors);
+        for (unsigned int i = 0; i <= stacks; ++i) {
+            const float phi = glm::pi<float>() * static_cast<float>(i) / static_cast<float>(stacks);
+            for (unsigned int j = 0; j <= sectors; ++j) {
+                const float theta = glm::two_pi<float>() * static_cast<float>(j) / static_cast<float>(sectors);
+                const glm::vec3 p(std::sin(phi) * std::cos(theta), std::cos(phi), std::sin(phi) * std::sin(theta));
+                mesh->vertices.push_back({p, p});
+            }
+        }
+        for (unsigned int i = 0; i < stacks; ++i) {
+            for (unsigned int j = 0; j < sectors; ++j) {
+                const unsigned int a = i * (sectors + 1) + j;
+                const unsigned int b = a + sectors + 1;
+                mesh->indices.insert(mesh->indices.end(), {a, b, a + 1, b, b + 1, a + 1});
+            }
+        }
+        return mesh;
+    }
+
+    struct PoolUsage {
+        size_t reservedBytes = 0;
+        size_t blocksOutstanding = 0;
+    };
+
+    PoolUsage Usage() {
+        PoolUsage usage;
+        for (const BlockPool::ClassStats& stats : BlockPool::GetStats()) {
+            usage.reservedBytes += stats.reservedBytes;
+            usage.blocksOutstanding += stats.blocksOutstanding;
+        }
+        return usage;
+    }
+}
+
+namespace IDK::Bench
+{
+    void RunBlockPool() {
+        constexpr size_t LiveMeshes = 512;
+        constexpr size_t ReplacedPerFrame = 64;
+        constexpr int Frames = 1000;
+        constexpr int ReportEvery = 100;
+
+        std::printf("\n== BlockPool mesh churn (%zu live meshes, %zu replaced per frame)\n", LiveMeshes, ReplacedPerFrame);
+        std::printf("%-10s %12s %12s %12s %12s %10s\n", "frame", "live KB", "reserved KB", "growth KB", "blocks", "frame ms");
+
+        // Other benchmarks may have used the pool already; only growth from here counts.
+        const PoolUsage baseline = Usage();
+
+        auto& rng = Rng();
+        std::uniform_int_distribution<unsigned int> resolution(4, 40);
+        std::uniform_int_distribution<size_t> slot(0, LiveMeshes - 1);
+
+        std::vector<std::unique_ptr<ChurnMesh>> meshes(LiveMeshes);
+        for (auto& mesh : meshes)
+            mesh = MakeSphere(resolution(rng), resolution(rng));
+
+        size_t previousReserved = Usage().reservedBytes;
+        size_t reservedAtHalf = 0;
+        for (int frame = 1; frame <= Frames; ++frame) {
+            const double ms = BestOf(1, [&] {
+                for (size_t i = 0; i < ReplacedPerFrame; ++i) {
+                    std::unique_ptr<ChurnMesh>& mesh = meshes[slot(rng)];
+                    mesh.reset();
+                    mesh = MakeSphere(resolution(rng), resolution(rng));
+                }
+            });
+
+            const PoolUsage usage = Usage();
+            if (frame == Frames / 2) reservedAtHalf = usage.reservedBytes;
+            if (frame % ReportEvery == 0) {
+                size_t liveBytes = 0;
+                for (const auto& mesh : meshes)
+                    liveBytes += sizeof(ChurnMesh) + mesh->vertices.capacity() * sizeof(Vertex) +
+                                 mesh->indices.capacity() * sizeof(unsigned int);
+                std::printf("%-10d %12.1f %12.1f %12.1f %12zu %10.3f\n", frame, liveBytes / 1024.0,
+                            (usage.reservedBytes - baseline.reservedBytes) / 1024.0,
+                            (usage.reservedBytes - previousReserved) / 1024.0,
+                            usage.blocksOutstanding - baseline.blocksOutstanding, ms);
+                previousReserved = usage.reservedBytes;
+            }
+        }
+
+        const size_t reservedAtEnd = Usage().reservedBytes;
+        std::printf("  reserved over the second half: %+.1f KB\n",
+                    (static_cast<double>(reservedAtEnd) - static_cast<double>(reservedAtHalf)) / 1024.0);
+
+        meshes.clear();
+        std::printf("  after destroying every mesh: %zu blocks left in the thread cache, %.1f KB kept for reuse\n",
+                    Usage().blocksOutstanding - baseline.blocksOutstanding,
+                    (Usage().reservedBytes - baseline.reservedBytes) / 1024.0);
+    }
+}
@@ -0,0 +1,169 @@
+//
+// Created by SIMEON on 10/17/2026.
+//
+
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "gtc/matrix_transform.hpp"
+
+#include "Bench.h"
+#include "DynamicAABBTree.h"
+
+// DynamicAABBTree against brute force over a flat array of boxes. Objects
+// are spread at a constant density, so the world grows with the count and
+// queries return about the same number of hits at every size.
+namespace
+{
+    using IDK::AABB;
+
+    AABB Box(const glm::vec3& center, float halfSize) {
+        return {center - glm::vec3(halfSize), center + glm::vec3(halfSize)};
+    }
+
+    bool Overlaps(const AABB& a, const AABB& b) {
+        return a.min.x <= b.max.x && a.max.x >= b.min.x &&
+               a.min.y <= b.max.y && a.max.y >= b.min.y &&
+               a.min.z <= b.max.z && a.max.z >= b.min.z;
+    }
+
+    // Distance along the ray to the box, or infinity when it misses.
+    float RayHit(const AABB& box, const glm::vec3& origin, const glm::vec3& inverseDirection, float maxDistance) {
+        const glm::vec3 t0 = (box.min - origin) * inverseDirection;
+        const glm::vec3 t1 = (box.max - origin) * inverseDirection;
+        const glm::vec3 near = glm::min(t0, t1);
+        const glm::vec3 far = glm::max(t0, t1);
+        const float entry = std::max(std::max(near.x, near.y), std::max(near.z, 0.0f));
+        const float exit = std::min(std::min(far.x, far.y), std::min(far.z, maxDistance));
+        return entry <= exit ? entry : std::numeric_limits<float>::infinity();
+    }
+
+    void RunSize(size_t count) {
+        using namespace IDK::Bench;
+        auto& rng = Rng();
+
+        const float world = std::cbrt(static_cast<float>(count)) * 4.0f;
+        std::uniform_real_distribution<float> coordinate(0.0f, world), size(0.25f, 1.0f), jitter(-0.05f, 0.05f);
+
+        std::vector<AABB> boxes(count);
+        for (AABB& box : boxes)
+            box = Box(glm::vec3(coordinate(rng), coordinate(rng), coordinate(rng)), size(rng));
+
+        // Insert
+        IDK::DynamicAABBTree tree;
+        std::vector<int32_t> proxies(count);
+        const double insertTree = BestOf(1, [&] {
+            for (size_t i = 0; i < count; ++i)
+                proxies[i] = tree.createProxy(boxes[i], static_cast<uint32_t>(i));
+        });
+        std::vector<AABB> flat;
+        const double insertFlat = BestOf(1, [&] {
+            flat.clear();
+            for (const AABB& box : boxes) flat.push_back(box);
+        });
+        Row("insert", count, insertTree, insertFlat);
+
+        // Update: every object drifts a little, like a frame of slow motion,
+        // and 1% teleport, which forces a reinsert.
+        std::vector<AABB> moved = boxes;
+        for (size_t i = 0; i < count; ++i) {
+            const glm::vec3 offset = i % 100 == 0 ? glm::vec3(coordinate(rng), coordinate(rng), coordinate(rng)) - moved[i].center()
+                                                  : glm::vec3(jitter(rng), jitter(rng), jitter(rng));
+            moved[i].min += offset;
+            moved[i].max += offset;
+        }
+        size_t reinserted = 0;
+        const double updateTree = BestOf(1, [&] {
+            for (size_t i = 0; i < count; ++i)
+                reinserted += tree.moveProxy(proxies[i], moved[i]);
+        });
+        const double updateFlat = BestOf(1, [&] {
+            for (size_t i = 0; i < count; ++i) flat[i] = moved[i];
+        });
+        Row("update (" + std::to_string(reinserted * 100 / count) + "% reinserted)", count, updateTree, updateFlat);
+
+        // 100 overlap queries with an 8-unit box, a few dozen hits each.
+        constexpr int Queries = 100;
+        std::vector<AABB> regions(Queries);
+        for (AABB& region : regions)
+            region = Box(glm::vec3(coordinate(rng), coordinate(rng), coordinate(rng)), 4.0f);
+
+        size_t treeHits = 0, flatHits = 0;
+        const double overlapTree = BestOf(3, [&] {
+            treeHits = 0;
+            for (const AABB& region : regions)
+                tree.queryOverlap(region, [&](uint32_t index) { treeHits += Overlaps(flat[index], region); return true; });
+        });
+        const double overlapFlat = BestOf(3, [&] {
+            flatHits = 0;
+            for (const AABB& region : regions)
+                for (const AABB& box : flat) flatHits += Overlaps(box, region);
+        });
+        Row("100 overlap queries", count, overlapTree, overlapFlat);
+
+        // 100 nearest-hit ray casts across the world.
+        std::vector<glm::vec3> origins(Queries), directions(Queries);
+        std::normal_distribution<float> normal;
+        for (int q = 0; q < Queries; ++q) {
+            origins[q] = glm::vec3(coordinate(rng), coordinate(rng), coordinate(rng));
+            directions[q] = glm::normalize(glm::vec3(normal(rng), normal(rng), normal(rng)));
+        }
+        float treeNearest = 0.0f, flatNearest = 0.0f;
+        const double rayTree = BestOf(3, [&] {
+            treeNearest = 0.0f;
+            for (int q = 0; q < Queries; ++q) {
+                const glm::vec3 inverse = 1.0f / directions[q];
+                float nearest = world;
+                tree.rayCast(origins[q], directions[q], world, [&](uint32_t index, float maxDistance) {
+                    const float hit = RayHit(flat[index], origins[q], inverse, maxDistance);
+                    if (hit > maxDistance) return maxDistance;
+                    nearest = std::min(nearest, hit);
+                    return std::max(hit, std::numeric_limits<float>::min());
+                });
+                treeNearest += nearest;
+            }
+        });
+        const double rayFlat = BestOf(3, [&] {
+            flatNearest = 0.0f;
+            for (int q = 0; q < Queries; ++q) {
+                const glm::vec3 inverse = 1.0f / directions[q];
+                float nearest = world;
+                for (const AABB& box : flat) nearest = std::min(nearest, RayHit(box, origins[q], inverse, nearest));
+                flatNearest += nearest;
+            }
+        });
+        Row("100 nearest ray casts", count, rayTree, rayFlat);
+
+        // One camera frustum, reporting candidates like the geometry pass.
+        const glm::vec3 eye(world * 0.5f, world * 0.5f, world * 0.5f);
+        const glm::mat4 viewProjection = glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, world * 0.25f) *
+                                         glm::lookAt(eye, eye + glm::vec3(0.0f, 0.0f, -1.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+        const IDK::Graphics::Frustum frustum = IDK::Graphics::Frustum::FromMatrix(viewProjection);
+        size_t frustumHits = 0;
+        const double frustumTree = BestOf(3, [&] {
+            frustumHits = 0;
+            tree.queryFrustum(frustum, [&](uint32_t) { ++frustumHits; return true; });
+        });
+        IDK::Graphics::FrustumCuller culler;
+        culler.reserve(count);
+        for (const AABB& box : flat) culler.add(box);
+        std::vector<uint8_t> visible;
+        const double frustumFlat = BestOf(3, [&] { culler.classify(frustum, visible); Keep(visible[0]); });
+        Row("frustum query vs SoA cull", count, frustumTree, frustumFlat);
+
+        if (treeHits != flatHits || treeNearest != flatNearest)
+            std::printf("  mismatch: overlap %zu vs %zu, nearest %.3f vs %.3f\n", treeHits, flatHits, treeNearest, flatNearest);
+        std::printf("  height %d, area ratio %.2f, %zu frustum candidates\n", tree.getHeight(), tree.getAreaRatio(), frustumHits);
+    }
+}
+
+namespace IDK::Bench
+{
+    void RunDynamicAABBTree() {
+        Header("Dynamic AABB tree", "tree ms", "brute ms");
+        for (size_t count : {10000u, 100000u, 1000000u})
+            RunSize(count);
+    }
+}
@@ -0,0 +1,161 @@
+//
+// Created by SIMEON on 10/17/2026.
+//
+
+#include <memory>
+#include <numeric>
+#include <typeindex>
+#include <unordered_map>
+#include <vector>
+
+#include "Bench.h"
+#include "ComponentManager.h"
+
+// Sparse-set ComponentManager against the map-of-maps storage it replaced:
+// one unordered_map per type, keyed by entity, holding make_shared components.
+namespace
+{
+    struct Position : Component {
+        Position() : Component("Position") {}
+        float x = 0.0f, y = 0.0f, z = 0.0f;
+    };
+
+    struct Velocity : Component {
+        Velocity() : Component("Velocity") {}
+        float x = 1.0f, y = 0.0f, z = 0.0f;
+    };
+
+    class MapOfMaps {
+    public:
+        template<typename T>
+        T& add(EntityID id) {
+            auto component = std::make_shared<T>();
+            T& ref = *component;
+            m_components[typeid(T)][id] = std::move(component);
+            return ref;
+        }
+
+        template<typename T>
+        T* get(EntityID id) const {
+            const auto type = m_components.find(typeid(T));
+            if (type == m_components.end()) return nullptr;
+            const auto it = type->second.find(id);
+            return it != type->second.end() ? static_cast<T*>(it->second.get()) : nullptr;
+        }
+
+        template<typename T>
+        void remove(EntityID id) {
+            const auto type = m_components.find(typeid(T));
+            if (type != m_components.end()) type->second.erase(id);
+        }
+
+        template<typename T, typename F>
+        void each(F&& fn) {
+            for (auto& [id, component] : m_components[typeid(T)])
+                fn(id, static_cast<T&>(*component));
+        }
+
+    private:
+        std::unordered_map<std::type_index, std::unordered_map<EntityID, std::shared_ptr<Component>>> m_components;
+    };
+
+    // Sums positions so iteration has something to keep.
+    struct Integrate {
+        float total = 0.0f;
+        void operator()(Position& p, const Velocity& v) {
+            p.x += v.x;
+            total += p.x;
+        }
+    };
+
+    void RunSize(size_t count) {
+        using namespace IDK::Bench;
+        const auto n = static_cast<EntityID>(count);
+        const int repeats = count > 100000 ? 3 : 5;
+
+        std::vector<EntityID> shuffled(count);
+        std::iota(shuffled.begin(), shuffled.end(), 0u);
+        std::shuffle(shuffled.begin(), shuffled.end(), Rng());
+
+        const double addPools = BestOf(repeats, [&] {
+            ComponentManager manager;
+            for (EntityID id = 0; id < n; ++id) {
+                manager.addComponent<Position>(id);
+                manager.addComponent<Velocity>(id);
+            }
+        });
+        const double addMaps = BestOf(repeats, [&] {
+            MapOfMaps maps;
+            for (EntityID id = 0; id < n; ++id) {
+                maps.add<Position>(id);
+                maps.add<Velocity>(id);
+            }
+        });
+        Row("add 2 components", count, addPools, addMaps);
+
+        ComponentManager manager;
+        MapOfMaps maps;
+        for (EntityID id = 0; id < n; ++id) {
+            manager.addComponent<Position>(id);
+            manager.addComponent<Velocity>(id);
+            maps.add<Position>(id);
+            maps.add<Velocity>(id);
+        }
+
+        const double iteratePools = BestOf(repeats, [&] {
+            Integrate integrate;
+            const auto* positions = manager.getPool<Position>();
+            const auto* velocities = manager.getPool<Velocity>();
+            const auto& entities = positions->entities();
+            const auto& components = positions->components();
+            for (size_t i = 0; i < entities.size(); ++i) {
+                if (const Velocity* v = velocities->get(entities[i]))
+                    integrate(*components[i], *v);
+            }
+            Keep(integrate.total);
+        });
+        const double iterateMaps = BestOf(repeats, [&] {
+            Integrate integrate;
+            maps.each<Position>([&](EntityID id, Position& p) {
+                if (const Velocity* v = maps.get<Velocity>(id))
+                    integrate(p, *v);
+            });
+            Keep(integrate.total);
+        });
+        Row("iterate Position+Velocity", count, iteratePools, iterateMaps);
+
+        const double getPools = BestOf(repeats, [&] {
+            float total = 0.0f;
+            for (EntityID id : shuffled) total += manager.getComponent<Position>(id)->x;
+            Keep(total);
+        });
+        const double getMaps = BestOf(repeats, [&] {
+            float total = 0.0f;
+            for (EntityID id : shuffled) total += maps.get<Position>(id)->x;
+            Keep(total);
+        });
+        Row("random getComponent", count, getPools, getMaps);
+
+        // Removing and re-adding half the entities in random order is the
+        // churn a spawner produces; it also exercises the pool's free slots.
+        const size_t half = count / 2;
+        const double churnPools = BestOf(repeats, [&] {
+            for (size_t i = 0; i < half; ++i) manager.removeComponent<Velocity>(shuffled[i]);
+            for (size_t i = 0; i < half; ++i) manager.addComponent<Velocity>(shuffled[i]);
+        });
+        const double churnMaps = BestOf(repeats, [&] {
+            for (size_t i = 0; i < half; ++i) maps.remove<Velocity>(shuffled[i]);
+            for (size_t i = 0; i < half; ++i) maps.add<Velocity>(shuffled[i]);
+        });
+        Row("remove+add half", count, churnPools, churnMaps);
+    }
+}
+
+namespace IDK::Bench
+{
+    void RunECS() {
+        Header("ECS component storage", "pools ms", "map ms");
+        for (size_t count : {10000u, 100000u, 1000000u})
+            RunSize(count);
+    }
+}
@@ -0,0 +1,78 @@
+//
+// Created by SIMEON on 10/17/2026.
+//
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include "gtc/matrix_transform.hpp"
+
+#include "Bench.h"
+#include "FrustumCulling.h"
+
+// FrustumCuller's SoA kernel against a per-box loop over AABBs testing each
+// plane's most positive corner.
+namespace
+{
+    using IDK::Graphics::Frustum;
+    using IDK::Graphics::FrustumCuller;
+
+    void CullNaive(const Frustum& frustum, const std::vector<IDK::AABB>& boxes, std::vector<uint8_t>& visible) {
+        visible.resize(boxes.size());
+        for (size_t i = 0; i < boxes.size(); ++i) {
+            const IDK::AABB& box = boxes[i];
+            bool outside = false;
+            for (const glm::vec4& plane : frustum.planes) {
+                const glm::vec3 corner(plane.x >= 0.0f ? box.max.x : box.min.x,
+                                       plane.y >= 0.0f ? box.max.y : box.min.y,
+                                       plane.z >= 0.0f ? box.max.z : box.min.z);
+                if (glm::dot(glm::vec3(plane), corner) + plane.w < 0.0f) {
+                    outside = true;
+                    break;
+                }
+            }
+            visible[i] = outside ? 0 : 1;
+        }
+    }
+}
+
+namespace IDK::Bench
+{
+    void RunFrustumCulling() {
+#if defined(__AVX__)
+        const char* kernel = "AVX";
+#elif defined(__SSE2__) || defined(_M_X64)
+        const char* kernel = "SSE2";
+#else
+        const char* kernel = "scalar";
+#endif
+        Header((std::string("Frustum culling, ") + kernel + " kernel").c_str(), "soa ms", "aos ms");
+
+        const glm::mat4 projection = glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 500.0f);
+        const glm::mat4 view = glm::lookAt(glm::vec3(0.0f, 10.0f, 0.0f), glm::vec3(0.0f, 10.0f, -1.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+        const Frustum frustum = Frustum::FromMatrix(projection * view);
+
+        std::uniform_real_distribution<float> position(-500.0f, 500.0f), height(0.0f, 50.0f), size(0.5f, 4.0f);
+        for (size_t count : {10000u, 100000u, 1000000u}) {
+            std::vector<AABB> boxes;
+            FrustumCuller culler;
+            culler.reserve(count);
+            for (size_t i = 0; i < count; ++i) {
+                const glm::vec3 center(position(Rng()), height(Rng()), position(Rng()));
+                const glm::vec3 extents(size(Rng()));
+                boxes.push_back({center - extents, center + extents});
+                culler.add(boxes.back());
+            }
+
+            std::vector<uint8_t> visible, naive;
+            const int repeats = count > 100000 ? 10 : 50;
+            const double soa = BestOf(repeats, [&] { culler.classify(frustum, visible); Keep(visible[0]); });
+            const double aos = BestOf(repeats, [&] { CullNaive(frustum, boxes, naive); Keep(naive[0]); });
+
+            size_t visibleCount = 0;
+            for (uint8_t flag : visible) visibleCount += flag;
+            Row("cull (" + std::to_string(visibleCount * 100 / count) + "% visible)", count, soa, aos);
+        }
+    }
+}
@@ -0,0 +1,156 @@
+//
+// Created by SIMEON on 10/17/2026.
+//
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "gtc/matrix_transform.hpp"
+
+#include "Bench.h"
+#include "JobSystem.h"
+#include "LightClusterer.h"
+
+// LightClusterer's binning against testing every light's bounding sphere
+// against every cluster's full view-space box. Lights are spread through a
+// street-sized volume in front of the camera, a quarter of them spots.
+namespace
+{
+    using IDK::Graphics::LightClusterer;
+
+    constexpr float NearPlane = 0.1f;
+    constexpr float FarPlane = 200.0f;
+
+    struct Sphere {
+        glm::vec3 center;
+        float radius;
+    };
+
+    struct ClusterBox {
+        glm::vec3 min, max;
+    };
+
+    // The same froxels as LightClusterer: screen tiles, slices exponential in depth.
+    std::vector<ClusterBox> ClusterBoxes(const glm::mat4& projection) {
+        std::vector<ClusterBox> boxes(LightClusterer::ClusterCount);
+        for (uint32_t k = 0; k < LightClusterer::GridZ; ++k) {
+            const float depths[2] = {NearPlane * std::pow(FarPlane / NearPlane, static_cast<float>(k) / LightClusterer::GridZ),
+                                     NearPlane * std::pow(FarPlane / NearPlane, static_cast<float>(k + 1) / LightClusterer::GridZ)};
+            for (uint32_t j = 0; j < LightClusterer::GridY; ++j) {
+                for (uint32_t i = 0; i < LightClusterer::GridX; ++i) {
+                    ClusterBox& box = boxes[k * LightClusterer::ClustersPerSlice + j * LightClusterer::GridX + i];
+                    box.min = glm::vec3(std::numeric_limits<float>::max());
+                    box.max = glm::vec3(std::numeric_limits<float>::lowest());
+                    for (const float depth : depths) {
+                        for (uint32_t corner = 0; corner < 4; ++corner) {
+                            const float ndcX = -1.0f + 2.0f * static_cast<float>(i + (corner & 1)) / LightClusterer::GridX;
+                            const float ndcY = -1.0f + 2.0f * static_cast<float>(j + (corner >> 1)) / LightClusterer::GridY;
+                            const glm::vec3 point(depth * (ndcX + projection[2][0]) / projection[0][0],
+                                                  depth * (ndcY + projection[2][1]) / projection[1][1], -depth);
+                            box.min = glm::min(box.min, point);
+                            box.max = glm::max(box.max, point);
+                        }
+                    }
+                }
+            }
+        }
+        return boxes;
+    }
+
+    // Every light against every cluster; returns the per-cluster counts.
+    void BinBruteForce(const std::vector<ClusterBox>& boxes, const std::vector<Sphere>& lights, const glm::mat4& view,
+                       std::vector<uint32_t>& counts) {
+        counts.assign(boxes.size(), 0);
+        for (const Sphere& light : lights) {
+            const glm::vec3 center(view * glm::vec4(light.center, 1.0f));
+            for (size_t c = 0; c < boxes.size(); ++c) {
+                const glm::vec3 offset = glm::max(glm::max(boxes[c].min - center, center - boxes[c].max), glm::vec3(0.0f));
+                counts[c] += glm::dot(offset, offset) <= light.radius * light.radius;
+            }
+        }
+    }
+
+    void RunSize(size_t count, IDK::JobSystem& jobs) {
+        using namespace IDK::Bench;
+        auto& rng = Rng();
+
+        const glm::mat4 projection = glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, NearPlane, FarPlane);
+        const glm::mat4 view = glm::lookAt(glm::vec3(0.0f, 2.0f, 0.0f), glm::vec3(0.0f, 2.0f, -1.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+
+        std::uniform_real_distribution<float> across(-80.0f, 80.0f), height(0.0f, 20.0f), depth(-200.0f, 10.0f);
+        std::uniform_real_distribution<float> range(2.0f, 12.0f), cone(0.2f, 1.2f), unit(-1.0f, 1.0f);
+
+        LightClusterer clusterer;
+        clusterer.reserve(count);
+        std::vector<Sphere> spheres;
+        for (size_t i = 0; i < count; ++i) {
+            const glm::vec3 position(across(rng), height(rng), depth(rng));
+            const float radius = range(rng);
+            if (i % 4 != 0) {
+                clusterer.addPointLight(position, radius, glm::vec3(1.0f), 1.0f);
+                spheres.push_back({position, radius});
+                continue;
+            }
+
+            const glm::vec3 direction = glm::normalize(glm::vec3(unit(rng), unit(rng) - 1.0f, unit(rng)));
+            const float outer = cone(rng);
+            clusterer.addSpotLight(position, direction, radius, outer * 0.8f, outer, glm::vec3(1.0f), 1.0f);
+
+            // The cone's bounding sphere as LightClusterer computes it.
+            if (outer > glm::radians(45.0f))
+                spheres.push_back({position + direction * (radius * std::cos(outer)), radius * std::sin(outer)});
+            else
+                spheres.push_back({position + direction * (radius / (2.0f * std::cos(outer))), radius / (2.0f * std::cos(outer))});
+        }
+
+        const std::vector<ClusterBox> boxes = ClusterBoxes(projection);
+        std::vector<uint32_t> bruteCounts;
+        const int repeats = count > 1000 ? 3 : 10;
+        const double brute = BestOf(repeats, [&] { BinBruteForce(boxes, spheres, view, bruteCounts); Keep(bruteCounts[0]); });
+
+        // The first build also sets up the cluster boxes, which then stay
+        // cached while the projection does not change.
+        clusterer.build(view, projection);
+        const double serial = BestOf(repeats, [&] { clusterer.build(view, projection); });
+        Row("bin, calling thread", count, serial, brute);
+
+        const double parallel = BestOf(repeats, [&] { clusterer.build(view, projection, &jobs); });
+        Row("bin, " + std::to_string(jobs.getWorkerCount()) + " workers + caller", count, parallel, brute);
+
+        // Lights on a slice or tile boundary can land either side of it in
+        // the two, so a handful of differing clusters is rounding.
+        size_t mismatches = 0, bruteReferences = 0;
+        const std::vector<glm::uvec2>& clusters = clusterer.getClusters();
+        for (size_t c = 0; c < clusters.size(); ++c) {
+            mismatches += clusters[c].y != std::min(bruteCounts[c], LightClusterer::MaxLightsPerCluster);
+            bruteReferences += bruteCounts[c];
+        }
+
+        const IDK::Graphics::LightClusterStats& stats = clusterer.getStats();
+        std::printf("  %zu references (brute force %zu), %.1f per cluster, %zu overflowed, %zu clusters differ\n",
+                    stats.references, bruteReferences, static_cast<double>(stats.references) / LightClusterer::ClusterCount,
+                    stats.overflowed, mismatches);
+    }
+}
+
+namespace IDK::Bench
+{
+    void RunLightClusterer() {
+#if defined(__AVX__)
+        const char* kernel = "AVX";
+#elif defined(__SSE2__) || defined(_M_X64)
+        const char* kernel = "SSE2";
+#else
+        const char* kernel = "scalar";
+#endif
+        Header((std::string("Clustered light binning, ") + kernel + " kernel").c_str(), "binned ms", "brute ms");
+
+        IDK::JobSystem jobs;
+        for (size_t count : {256u, 1024u, 4096u})
+            RunSize(count, jobs);
+    }
+}
@@ -0,0 +1,148 @@
+//
+// Created by SIMEON on 10/17/2026.
+//
+
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "glm.hpp"
+#include "gtc/constants.hpp"
+
+#include "Bench.h"
+#include "MeshOptimizer.h"
+
+// Before/after post-transform cache efficiency of the pass Mesh::Optimize()
+// runs before upload: weld, Forsyth reorder, fetch remap.
+namespace
+{
+    namespace MeshOptimizer = IDK::Graphics::MeshOptimizer;
+
+    // Same layout as Graphics::Vertex, so welding compares the same bytes.
+    struct Vertex {
+        glm::vec3 position;
+        glm::vec3 normal;
+    };
+
+    struct TestMesh {
+        std::vector<Vertex> vertices;
+        std::vector<unsigned int> indices;  // empty for a triangle list
+    };
+
+    // Stack/sector layout of Mesh::CreateSphere.
+    TestMesh Sphere(unsigned int stacks, unsigned int sectors) {
+        TestMesh mesh;
+        for (unsigned int i = 0; i <= stacks; ++i) {
+            const float phi = glm::pi<float>() * static_cast<float>(i) / static_cast<float>(stacks);
+            for (unsigned int j = 0; j <= sectors; ++j) {
+                const float theta = glm::two_pi<float>() * static_cast<float>(j) / static_cast<float>(sectors);
+                const glm::vec3 p(std::sin(phi) * std::cos(theta), std::cos(phi), std::sin(phi) * std::sin(theta));
+                mesh.vertices.push_back({p * 0.5f, p});
+            }
+        }
+        for (unsigned int i = 0; i < stacks; ++i) {
+            for (unsigned int j = 0; j < sectors; ++j) {
+                const unsigned int a = i * (sectors + 1) + j;
+                const unsigned int b = a + sectors + 1;
+                mesh.indices.insert(mesh.indices.end(), {a, b, a + 1, b, b + 1, a + 1});
+            }
+        }
+        return mesh;
+    }
+
+    TestMesh Grid(unsigned int size) {
+        TestMesh mesh;
+        for (unsigned int z = 0; z <= size; ++z)
+            for (unsigned int x = 0; x <= size; ++x)
+                mesh.vertices.push_back({glm::vec3(x, 0.0f, z), glm::vec3(0.0f, 1.0f, 0.0f)});
+        for (unsigned int z = 0; z < size; ++z) {
+            for (unsigned int x = 0; x < size; ++x) {
+                const unsigned int a = z * (size + 1) + x;
+                const unsigned int b = a + size + 1;
+                mesh.indices.insert(mesh.indices.end(), {a, b, a + 1, b, b + 1, a + 1});
+            }
+        }
+        return mesh;
+    }
+
+    // Triangles in random order, as exporters that do not optimize leave them.
+    TestMesh Shuffled(TestMesh mesh) {
+        const size_t triangles = mesh.indices.size() / 3;
+        for (size_t i = triangles - 1; i > 0; --i) {
+            const size_t j = std::uniform_int_distribution<size_t>(0, i)(IDK::Bench::Rng());
+            for (size_t k = 0; k < 3; ++k)
+                std::swap(mesh.indices[i * 3 + k], mesh.indices[j * 3 + k]);
+        }
+        return mesh;
+    }
+
+    // Three vertices per triangle, no index buffer.
+    TestMesh Unindexed(const TestMesh& mesh) {
+        TestMesh soup;
+        for (unsigned int index : mesh.indices)
+            soup.vertices.push_back(mesh.vertices[index]);
+        return soup;
+    }
+
+    // Mirrors Mesh::Optimize().
+    MeshOptimizer::Report Optimize(TestMesh& mesh) {
+        MeshOptimizer::Report report;
+        report.verticesBefore = mesh.vertices.size();
+        if (mesh.indices.empty()) {
+            report.before = {3.0f, 1.0f};
+        } else {
+            report.before = MeshOptimizer::AnalyzeVertexCache(mesh.indices.data(), mesh.indices.size(), mesh.vertices.size());
+        }
+
+        std::vector<unsigned int> remap;
+        size_t vertexCount = MeshOptimizer::BuildWeldRemap(remap, mesh.vertices.data(), mesh.vertices.size(), sizeof(Vertex),
+                                                           mesh.indices.empty() ? nullptr : mesh.indices.data(), mesh.indices.size());
+        if (mesh.indices.empty()) {
+            mesh.indices.assign(remap.begin(), remap.end());
+        } else {
+            for (unsigned int& index : mesh.indices) index = remap[index];
+        }
+        MeshOptimizer::RemapVertices(mesh.vertices, remap, vertexCount);
+
+        MeshOptimizer::OptimizeVertexCache(mesh.indices.data(), mesh.indices.size(), mesh.vertices.size());
+
+        vertexCount = MeshOptimizer::BuildFetchRemap(remap, mesh.indices.data(), mesh.indices.size(), mesh.vertices.size());
+        for (unsigned int& index : mesh.indices) index = remap[index];
+        MeshOptimizer::RemapVertices(mesh.vertices, remap, vertexCount);
+
+        report.verticesAfter = mesh.vertices.size();
+        report.after = MeshOptimizer::AnalyzeVertexCache(mesh.indices.data(), mesh.indices.size(), mesh.vertices.size());
+        return report;
+    }
+
+    void Run(const char* name, const TestMesh& source) {
+        MeshOptimizer::Report report;
+        const double ms = IDK::Bench::BestOf(3, [&] {
+            TestMesh mesh = source;
+            report = Optimize(mesh);
+        });
+
+        const size_t triangles = (source.indices.empty() ? source.vertices.size() : source.indices.size()) / 3;
+        std::printf("%-24s %9zu %9zu %9zu %7.3f %7.3f %7.3f %7.3f %10.2f\n", name, triangles,
+                    report.verticesBefore, report.verticesAfter, report.before.acmr, report.after.acmr,
+                    report.before.atvr, report.after.atvr, ms);
+    }
+}
+
+namespace IDK::Bench
+{
+    void RunMeshOptimizer() {
+        std::printf("\n== Mesh optimization (FIFO cache of %u)\n", MeshOptimizer::DefaultCacheSize);
+        std::printf("%-24s %9s %9s %9s %7s %7s %7s %7s %10s\n", "mesh", "tris", "verts", "welded",
+                    "acmr", "->", "atvr", "->", "ms");
+
+        const TestMesh sphere = Sphere(200, 200);
+        const TestMesh grid = Grid(256);
+        Run("sphere 200x200", sphere);
+        Run("sphere 200x200 shuffled", Shuffled(sphere));
+        Run("sphere 200x200 unindexed", Unindexed(sphere));
+        Run("grid 256x256", grid);
+        Run("grid 256x256 shuffled", Shuffled(grid));
+    }
+}
@@ -0,0 +1,69 @@
+//
+// Created by SIMEON on 10/17/2026.
+//
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "Bench.h"
+#include "RenderQueue.h"
+
+// RenderQueue::RadixSort against std::sort and std::stable_sort on keys
+// shaped like a scene's: a few shaders, more materials, many meshes and
+// quantized depth, recorded in traversal (random) order.
+namespace
+{
+    using IDK::Graphics::RenderCommand;
+    using IDK::Graphics::RenderPass;
+    namespace SortKey = IDK::Graphics::SortKey;
+
+    std::vector<RenderCommand> SceneCommands(size_t count) {
+        auto& rng = IDK::Bench::Rng();
+        std::uniform_int_distribution<uint32_t> shader(1, 8), material(1, 64), mesh(1, 1000);
+        std::uniform_real_distribution<float> depth(0.1f, 500.0f);
+        std::bernoulli_distribution transparent(0.1);
+
+        std::vector<RenderCommand> commands(count);
+        for (size_t i = 0; i < count; ++i) {
+            const RenderPass pass = transparent(rng) ? RenderPass::Transparent : RenderPass::Opaque;
+            const uint64_t key = SortKey::Make(pass, shader(rng), material(rng), mesh(rng),
+                                               SortKey::QuantizeDepth(depth(rng), 500.0f));
+            commands[i] = {key, nullptr, nullptr, static_cast<uint32_t>(i)};
+        }
+        return commands;
+    }
+
+    bool ByKey(const RenderCommand& a, const RenderCommand& b) { return a.key < b.key; }
+}
+
+namespace IDK::Bench
+{
+    void RunRenderQueue() {
+        Header("Render queue sort", "radix ms", "std ms");
+        for (size_t count : {10000u, 100000u, 1000000u}) {
+            const std::vector<RenderCommand> source = SceneCommands(count);
+            std::vector<RenderCommand> commands, scratch;
+            const int repeats = count > 100000 ? 5 : 20;
+
+            // Copying the input back in is timed on both sides.
+            const double radix = BestOf(repeats, [&] {
+                commands = source;
+                Graphics::RenderQueue::RadixSort(commands, scratch);
+                Keep(commands.front().key);
+            });
+            const double sorted = BestOf(repeats, [&] {
+                commands = source;
+                std::sort(commands.begin(), commands.end(), ByKey);
+                Keep(commands.front().key);
+            });
+            const double stable = BestOf(repeats, [&] {
+                commands = source;
+                std::stable_sort(commands.begin(), commands.end(), ByKey);
+                Keep(commands.front().key);
+            });
+            Row("radix vs std::sort", count, radix, sorted);
+            Row("radix vs std::stable_sort", count, radix, stable);
+        }
+    }
+}
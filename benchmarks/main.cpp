@@ -0,0 +1,49 @@
+//
+// Created by SIMEON on 10/17/2026.
+//
+
+#include <cstdio>
+#include <cstring>
+
+#include "Bench.h"
+
+namespace
+{
+    struct Benchmark {
+        const char* name;
+        void (*run)();
+    };
+
+    constexpr Benchmark Benchmarks[] = {
+        {"ecs", IDK::Bench::RunECS},
+        {"mesh", IDK::Bench::RunMeshOptimizer},
+        {"sort", IDK::Bench::RunRenderQueue},
+        {"cull", IDK::Bench::RunFrustumCulling},
+        {"tree", IDK::Bench::RunDynamicAABBTree},
+        {"lights", IDK::Bench::RunLightClusterer},
+        {"pool", IDK::Bench::RunBlockPool},
+    };
+}
+
+// idk_bench [name...]: runs the named benchmarks, or all of them.
+int main(int argc, char** argv) {
+    int ran = 0;
+    for (const Benchmark& benchmark : Benchmarks) {
+        bool selected = argc < 2;
+        for (int i = 1; i < argc && !selected; ++i)
+            selected = std::strcmp(argv[i], benchmark.name) == 0;
+        if (!selected) continue;
+
+        benchmark.run();
+        ++ran;
+    }
+
+    if (ran == 0) {
+        std::fprintf(stderr, "No benchmark matched. Available:");
+        for (const Benchmark& benchmark : Benchmarks)
+            std::fprintf(stderr, " %s", benchmark.name);
+        std::fprintf(stderr, "\n");
+        return 1;
+    }
+    return 0;
+}
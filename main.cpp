@@ -1,10 +1,13 @@
 #include "Initialization.h"
 static constexpr float VERSION = 0.066;
 
-int main() {
+int main(int argc, char** argv) {
     try {
+        IDK::Core::Configure(IDK::EngineSystems::Config::FromCommandLine(argc, argv));
+
         const Initialization init;
-        init.runMainLoop();
+        if (!init.runMainLoop())
+            return EXIT_FAILURE;
     } catch (const std::exception& e) {
         std::cerr << "E caught: " << e.what() << std::endl;
         return EXIT_FAILURE;
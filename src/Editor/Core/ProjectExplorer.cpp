@@ -6,6 +6,7 @@
 #include <thread>
 #include "IconsFontAwesome6Brands.h"
 #include "DragAndDropPayload.h"
+#include "FrameArena.h"
 #include <string>
 #include <iostream>
 #include <boost/uuid/uuid_io.hpp>
@@ -172,7 +173,9 @@ void ProjectExplorer::RenderAssetItem(const std::shared_ptr<AssetItem>& asset, f
         ImGui::PushStyleColor(ImGuiCol_Text, IM_COL32(100, 255, 100, 255));
     }
 
-    ImGui::Button((std::string(icon) + "##" + asset->getName()).c_str(), ImVec2(iconSize, iconSize));
+    IDK::FrameString label(icon, IDK::FrameAllocator<char>());
+    label.append("##").append(asset->getName());
+    ImGui::Button(label.c_str(), ImVec2(iconSize, iconSize));
 
     if (ImGui::IsItemHovered() && ImGui::IsMouseDoubleClicked(0)) {
         SelectionManager::getInstance().selectFolder(asset);
@@ -196,7 +199,7 @@ void ProjectExplorer::RenderAssetItem(const std::shared_ptr<AssetItem>& asset, f
 void ProjectExplorer::RenderGameObject(const std::shared_ptr<Entity>& entity, float iconSize) {
     if (!entity) return;
 
-    ImGui::PushID(entity->getName().c_str());
+    ImGui::PushID(entity->getNameRef().c_str());
 
     const char* icon = "[Object]";
 
@@ -204,7 +207,9 @@ void ProjectExplorer::RenderGameObject(const std::shared_ptr<Entity>& entity, fl
     if (entity->hasComponent<IDK::Graphics::Camera>()) icon = "[Camera]";
    // if (entity->hasComponent<IDK::Graphics::MeshRenderer>()) icon = "[Mesh]";
 
-    if (ImGui::Button((std::string(icon) + "##" + entity->getName()).c_str(), ImVec2(iconSize, iconSize))) {
+    IDK::FrameString label(icon, IDK::FrameAllocator<char>());
+    label.append("##").append(entity->getNameRef());
+    if (ImGui::Button(label.c_str(), ImVec2(iconSize, iconSize))) {
         SelectionManager::getInstance().select(entity);
     }
 
@@ -212,7 +217,7 @@ void ProjectExplorer::RenderGameObject(const std::shared_ptr<Entity>& entity, fl
         SelectionManager::getInstance().select(entity);
     }
 
-    ImGui::TextWrapped("%s", entity->getName().c_str());
+    ImGui::TextWrapped("%s", entity->getNameRef().c_str());
 
     ImGui::PopID();
 }
@@ -428,4 +433,4 @@ void ProjectExplorer::initializeTextures() {
     if (shaderIconTexture == 0) {
         std::cerr << "Failed to load shader icon texture!" << std::endl;
     }
-}
\ No newline at end of file
+}
\ No newline at end of file
@@ -1,8 +1,30 @@
 #include "SelectionManager.h"
 
 #include "Cube.h"
+#include "DirectionalLight.h"
 #include "Entity.h"
 #include "Light.h"
+#include "PointLight.h"
+#include "Registry.h"
+#include "SpotLight.h"
+
+namespace
+{
+    template<typename T>
+    std::shared_ptr<T> FindHandle(const IComponentManager& components, EntityID id) {
+        const auto* pool = components.getPool<T>();
+        return pool ? pool->handle(id) : nullptr;
+    }
+
+    // Pools are keyed by the exact component type, so a light stored as one
+    // of the concrete kinds is only found under that kind.
+    std::shared_ptr<IDK::Graphics::Light> FindLight(const IComponentManager& components, EntityID id) {
+        if (auto light = FindHandle<DirectionalLight>(components, id)) return light;
+        if (auto light = FindHandle<PointLight>(components, id)) return light;
+        if (auto light = FindHandle<SpotLight>(components, id)) return light;
+        return FindHandle<IDK::Graphics::Light>(components, id);
+    }
+}
 
 SelectionManager& SelectionManager::getInstance() {
     static SelectionManager instance;
@@ -20,13 +42,14 @@ void SelectionManager::select(const std::shared_ptr<Entity>& object) {
 
     clearSpecificSelections();
 
-    auto components = object->getAllComponents();
-    for (const auto& [type, component] : components) {
-        if (auto light = std::dynamic_pointer_cast<IDK::Graphics::Light>(component)) {
-            selectedLight = light;
-        } else if (auto camera = std::dynamic_pointer_cast<IDK::Graphics::Camera>(component)) {
-            selectedCamera = camera;
-        }
+    // Typed pool lookups instead of copying every component into a map
+    const IComponentManager* components = Registry::instance().getComponentManager();
+    const EntityID id = object->getID();
+
+    if (auto light = FindLight(*components, id)) {
+        selectedLight = std::move(light);
+    } else {
+        selectedCamera = FindHandle<IDK::Graphics::Camera>(*components, id);
     }
     notifySelectionChange(SelectionEvent(SelectionEvent::Type::SELECT, object));
 }
@@ -190,7 +190,7 @@ public:
     virtual const std::string& getName() const {
         if (isVirtual_ && type_ == AssetType::Entity) {
             if (const auto& ent = entities.lock()) {
-                return ent->getName();
+                return ent->getNameRef();
             }
         }
         return name_;
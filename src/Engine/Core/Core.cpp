@@ -5,11 +5,23 @@
 
 namespace IDK
 {
+    namespace
+    {
+        EngineSystems::Config& StartupConfig()
+        {
+            static EngineSystems::Config config;
+            return config;
+        }
+    }
+
     Core::Core()
     {
-        IDK::EngineSystems::Config cfg;
+        engineSystems = std::make_unique<IDK::EngineSystems>(StartupConfig());
+    }
 
-        engineSystems = std::make_unique<IDK::EngineSystems>(cfg);
+    void Core::Configure(const EngineSystems::Config& config)
+    {
+        StartupConfig() = config;
     }
 
     Core::~Core() = default;
@@ -15,6 +15,9 @@ namespace IDK
     public:
         static Core& Instance();
 
+        // Config the engine starts with; only has an effect before the first Instance().
+        static void Configure(const EngineSystems::Config& config);
+
         EngineSystems& systems() const { return *engineSystems; }
 
         template<typename T>
@@ -5,8 +5,12 @@
 #include "EngineSystems.h"
 
 #include <IconsFontAwesome6Brands.h>
+#include <charconv>
+#include <cstring>
 
+#include "DeferredRenderer.h"
 #include "ECScheduler.h"
+#include "HeadlessRenderer.h"
 
 #define ENABLE_MEMORY_TRACKING
 #include "libData.h"
@@ -29,6 +33,49 @@ namespace IDK
     const std::string EngineSystems::Config::defaultRendererType = "deferred";
     const std::filesystem::path EngineSystems::Config::defaultFontPath = SOURCE_DIR "/src/data/fonts/CascadiaCode-Bold.ttf";
     const std::filesystem::path EngineSystems::Config::defaultIconFontPath = SOURCE_DIR "/src/data/fonts/Font Awesome 6 Free-Solid-900.otf";
+    const std::filesystem::path EngineSystems::Config::defaultHeadlessReportPath = "headless_report.json";
+
+    EngineSystems::Config EngineSystems::Config::FromCommandLine(int argc, char** argv)
+    {
+        Config config;
+
+        const auto parse = [](const char* arg, const char* prefix, auto& value) {
+            const size_t length = std::strlen(prefix);
+            if (std::strncmp(arg, prefix, length) != 0) return false;
+
+            const char* text = arg + length;
+            const auto [end, error] = std::from_chars(text, text + std::strlen(text), value);
+            if (error != std::errc() || *end != '\0')
+                std::cerr << "[Config] Ignoring malformed argument: " << arg << std::endl;
+            return true;
+        };
+
+        for (int i = 1; i < argc; ++i) {
+            const char* arg = argv[i];
+            if (std::strcmp(arg, "--headless") == 0) {
+                config.headless.enabled = true;
+            } else if (std::strncmp(arg, "--report=", 9) == 0) {
+                config.headless.reportPath = arg + 9;
+            } else if (std::strncmp(arg, "--renderer=", 11) == 0) {
+                config.graphics.rendererType = arg + 11;
+            } else if (std::strcmp(arg, "--gbuffer=standard") == 0) {
+                config.graphics.gBufferLayout = Graphics::GBufferLayout::Standard;
+            } else if (std::strcmp(arg, "--gbuffer=compact") == 0) {
+                config.graphics.gBufferLayout = Graphics::GBufferLayout::Compact;
+            } else if (!parse(arg, "--frames=", config.headless.frameCount) &&
+                       !parse(arg, "--warmup=", config.headless.warmupFrames) &&
+                       !parse(arg, "--objects=", config.headless.objectCount) &&
+                       !parse(arg, "--lights=", config.headless.lightCount) &&
+                       !parse(arg, "--width=", config.window.width) &&
+                       !parse(arg, "--height=", config.window.height)) {
+                std::cerr << "[Config] Unknown argument: " << arg << std::endl;
+            }
+        }
+
+        // The engine changes into the source directory while starting up.
+        config.headless.reportPath = std::filesystem::absolute(config.headless.reportPath);
+        return config;
+    }
 
     struct EngineSystems::Impl
     {
@@ -39,6 +86,7 @@ namespace IDK
         std::shared_ptr<IDK::Graphics::Camera> m_MainCamera;
         std::shared_ptr<Scene> m_Scene;
         std::shared_ptr<Renderer> m_Renderer;
+        std::unique_ptr<HeadlessRenderer> m_Headless;
         std::unique_ptr<ECScheduler> scheduler;
         std::thread::id mainThreadId;
 
@@ -51,9 +99,11 @@ namespace IDK
         {
             initializeGLFW();
             initializeCoreComponents();
-            initializeImGui();
-            initializeRenderer();
+            if (!config.headless.enabled)
+                initializeImGui();
             initializeScheduler();
+            initializeRenderer();
+            registerSystems();
         }
 
         ~Impl() {
@@ -63,28 +113,48 @@ namespace IDK
         void initializeGLFW()
         {
             PROFILE_SCOPE("GLFW Initialization");
+            const bool headless = config.headless.enabled;
+
+            // CI machines have no display: the null platform skips the window
+            // system entirely and the context comes from EGL or OSMesa below.
+            if (headless)
+                glfwInitHint(GLFW_PLATFORM, GLFW_PLATFORM_NULL);
+
             if (!glfwInit()) {
                 IDK_ASSERT(false, "GLFW Initialization");
             }
 
+            // Shaders need 4.5 at most; asking for no more lets llvmpipe run headless.
             glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
-            glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 6);
+            glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, headless ? 5 : 6);
             glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
 
             {
                 PROFILE_SCOPE("GLFW Window Creation");
-                m_Window = glfwCreateWindow(config.window.width, config.window.height, config.window.title.c_str(), nullptr, nullptr);
+                if (headless) {
+                    glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+                    glfwWindowHint(GLFW_CONTEXT_CREATION_API, GLFW_EGL_CONTEXT_API);
+                    m_Window = glfwCreateWindow(config.window.width, config.window.height, config.window.title.c_str(), nullptr, nullptr);
+
+                    if (!m_Window) {
+                        std::cerr << "[main] No surfaceless EGL context, falling back to OSMesa." << std::endl;
+                        glfwWindowHint(GLFW_CONTEXT_CREATION_API, GLFW_OSMESA_CONTEXT_API);
+                    }
+                }
+
+                if (!m_Window)
+                    m_Window = glfwCreateWindow(config.window.width, config.window.height, config.window.title.c_str(), nullptr, nullptr);
 
                 if (!m_Window) {
                     IDK_ASSERT(false, "GLFW Creation Failed.");
                 }
 
-                TRACK_ALLOC(m_Window, "GLFWwindow creation");
+                TRACK_ALLOC(m_Window, "GLFWwindow");
             }
 
             IDK::GLFWMemoryTracker::TrackWindowCreation(m_Window);
             glfwMakeContextCurrent(m_Window);
-            glfwSwapInterval(1);
+            glfwSwapInterval(config.window.vsync && !headless ? 1 : 0);
 
             {
                 PROFILE_SCOPE("Load OpenGL with GLAD");
@@ -108,6 +178,9 @@ namespace IDK
 
             current_path(engineDir);
 
+            IDK::Graphics::Mesh::SetDefaultVertexFormat(config.graphics.vertexFormat);
+            DeferredRenderer::SetDefaultGBufferLayout(config.graphics.gBufferLayout);
+
             glm::vec3 position = glm::vec3(0.5f, 3.0f, -7.0f);
             glm::vec3 forward = glm::vec3(-0.026f, -0.0471f, 0.99f);
             glm::vec3 up = glm::vec3(-0.0012f, 1.0f, 0.047f);
@@ -200,11 +273,18 @@ namespace IDK
             ShaderManager& shaderManager = ShaderManager::Instance();
             shaderManager.Initialize();
 
+            if (config.headless.enabled) {
+                m_Headless = std::make_unique<HeadlessRenderer>(m_Scene, m_MainCamera, m_Window, config,
+                                                                &scheduler->getJobSystem());
+                return;
+            }
+
             m_Renderer = std::make_shared<Renderer>(
                 m_Scene,
                 m_MainCamera,
                 m_Window,
-                config.graphics.rendererType
+                config.graphics.rendererType,
+                &scheduler->getJobSystem()
             );
 
             TRACK_ALLOC(m_Renderer, "Renderer");
@@ -213,7 +293,13 @@ namespace IDK
         void initializeScheduler()
         {
             PROFILE_SCOPE("Scheduler Initialization");
-            scheduler = std::make_unique<ECScheduler>();
+            scheduler = std::make_unique<ECScheduler>(config.jobs.workerCount);
+        }
+
+        void registerSystems()
+        {
+            if (!m_Renderer)
+                return;
 
             /*
             scheduler.addSystem([this]() { m_Renderer->render(); },
@@ -245,6 +331,13 @@ namespace IDK
                 UNTRACK_ALLOC(m_Renderer, "Renderer");
             }
 
+            if (m_Headless)
+            {
+                m_Headless.reset();
+                glFinish();
+                ShaderManager::Instance().Shutdown();
+            }
+
             if (m_Scene)
             {
                 m_Scene.reset();
@@ -269,7 +362,7 @@ namespace IDK
             }
 
             if (m_Window) {
-                UNTRACK_ALLOC(m_Window, "GLFWwindow destruction");
+                UNTRACK_ALLOC(m_Window, "GLFWwindow");
                 glfwSetWindowUserPointer(m_Window, nullptr);
                 glfwSetWindowCloseCallback(m_Window, nullptr);
                 glfwSetKeyCallback(m_Window, nullptr);
@@ -307,10 +400,13 @@ namespace IDK
     std::shared_ptr<Scene> EngineSystems::getScene() const { return pImpl->m_Scene; }
     ECScheduler& EngineSystems::getScheduler() const { return *pImpl->scheduler; }
 
-    void EngineSystems::runMainLoop() const
+    bool EngineSystems::runMainLoop() const
     {
         try
         {
+            if (pImpl->m_Headless)
+                return pImpl->m_Headless->run();
+
             bool running = true;
             while (running)
             {
@@ -326,8 +422,11 @@ namespace IDK
             }
         } catch (const std::exception& e) {
             std::cerr << "E caught in runMainLoop: " << e.what() << std::endl;
+            return false;
         } catch (...) {
             std::cerr << "Unknown e caught in runMainLoop" << std::endl;
+            return false;
         }
+        return true;
     }
 }
\ No newline at end of file
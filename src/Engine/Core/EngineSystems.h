@@ -5,6 +5,7 @@
 #ifndef ENGINESYSTEMS_H
 #define ENGINESYSTEMS_H
 
+#include <cstdint>
 #include <memory>
 #include <vector>
 #include <functional>
@@ -14,8 +15,10 @@
 #include <filesystem>
 #include "ECScheduler.h"
 #include "Camera.h"
+#include "IRenderDeferred.h"
 #include "Renderer.h"
 #include "Scene.h"
+#include "VertexCompression.h"
 
 namespace IDK
 {
@@ -37,13 +40,34 @@ namespace IDK
 
             struct GraphicsConfig
             {
-                std::string rendererType;
+                std::string rendererType;  // "deferred", "forward" or "gpu"
                 std::filesystem::path fontPath;
                 std::filesystem::path iconFontPath;
+                Graphics::VertexFormat vertexFormat;
+                Graphics::GBufferLayout gBufferLayout;
+            };
+
+            struct JobConfig
+            {
+                size_t workerCount; // 0 = hardware_concurrency() - 1
+            };
+
+            // Offscreen benchmark run instead of the editor: no ImGui, no vsync,
+            // a generated scene rendered for warmupFrames + frameCount frames.
+            struct HeadlessConfig
+            {
+                bool enabled;
+                uint32_t frameCount;
+                uint32_t warmupFrames;
+                uint32_t objectCount;
+                uint32_t lightCount;
+                std::filesystem::path reportPath;
             };
 
             WindowConfig window;
             GraphicsConfig graphics;
+            JobConfig jobs;
+            HeadlessConfig headless;
 
             static constexpr int defaultWidth = 1280;
             static constexpr int defaultHeight = 720;
@@ -52,9 +76,26 @@ namespace IDK
             static const std::string defaultRendererType;
             static const std::filesystem::path defaultFontPath;
             static const std::filesystem::path defaultIconFontPath;
+            static constexpr Graphics::VertexFormat defaultVertexFormat = Graphics::VertexFormat::Standard;
+            static constexpr Graphics::GBufferLayout defaultGBufferLayout = Graphics::GBufferLayout::Standard;
+            static constexpr size_t defaultWorkerCount = 0;
+            static constexpr uint32_t defaultHeadlessFrameCount = 300;
+            static constexpr uint32_t defaultHeadlessWarmupFrames = 30;
+            static constexpr uint32_t defaultHeadlessObjectCount = 10000;
+            static constexpr uint32_t defaultHeadlessLightCount = 1024;
+            static const std::filesystem::path defaultHeadlessReportPath;
 
             Config() : window{defaultWidth, defaultHeight, defaultTitle, defaultVSync},
-                       graphics{defaultRendererType, defaultFontPath, defaultIconFontPath} {}
+                       graphics{defaultRendererType, defaultFontPath, defaultIconFontPath, defaultVertexFormat,
+                                defaultGBufferLayout},
+                       jobs{defaultWorkerCount},
+                       headless{false, defaultHeadlessFrameCount, defaultHeadlessWarmupFrames,
+                                defaultHeadlessObjectCount, defaultHeadlessLightCount, defaultHeadlessReportPath} {}
+
+            // Defaults overridden by --headless, --frames=N, --warmup=N,
+            // --objects=N, --lights=N, --report=PATH, --width=N, --height=N,
+            // --gbuffer=standard|compact and --renderer=deferred|forward|gpu.
+            static Config FromCommandLine(int argc, char** argv);
         };
 
         explicit EngineSystems(const Config& config = Config());
@@ -67,7 +108,8 @@ namespace IDK
         std::shared_ptr<Scene> getScene() const;
         ECScheduler& getScheduler() const;
 
-        void runMainLoop() const;
+        // False when the loop ended on an error or a headless run failed.
+        bool runMainLoop() const;
     private:
         struct Impl;
         std::unique_ptr<Impl> pImpl;
@@ -0,0 +1,163 @@
+//
+// Created by SIMEON on 10/17/2026.
+//
+
+#ifndef FRAMEARENA_H
+#define FRAMEARENA_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <mutex>
+#include <new>
+#include <string>
+#include <vector>
+#include "PoolAllocator.h"
+
+namespace IDK
+{
+    // Double-buffered linear allocator for data that only lives for a frame.
+    // allocate() is a lock-free bump; memory from frame N stays valid until
+    // the end of frame N+1. Anything that does not fit spills into overflow
+    // blocks and the buffer grows to cover it on its next reset.
+    class FrameArena
+    {
+    public:
+        struct Stats
+        {
+            size_t bytesUsed = 0;
+            size_t capacity = 0;
+            size_t allocations = 0;
+            size_t overflowBytes = 0;
+        };
+
+        static constexpr size_t DefaultCapacity = 1024 * 1024;
+
+        static FrameArena& Instance() {
+            static FrameArena instance;
+            return instance;
+        }
+
+        void* allocate(size_t bytes, size_t alignment = alignof(std::max_align_t)) {
+            Buffer& buffer = m_buffers[m_current.load(std::memory_order_acquire)];
+            buffer.allocations.fetch_add(1, std::memory_order_relaxed);
+
+            const size_t reserve = bytes + alignment - 1;
+            const size_t offset = buffer.offset.fetch_add(reserve, std::memory_order_relaxed);
+            if (offset + reserve <= buffer.capacity) {
+                const auto base = reinterpret_cast<uintptr_t>(buffer.data) + offset;
+                return reinterpret_cast<void*>((base + alignment - 1) & ~(uintptr_t(alignment) - 1));
+            }
+
+            std::lock_guard lock(buffer.overflowMutex);
+            void* block = BlockPool::AlignedAllocate(bytes ? bytes : 1, alignment < alignof(void*) ? alignof(void*) : alignment);
+            buffer.overflow.push_back(block);
+            buffer.overflowBytes += reserve;
+            return block;
+        }
+
+        // Call once per frame, after all users of the arena are done with it.
+        void endFrame() {
+            const uint32_t finished = m_current.load(std::memory_order_relaxed);
+            Buffer& done = m_buffers[finished];
+
+            m_lastFrame.bytesUsed = std::min(done.offset.load(std::memory_order_relaxed), done.capacity) + done.overflowBytes;
+            m_lastFrame.capacity = done.capacity;
+            m_lastFrame.allocations = done.allocations.load(std::memory_order_relaxed);
+            m_lastFrame.overflowBytes = done.overflowBytes;
+
+            const uint32_t next = finished ^ 1u;
+            reset(m_buffers[next]);
+            m_current.store(next, std::memory_order_release);
+        }
+
+        Stats getLastFrameStats() const { return m_lastFrame; }
+
+        FrameArena(const FrameArena&) = delete;
+        FrameArena& operator=(const FrameArena&) = delete;
+
+    private:
+        struct Buffer
+        {
+            std::byte* data = nullptr;
+            size_t capacity = 0;
+            std::atomic<size_t> offset{0};
+            std::atomic<size_t> allocations{0};
+            std::mutex overflowMutex;
+            std::vector<void*> overflow;
+            size_t overflowBytes = 0;
+        };
+
+        FrameArena() {
+            for (Buffer& buffer : m_buffers) {
+                buffer.capacity = DefaultCapacity;
+                buffer.data = static_cast<std::byte*>(BlockPool::AlignedAllocate(buffer.capacity, 64));
+            }
+        }
+
+        ~FrameArena() {
+            for (Buffer& buffer : m_buffers) {
+                for (void* block : buffer.overflow)
+                    BlockPool::AlignedDeallocate(block);
+                BlockPool::AlignedDeallocate(buffer.data);
+            }
+        }
+
+        static void reset(Buffer& buffer) {
+            for (void* block : buffer.overflow)
+                BlockPool::AlignedDeallocate(block);
+            buffer.overflow.clear();
+
+            if (buffer.overflowBytes > 0) {
+                const size_t grown = (buffer.capacity + buffer.overflowBytes) * 3 / 2;
+                BlockPool::AlignedDeallocate(buffer.data);
+                buffer.data = static_cast<std::byte*>(BlockPool::AlignedAllocate(grown, 64));
+                buffer.capacity = grown;
+                buffer.overflowBytes = 0;
+            }
+
+            buffer.offset.store(0, std::memory_order_relaxed);
+            buffer.allocations.store(0, std::memory_order_relaxed);
+        }
+
+        Buffer m_buffers[2];
+        std::atomic<uint32_t> m_current{0};
+        Stats m_lastFrame;
+    };
+
+    // STL adapter over the frame arena; deallocate is a no-op.
+    template<typename T>
+    class FrameAllocator
+    {
+    public:
+        using value_type = T;
+
+        FrameAllocator() noexcept = default;
+
+        template<typename U>
+        FrameAllocator(const FrameAllocator<U>&) noexcept {}
+
+        T* allocate(size_t n) {
+            if (n > std::numeric_limits<size_t>::max() / sizeof(T))
+                throw std::bad_array_new_length();
+            return static_cast<T*>(FrameArena::Instance().allocate(n * sizeof(T), alignof(T)));
+        }
+
+        void deallocate(T*, size_t) noexcept {}
+    };
+
+    template<typename T, typename U>
+    bool operator==(const FrameAllocator<T>&, const FrameAllocator<U>&) noexcept { return true; }
+
+    template<typename T, typename U>
+    bool operator!=(const FrameAllocator<T>&, const FrameAllocator<U>&) noexcept { return false; }
+
+    template<typename T>
+    using FrameVector = std::vector<T, FrameAllocator<T>>;
+
+    using FrameString = std::basic_string<char, std::char_traits<char>, FrameAllocator<char>>;
+}
+
+#endif //FRAMEARENA_H
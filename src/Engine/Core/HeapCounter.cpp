@@ -0,0 +1,134 @@
+//
+// Created by SIMEON on 10/17/2026.
+//
+
+#include "HeapCounter.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#ifdef _WIN32
+#include <malloc.h>
+#endif
+
+namespace
+{
+    std::atomic<size_t> g_heapAllocations{0};
+
+    void* TryAllocate(std::size_t size) noexcept {
+        return std::malloc(size == 0 ? 1 : size);
+    }
+
+    // Aligned blocks need their own free on Windows, so they never share
+    // the malloc path even when the alignment is small.
+    void* TryAllocateAligned(std::size_t size, std::align_val_t alignment) noexcept {
+        if (size == 0) size = 1;
+        std::size_t align = static_cast<std::size_t>(alignment);
+#ifdef _WIN32
+        return _aligned_malloc(size, align);
+#else
+        if (align < sizeof(void*)) align = sizeof(void*);
+        void* ptr = nullptr;
+        return posix_memalign(&ptr, align, size) == 0 ? ptr : nullptr;
+#endif
+    }
+
+    void FreeAligned(void* ptr) noexcept {
+#ifdef _WIN32
+        _aligned_free(ptr);
+#else
+        std::free(ptr);
+#endif
+    }
+
+    // Counts once per request and retries through the new_handler like the
+    // standard operator new.
+    template<typename TryFn>
+    void* Allocate(TryFn&& tryAllocate) {
+        g_heapAllocations.fetch_add(1, std::memory_order_relaxed);
+
+        while (true) {
+            if (void* ptr = tryAllocate())
+                return ptr;
+
+            std::new_handler handler = std::get_new_handler();
+            if (!handler)
+                throw std::bad_alloc();
+            handler();
+        }
+    }
+}
+
+namespace IDK
+{
+    size_t HeapCounter::GetAllocationCount() {
+        return g_heapAllocations.load(std::memory_order_relaxed);
+    }
+}
+
+// Every replaceable global allocation function is defined here, so that
+// array, over-aligned and nothrow allocations are counted too and each
+// block is released by the matching free.
+
+void* operator new(std::size_t size) {
+    return Allocate([size] { return TryAllocate(size); });
+}
+
+void* operator new[](std::size_t size) {
+    return Allocate([size] { return TryAllocate(size); });
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment) {
+    return Allocate([=] { return TryAllocateAligned(size, alignment); });
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment) {
+    return Allocate([=] { return TryAllocateAligned(size, alignment); });
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    try {
+        return ::operator new(size);
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    try {
+        return ::operator new[](size);
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    try {
+        return ::operator new(size, alignment);
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    try {
+        return ::operator new[](size, alignment);
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete[](void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, std::size_t) noexcept { std::free(ptr); }
+void operator delete(void* ptr, const std::nothrow_t&) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept { std::free(ptr); }
+
+void operator delete(void* ptr, std::align_val_t) noexcept { FreeAligned(ptr); }
+void operator delete[](void* ptr, std::align_val_t) noexcept { FreeAligned(ptr); }
+void operator delete(void* ptr, std::size_t, std::align_val_t) noexcept { FreeAligned(ptr); }
+void operator delete[](void* ptr, std::size_t, std::align_val_t) noexcept { FreeAligned(ptr); }
+void operator delete(void* ptr, std::align_val_t, const std::nothrow_t&) noexcept { FreeAligned(ptr); }
+void operator delete[](void* ptr, std::align_val_t, const std::nothrow_t&) noexcept { FreeAligned(ptr); }
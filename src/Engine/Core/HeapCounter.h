@@ -0,0 +1,21 @@
+//
+// Created by SIMEON on 10/17/2026.
+//
+
+#ifndef HEAPCOUNTER_H
+#define HEAPCOUNTER_H
+
+#include <cstddef>
+
+namespace IDK
+{
+    // Counts calls to the global operator new (replaced in HeapCounter.cpp),
+    // so a steady-state frame can be checked for heap allocations.
+    class HeapCounter
+    {
+    public:
+        static size_t GetAllocationCount();
+    };
+}
+
+#endif //HEAPCOUNTER_H
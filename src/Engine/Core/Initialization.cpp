@@ -11,8 +11,8 @@ Initialization::Initialization() : core(IDK::Core::Instance()),
 
 Initialization::~Initialization(){}
 
-void Initialization::runMainLoop() const
+bool Initialization::runMainLoop() const
 {
-    core.systems().runMainLoop();
+    return core.systems().runMainLoop();
 }
 
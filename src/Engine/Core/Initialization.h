@@ -11,7 +11,7 @@ public:
     Initialization();
     ~Initialization();
 
-    void runMainLoop() const;
+    bool runMainLoop() const;
 private:
     IDK::Core& core;
     EngineAccess access;
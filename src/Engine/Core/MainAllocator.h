@@ -5,8 +5,13 @@
 #ifndef MAINALLOCATOR_H
 #define MAINALLOCATOR_H
 
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
 #include <iostream>
 #include <mutex>
+#include <type_traits>
 #include <unordered_map>
 #include "GLFW/glfw3.h"
 #include <vector>
@@ -14,13 +19,7 @@
 #include <algorithm>
 #include <cassert>
 #include <memory>
-#include <unordered_set>
-
-#ifdef _WIN32
-#include <malloc.h>
-#else
-#include <cstdlib>
-#endif
+#include "PoolAllocator.h"
 
 
 namespace IDK
@@ -104,284 +103,255 @@ namespace IDK
         static inline std::mutex mutex;
     };
 
+    using MemoryCategoryId = uint16_t;
+
+    // Live bytes/count per category, kept in per-thread shards so tracking is
+    // a couple of uncontended relaxed stores. Untracking may happen on another
+    // thread; shard values can go negative and only the sum is meaningful.
+    // With a sampling interval set, every Nth tracked allocation on a thread
+    // also records its call site.
     class MemoryTracker
     {
     public:
-        struct AllocationInfo
+        static constexpr size_t MaxCategories = 64;
+        static constexpr size_t MaxCategoryName = 32;
+        static constexpr size_t MaxCallSites = 64;
+
+        struct CategoryStats
         {
-            std::string type;
-            size_t size;
+            const char* name = "";
+            int64_t bytes = 0;
+            int64_t liveCount = 0;
+            uint64_t totalAllocations = 0;
         };
 
-        static void TrackAllocation(const char* type, void* ptr, size_t size) {
-            std::lock_guard<std::mutex> lock(mutex);
-            allocations[ptr] = { type, size };
-            totalAllocated += size;
-           // std::cout << "[MEMORY] Allocated " << type << " at " << ptr << " size: " << size << " bytes.\n";
-           // PrintCurrentUsage();
-        }
-
-        static void UntrackAllocation(const char* type, void* ptr) {
-            std::lock_guard<std::mutex> lock(mutex);
-            auto it = allocations.find(ptr);
-            if (it != allocations.end()) {
-                totalAllocated -= it->second.size;
-               // std::cout << "[MEMORY] Deallocated " << type << " at " << ptr << " size: " << it->second.size << " bytes.\n";
-                allocations.erase(it);
-            } else {
-               // std::cerr << "[MEMORY] Untracked deallocation for " << type << " at " << ptr << "\n";
-            }
-          //  PrintCurrentUsage();
-        }
-
-        template<typename T>
-        static void TrackAllocation(const char* type, const std::shared_ptr<T>& ptr, size_t size)
+        struct CallSite
         {
-            TrackAllocation(type, static_cast<void*>(ptr.get()), size);
-        }
+            const char* file = nullptr;
+            uint32_t line = 0;
+            MemoryCategoryId category = 0;
+            uint64_t hits = 0;
+            uint64_t bytes = 0;
+        };
 
-        template<typename T>
-        static void UntrackAllocation(const char* type, const std::shared_ptr<T>& ptr)
+        struct Snapshot
         {
-            UntrackAllocation(type, static_cast<void*>(ptr.get()));
-        }
-        static size_t GetTotalUsage() {
-            std::lock_guard<std::mutex> lock(mutex);
-            return totalAllocated;
-        }
-
-        static void PrintCurrentUsage() {
-            std::cout << "[MEMORY] Total allocated: " << totalAllocated / 1024 << " KB (" << allocations.size() << " allocations).\n";
-        }
-
-        static std::unordered_map<void*, AllocationInfo> GetAllocations() {
-            std::lock_guard<std::mutex> lock(mutex);
-            return allocations;
-        }
-    private:
-        static inline std::unordered_map<void*, AllocationInfo> allocations;
-        static inline size_t totalAllocated = 0;
-        static inline std::mutex mutex;
-    };
+            int64_t totalBytes = 0;
+            int64_t liveCount = 0;
+            uint32_t samplingInterval = 0;
+            size_t categoryCount = 0;
+            std::array<CategoryStats, MaxCategories> categories{};
+            size_t callSiteCount = 0;
+            std::array<CallSite, MaxCallSites> callSites{};
+        };
 
-    template<typename T>
-    class MeshPoolAllocator
-    {
-    public:
-        using value_type = T;
-        using pointer = T*;
-        using const_pointer = const T*;
-        using reference = T&;
-        using const_reference = const T&;
-        using size_type = std::size_t;
-        using difference_type = std::ptrdiff_t;
+        // Same name -> same id. Takes a lock; cache the result (the TRACK_ALLOC macros do).
+        static MemoryCategoryId RegisterCategory(const char* name) {
+            Registry& registry = GetRegistry();
+            std::lock_guard lock(registry.mutex);
 
+            const size_t count = registry.count.load(std::memory_order_relaxed);
+            for (size_t i = 0; i < count; ++i) {
+                if (std::strncmp(registry.names[i], name, MaxCategoryName - 1) == 0)
+                    return static_cast<MemoryCategoryId>(i);
+            }
 
-        template<typename U>
-        struct rebind
-        {
-            using other=  MeshPoolAllocator<U>;
-        };
+            if (count == MaxCategories) {
+                std::cerr << "[MEMORY] Out of tracker categories, '" << name << "' folded into '" << registry.names[0] << "'\n";
+                return 0;
+            }
 
-        // cross-platform aligned allocation
-        static pointer aligned_allocate(size_type size, size_type alignment) {
-            if (size == 0)
-                return nullptr;
-#ifdef _WIN32
-            void *ptr = _aligned_malloc(size * sizeof(T), alignment);
-            if (!ptr)
-                throw std::bad_alloc();
-#else
-            void *ptr = nullptr;
-            if (posix_memalign(&ptr, alignment, size * sizeof(T)) != 0)
-                throw std::bad_alloc();
-#endif
-            return static_cast<pointer>(ptr);
+            std::strncpy(registry.names[count], name, MaxCategoryName - 1);
+            registry.count.store(count + 1, std::memory_order_release);
+            return static_cast<MemoryCategoryId>(count);
         }
 
-        // cross-platform aligne deallocation
-        static void aligned_deallocate(pointer p)
-        {
-#ifdef _WIN32
-            _aligned_free(p);
-#else
-            std::free(p)
-#endif
-        }
+        static void TrackAllocation(MemoryCategoryId category, size_t size, const char* file = nullptr, uint32_t line = 0) {
+            Shard& shard = LocalShard();
+            Bump(shard.bytes[category], static_cast<int64_t>(size));
+            Bump(shard.liveCount[category], 1);
+            Bump(shard.totalAllocations[category], 1);
 
-        void clear_all_chunks()
-        {
-            for (auto& chunk : m_chunks)
-            {
-                aligned_deallocate(chunk->memory);
+            const uint32_t interval = s_samplingInterval.load(std::memory_order_relaxed);
+            if (interval != 0 && file && ++shard.sinceSample >= interval) {
+                shard.sinceSample = 0;
+                Sample(shard, category, size, file, line);
             }
-            m_chunks.clear();
         }
 
-        // ctor with default chunk size
-        explicit MeshPoolAllocator(const size_type& chunkSize = 1024)
-            : m_chunkSize(chunkSize)
-        {
-            std::lock_guard<std::mutex> lock(GlobalCleanup::instance_mutex);
-            GlobalCleanup::instances.insert(this);
+        static void UntrackAllocation(MemoryCategoryId category, size_t size) {
+            Shard& shard = LocalShard();
+            Bump(shard.bytes[category], -static_cast<int64_t>(size));
+            Bump(shard.liveCount[category], -1);
         }
 
-        // copy ctor
-        template<typename U>
-        MeshPoolAllocator(const MeshPoolAllocator<U>& other) :
-            m_chunkSize(other.m_chunkSize){}
-
-        ~MeshPoolAllocator()
-        {
-            std::lock_guard<std::mutex> lock(GlobalCleanup::instance_mutex);
-            clear_all_chunks();
-            GlobalCleanup::instances.erase(this);
-        }
-
-        // custom uniqut_ptr deleter
-        template<typename E>
-        struct MeshDeleter
-        {
-            void operator()(E* ptr)
-            {
-                if (ptr)
-                {
-                    ptr->~T();
-                    MeshPoolAllocator<E>::aligned_deallocate(ptr);
+        // 0 disables call-site sampling.
+        static void SetSamplingInterval(uint32_t every) { s_samplingInterval.store(every, std::memory_order_relaxed); }
+        static uint32_t GetSamplingInterval() { return s_samplingInterval.load(std::memory_order_relaxed); }
+
+        // Sums the shards; no locks and no heap allocation.
+        static void GetSnapshot(Snapshot& snapshot) {
+            Registry& registry = GetRegistry();
+            snapshot.categoryCount = registry.count.load(std::memory_order_acquire);
+            snapshot.samplingInterval = GetSamplingInterval();
+            snapshot.totalBytes = 0;
+            snapshot.liveCount = 0;
+            snapshot.callSiteCount = 0;
+
+            for (size_t i = 0; i < snapshot.categoryCount; ++i)
+                snapshot.categories[i] = CategoryStats{registry.names[i]};
+
+            for (Shard* shard = s_shards.load(std::memory_order_acquire); shard; shard = shard->next) {
+                for (size_t i = 0; i < snapshot.categoryCount; ++i) {
+                    CategoryStats& stats = snapshot.categories[i];
+                    stats.bytes += shard->bytes[i].load(std::memory_order_relaxed);
+                    stats.liveCount += shard->liveCount[i].load(std::memory_order_relaxed);
+                    stats.totalAllocations += shard->totalAllocations[i].load(std::memory_order_relaxed);
                 }
+                MergeCallSites(*shard, snapshot);
             }
-        };
 
-        pointer allocate(size_type n)
-        {
-            if (n == 0) return nullptr;
-
-            // find a chunk with enough free space
-            for (auto& chunk : m_chunks)
-            {
-                if (chunk->freeBlocks >= n)
-                {
-                    pointer ptr = chunk->memory + chunk->usedBlocks;
-                    chunk->usedBlocks += n;
-                    chunk->freeBlocks -= n;
-                    return ptr;
-                }
+            for (size_t i = 0; i < snapshot.categoryCount; ++i) {
+                snapshot.totalBytes += snapshot.categories[i].bytes;
+                snapshot.liveCount += snapshot.categories[i].liveCount;
             }
-
-            // no avail space - allocate new chunk
-            size_type elementsInChunk = std::max(m_chunkSize, n);
-            std::unique_ptr<Chunk> newChunk(new Chunk());
-            newChunk->memory = aligned_allocate(elementsInChunk, alignof(T));
-            newChunk->totalBlocks = elementsInChunk;
-            newChunk->usedBlocks = n;
-            newChunk->freeBlocks = elementsInChunk - n;
-            pointer ret = newChunk->memory;
-            m_chunks.push_back(std::move(newChunk));
-            return ret;
         }
 
-        void deallocate(pointer /*p*/, size_type /*n*/) {}
-
-        void printMemUsage() const
-        {
-            size_type totalAllocated = 0;
-            size_type totalUsed = 0;
-
-            for (const auto& chunk : m_chunks)
-            {
-                totalAllocated += chunk->totalBlocks * sizeof(T);
-                totalUsed += chunk->usedBlocks * sizeof(T);
+        static size_t GetTotalUsage() {
+            int64_t total = 0;
+            for (Shard* shard = s_shards.load(std::memory_order_acquire); shard; shard = shard->next) {
+                for (const auto& bytes : shard->bytes)
+                    total += bytes.load(std::memory_order_relaxed);
             }
-            std::cout << "Used memory: " << totalUsed << " bytes / total: " << totalAllocated << " bytes" << std::endl;
+            return total > 0 ? static_cast<size_t>(total) : 0;
         }
-        static size_type getMemoryUsage(size_type numElements) {
-            return numElements * sizeof(T);
+
+        // sizeof the pointee for raw/smart pointers to complete types, 0 otherwise (e.g. GLFWwindow).
+        template<typename Ptr>
+        static constexpr size_t SizeOf(const Ptr&) {
+            using T = std::remove_cvref_t<decltype(*std::declval<const Ptr&>())>;
+            if constexpr (requires { sizeof(T); })
+                return sizeof(T);
+            else
+                return 0;
         }
 
     private:
-        struct Chunk
+        struct SampleSlot
         {
-            pointer memory = nullptr;
-            size_type usedBlocks = 0;
-            size_type freeBlocks = 0;
-            size_type totalBlocks = 0;
-
-            ~Chunk()
-            {
-                if (memory)
-                {
-#ifdef _WIN32
-                    _aligned_free(memory);
-#else
-                    free(memory)
-#endif
-                }
-            }
+            std::atomic<const char*> file{nullptr};
+            std::atomic<uint32_t> line{0};
+            std::atomic<MemoryCategoryId> category{0};
+            std::atomic<uint64_t> hits{0};
+            std::atomic<uint64_t> bytes{0};
         };
 
-        std::vector<std::unique_ptr<Chunk>> m_chunks;
-        size_type m_chunkSize;
-
-        struct GlobalCleanup
+        // Written only by its owning thread, read by snapshots.
+        struct alignas(64) Shard
         {
-            ~GlobalCleanup()
-            {
-                std::lock_guard<std::mutex> lock(instance_mutex);
-                for (auto instance : instances)
-                    instance->clear_all_chunks();
-            }
+            std::array<std::atomic<int64_t>, MaxCategories> bytes{};
+            std::array<std::atomic<int64_t>, MaxCategories> liveCount{};
+            std::array<std::atomic<uint64_t>, MaxCategories> totalAllocations{};
+            std::array<SampleSlot, MaxCallSites> samples{};
+            uint32_t sinceSample = 0;
+            Shard* next = nullptr;
+        };
 
-            static std::mutex instance_mutex;
-            static std::unordered_set<MeshPoolAllocator*> instances;
+        struct Registry
+        {
+            std::mutex mutex;
+            std::atomic<size_t> count{0};
+            char names[MaxCategories][MaxCategoryName]{};
         };
 
-        static GlobalCleanup cleanup;
-    };
+        template<typename T>
+        static void Bump(std::atomic<T>& counter, std::type_identity_t<T> delta) {
+            counter.store(counter.load(std::memory_order_relaxed) + delta, std::memory_order_relaxed);
+        }
 
-    template<typename T>
-    std::mutex MeshPoolAllocator<T>::GlobalCleanup::instance_mutex;
+        static Registry& GetRegistry() {
+            static Registry registry;
+            return registry;
+        }
 
-    template<typename T>
-    std::unordered_set<MeshPoolAllocator<T>*> MeshPoolAllocator<T>::GlobalCleanup::instances;
+        // Shards are never freed: a thread's net counts must outlive it.
+        static Shard& LocalShard() {
+            thread_local Shard* shard = [] {
+                auto* created = new Shard();
+                created->next = s_shards.load(std::memory_order_relaxed);
+                while (!s_shards.compare_exchange_weak(created->next, created, std::memory_order_release, std::memory_order_relaxed)) {}
+                return created;
+            }();
+            return *shard;
+        }
 
-    template<typename T>
-    typename MeshPoolAllocator<T>::GlobalCleanup MeshPoolAllocator<T>::cleanup;
+        static void Sample(Shard& shard, MemoryCategoryId category, size_t size, const char* file, uint32_t line) {
+            const size_t hash = (reinterpret_cast<uintptr_t>(file) >> 3) * 31u + line;
+            for (size_t probe = 0; probe < MaxCallSites; ++probe) {
+                SampleSlot& slot = shard.samples[(hash + probe) % MaxCallSites];
+                const char* slotFile = slot.file.load(std::memory_order_relaxed);
+
+                if (!slotFile) {
+                    slot.line.store(line, std::memory_order_relaxed);
+                    slot.category.store(category, std::memory_order_relaxed);
+                    slot.file.store(file, std::memory_order_release);
+                } else if (slotFile != file || slot.line.load(std::memory_order_relaxed) != line) {
+                    continue;
+                }
 
-    template<typename T>
-    struct MeshSharedAllocator
-    {
-        using value_type = T;
+                Bump(slot.hits, 1);
+                Bump(slot.bytes, static_cast<uint64_t>(size));
+                return;
+            }
+        }
 
-        MeshSharedAllocator() = default;
+        static void MergeCallSites(const Shard& shard, Snapshot& snapshot) {
+            for (const SampleSlot& slot : shard.samples) {
+                const char* file = slot.file.load(std::memory_order_acquire);
+                if (!file) continue;
+
+                const uint32_t line = slot.line.load(std::memory_order_relaxed);
+                CallSite* site = nullptr;
+                for (size_t i = 0; i < snapshot.callSiteCount; ++i) {
+                    if (snapshot.callSites[i].file == file && snapshot.callSites[i].line == line) {
+                        site = &snapshot.callSites[i];
+                        break;
+                    }
+                }
 
-        template<typename U>
-        MeshSharedAllocator(const MeshSharedAllocator<U>&) noexcept{}
+                if (!site) {
+                    if (snapshot.callSiteCount == MaxCallSites) continue;
+                    site = &snapshot.callSites[snapshot.callSiteCount++];
+                    *site = CallSite{file, line, slot.category.load(std::memory_order_relaxed)};
+                }
 
-        T* allocate(std::size_t n)
-        {
-            return static_cast<T*>(MeshPoolAllocator<T>::aligned_allocate(n, alignof(T)));
+                site->hits += slot.hits.load(std::memory_order_relaxed);
+                site->bytes += slot.bytes.load(std::memory_order_relaxed);
+            }
         }
 
-        void deallocate(T* p, std::size_t n) noexcept
-        {
-            MeshPoolAllocator<T>::aligned_deallocate(p);
-        }
+        static inline std::atomic<Shard*> s_shards{nullptr};
+        static inline std::atomic<uint32_t> s_samplingInterval{0};
     };
 
-    template<typename T, typename U>
-    bool operator==(const MeshSharedAllocator<T>&, const MeshSharedAllocator<U>&) { return true; }
-
-    template<typename T, typename U>
-    bool operator!=(const MeshSharedAllocator<T>&, const MeshSharedAllocator<U>&) { return false; }
+    // Mesh vertex/index storage and allocate_shared'd meshes draw from the shared block pools.
+    template<typename T>
+    using MeshPoolAllocator = PoolAllocator<T>;
 
+    template<typename T>
+    using MeshSharedAllocator = PoolAllocator<T>;
 }
 
 #ifdef ENABLE_MEMORY_TRACKING
-#define TRACK_ALLOC(ptr, type) IDK::MemoryTracker::TrackAllocation(#type, ptr, sizeof(type))
-#define UNTRACK_ALLOC(ptr, type) IDK::MemoryTracker::UntrackAllocation(#type, ptr)
+#define IDK_MEMORY_CATEGORY(category) \
+    [] { static const IDK::MemoryCategoryId id = IDK::MemoryTracker::RegisterCategory(category); return id; }()
+#define TRACK_ALLOC(ptr, category) \
+    IDK::MemoryTracker::TrackAllocation(IDK_MEMORY_CATEGORY(category), IDK::MemoryTracker::SizeOf(ptr), __FILE__, __LINE__)
+#define UNTRACK_ALLOC(ptr, category) \
+    IDK::MemoryTracker::UntrackAllocation(IDK_MEMORY_CATEGORY(category), IDK::MemoryTracker::SizeOf(ptr))
 #else
-#define TRACK_ALLOC(ptr, type)
-#define UNTRACK_ALLOC(ptr, type)
+#define TRACK_ALLOC(ptr, category)
+#define UNTRACK_ALLOC(ptr, category)
 #endif
 
 #endif //MAINALLOCATOR_H
@@ -0,0 +1,301 @@
+//
+// Created by SIMEON on 10/17/2026.
+//
+
+#ifndef POOLALLOCATOR_H
+#define POOLALLOCATOR_H
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <mutex>
+#include <new>
+#include <vector>
+
+#ifdef _WIN32
+#include <malloc.h>
+#endif
+
+namespace IDK
+{
+    // Power-of-two size classes (16 B .. 64 KB) of fixed blocks carved from
+    // 64-byte aligned slabs. Free blocks are linked through their own storage,
+    // so allocate/free are O(1). Each thread keeps a small per-class cache and
+    // only touches the shared, locked free list in batches.
+    class BlockPool
+    {
+    public:
+        static constexpr size_t MinBlockShift = 4;
+        static constexpr size_t MaxBlockShift = 16;
+        static constexpr size_t ClassCount = MaxBlockShift - MinBlockShift + 1;
+        static constexpr size_t MaxBlockSize = size_t(1) << MaxBlockShift;
+        static constexpr size_t SlabAlignment = 64;
+
+        struct ClassStats
+        {
+            size_t blockSize;
+            size_t reservedBytes;     // slab memory owned by the class
+            size_t blocksOutstanding; // in use or sitting in thread caches
+        };
+
+        static void* Allocate(size_t bytes, size_t alignment = alignof(std::max_align_t)) {
+            if (bytes == 0) bytes = 1;
+            if (bytes > MaxBlockSize || alignment > SlabAlignment)
+                return AlignedAllocate(bytes, alignment);
+
+            const size_t index = ClassIndex(bytes < alignment ? alignment : bytes);
+            if (s_cacheRetired)
+                return TakeShared(index);
+
+            ThreadCache& cache = Cache();
+            if (!cache.heads[index])
+                Refill(index, cache);
+
+            FreeBlock* block = cache.heads[index];
+            cache.heads[index] = block->next;
+            --cache.counts[index];
+            return block;
+        }
+
+        static void Deallocate(void* ptr, size_t bytes, size_t alignment = alignof(std::max_align_t)) noexcept {
+            if (!ptr) return;
+            if (bytes == 0) bytes = 1;
+            if (bytes > MaxBlockSize || alignment > SlabAlignment) {
+                AlignedDeallocate(ptr);
+                return;
+            }
+
+            const size_t index = ClassIndex(bytes < alignment ? alignment : bytes);
+            auto* block = static_cast<FreeBlock*>(ptr);
+            if (s_cacheRetired) {
+                ReturnShared(index, block);
+                return;
+            }
+
+            ThreadCache& cache = Cache();
+            block->next = cache.heads[index];
+            cache.heads[index] = block;
+
+            if (++cache.counts[index] > 2 * BatchSize(index))
+                Flush(index, cache, BatchSize(index));
+        }
+
+        static std::array<ClassStats, ClassCount> GetStats() {
+            std::array<ClassStats, ClassCount> stats{};
+            SizeClass* classes = Classes();
+            for (size_t i = 0; i < ClassCount; ++i) {
+                stats[i].blockSize = BlockSize(i);
+                stats[i].reservedBytes = classes[i].reservedBytes.load(std::memory_order_relaxed);
+                stats[i].blocksOutstanding = classes[i].outstanding.load(std::memory_order_relaxed);
+            }
+            return stats;
+        }
+
+        static void* AlignedAllocate(size_t bytes, size_t alignment) {
+            if (alignment < alignof(void*)) alignment = alignof(void*);
+#ifdef _WIN32
+            void* ptr = _aligned_malloc(bytes, alignment);
+            if (!ptr)
+                throw std::bad_alloc();
+#else
+            void* ptr = nullptr;
+            if (posix_memalign(&ptr, alignment, bytes) != 0)
+                throw std::bad_alloc();
+#endif
+            return ptr;
+        }
+
+        static void AlignedDeallocate(void* ptr) noexcept {
+#ifdef _WIN32
+            _aligned_free(ptr);
+#else
+            std::free(ptr);
+#endif
+        }
+
+    private:
+        struct FreeBlock
+        {
+            FreeBlock* next;
+        };
+
+        struct SizeClass
+        {
+            std::mutex mutex;
+            FreeBlock* freeList = nullptr;
+            std::vector<void*> slabs;
+            std::atomic<size_t> reservedBytes{0};
+            std::atomic<size_t> outstanding{0};
+        };
+
+        struct ThreadCache
+        {
+            std::array<FreeBlock*, ClassCount> heads{};
+            std::array<size_t, ClassCount> counts{};
+
+            ~ThreadCache() {
+                for (size_t i = 0; i < ClassCount; ++i)
+                    Flush(i, *this, 0);
+                s_cacheRetired = true;
+            }
+        };
+
+        // Set once this thread's cache is gone (late frees from static/TLS destructors).
+        static inline thread_local bool s_cacheRetired = false;
+
+        static constexpr size_t BlockSize(size_t index) {
+            return size_t(1) << (index + MinBlockShift);
+        }
+
+        static constexpr size_t ClassIndex(size_t bytes) {
+            const size_t shift = std::bit_width(bytes - 1);
+            return shift <= MinBlockShift ? 0 : shift - MinBlockShift;
+        }
+
+        static constexpr size_t BatchSize(size_t index) {
+            const size_t batch = (16 * 1024) / BlockSize(index);
+            return batch < 4 ? 4 : (batch > 64 ? 64 : batch);
+        }
+
+        static constexpr size_t SlabSize(size_t index) {
+            const size_t minimum = BlockSize(index) * 8;
+            return minimum < 64 * 1024 ? 64 * 1024 : minimum;
+        }
+
+        // Intentionally never destroyed: blocks may be freed by static
+        // destructors that run after this would have been torn down.
+        static SizeClass* Classes() {
+            static SizeClass* classes = new SizeClass[ClassCount];
+            return classes;
+        }
+
+        static ThreadCache& Cache() {
+            thread_local ThreadCache cache;
+            return cache;
+        }
+
+        // Caller holds sizeClass.mutex.
+        static void Grow(size_t index, SizeClass& sizeClass) {
+            const size_t blockSize = BlockSize(index);
+            const size_t slabSize = SlabSize(index);
+            auto* slab = static_cast<std::byte*>(AlignedAllocate(slabSize, SlabAlignment));
+            sizeClass.slabs.push_back(slab);
+            sizeClass.reservedBytes.fetch_add(slabSize, std::memory_order_relaxed);
+
+            for (size_t offset = slabSize; offset >= blockSize; offset -= blockSize) {
+                auto* block = reinterpret_cast<FreeBlock*>(slab + offset - blockSize);
+                block->next = sizeClass.freeList;
+                sizeClass.freeList = block;
+            }
+        }
+
+        static void* TakeShared(size_t index) {
+            SizeClass& sizeClass = Classes()[index];
+            std::lock_guard lock(sizeClass.mutex);
+            if (!sizeClass.freeList)
+                Grow(index, sizeClass);
+
+            FreeBlock* block = sizeClass.freeList;
+            sizeClass.freeList = block->next;
+            sizeClass.outstanding.fetch_add(1, std::memory_order_relaxed);
+            return block;
+        }
+
+        static void ReturnShared(size_t index, FreeBlock* block) noexcept {
+            SizeClass& sizeClass = Classes()[index];
+            std::lock_guard lock(sizeClass.mutex);
+            block->next = sizeClass.freeList;
+            sizeClass.freeList = block;
+            sizeClass.outstanding.fetch_sub(1, std::memory_order_relaxed);
+        }
+
+        static void Refill(size_t index, ThreadCache& cache) {
+            SizeClass& sizeClass = Classes()[index];
+            const size_t batch = BatchSize(index);
+
+            std::lock_guard lock(sizeClass.mutex);
+            if (!sizeClass.freeList)
+                Grow(index, sizeClass);
+
+            size_t moved = 0;
+            while (sizeClass.freeList && moved < batch) {
+                FreeBlock* block = sizeClass.freeList;
+                sizeClass.freeList = block->next;
+                block->next = cache.heads[index];
+                cache.heads[index] = block;
+                ++moved;
+            }
+            cache.counts[index] += moved;
+            sizeClass.outstanding.fetch_add(moved, std::memory_order_relaxed);
+        }
+
+        static void Flush(size_t index, ThreadCache& cache, size_t keep) noexcept {
+            if (cache.counts[index] <= keep) return;
+
+            SizeClass& sizeClass = Classes()[index];
+            size_t moved = 0;
+
+            std::lock_guard lock(sizeClass.mutex);
+            while (cache.counts[index] > keep) {
+                FreeBlock* block = cache.heads[index];
+                cache.heads[index] = block->next;
+                block->next = sizeClass.freeList;
+                sizeClass.freeList = block;
+                --cache.counts[index];
+                ++moved;
+            }
+            sizeClass.outstanding.fetch_sub(moved, std::memory_order_relaxed);
+        }
+    };
+
+    // Stateless STL allocator over BlockPool; all instances compare equal.
+    template<typename T>
+    class PoolAllocator
+    {
+    public:
+        using value_type = T;
+        using pointer = T*;
+        using const_pointer = const T*;
+        using reference = T&;
+        using const_reference = const T&;
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+
+        template<typename U>
+        struct rebind
+        {
+            using other = PoolAllocator<U>;
+        };
+
+        PoolAllocator() noexcept = default;
+
+        template<typename U>
+        PoolAllocator(const PoolAllocator<U>&) noexcept {}
+
+        pointer allocate(size_type n) {
+            if (n > std::numeric_limits<size_type>::max() / sizeof(T))
+                throw std::bad_array_new_length();
+            return static_cast<pointer>(BlockPool::Allocate(n * sizeof(T), alignof(T)));
+        }
+
+        void deallocate(pointer p, size_type n) noexcept {
+            BlockPool::Deallocate(p, n * sizeof(T), alignof(T));
+        }
+
+        static size_type getMemoryUsage(size_type numElements) {
+            return numElements * sizeof(T);
+        }
+    };
+
+    template<typename T, typename U>
+    bool operator==(const PoolAllocator<T>&, const PoolAllocator<U>&) noexcept { return true; }
+
+    template<typename T, typename U>
+    bool operator!=(const PoolAllocator<T>&, const PoolAllocator<U>&) noexcept { return false; }
+}
+
+#endif //POOLALLOCATOR_H
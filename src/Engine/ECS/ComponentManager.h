@@ -7,46 +7,44 @@
 
 #include "IComponentManager.h"
 #include <unordered_map>
+#include <vector>
 
+// One sparse-set pool per component type, indexed by TypeIndex so lookups
+// never hash a type_index.
 class ComponentManager : public IComponentManager {
 public:
     std::unordered_map<std::type_index, std::shared_ptr<Component>>
         getAllComponentsForEntity(EntityID id) const override {
         std::unordered_map<std::type_index, std::shared_ptr<Component>> result;
 
-        for (const auto& [type, entityMap] : m_components) {
-            auto it = entityMap.find(id);
-            if (it != entityMap.end()) {
-                result[type] = it->second;
+        for (const auto& pool : m_pools) {
+            if (!pool || !pool->contains(id)) continue;
+            if (auto component = pool->share(id)) {
+                result.emplace(pool->type(), std::move(component));
             }
         }
 
         return result;
     }
 
-protected:
-    void* getComponentImpl(EntityID id, std::type_index type) const override {
-        auto it = m_components.find(type);
-        if (it != m_components.end()) {
-            auto compIt = it->second.find(id);
-            if (compIt != it->second.end())
-                return compIt->second.get();
+    void removeAllComponentsForEntity(EntityID id) override {
+        for (const auto& pool : m_pools) {
+            if (pool) pool->remove(id);
         }
-        return nullptr;
     }
 
-    void addComponentImpl(EntityID id, std::type_index type, std::shared_ptr<Component> comp) override {
-        m_components[type][id] = comp;
+protected:
+    IComponentPool* getPoolImpl(size_t typeIndex) const override {
+        return typeIndex < m_pools.size() ? m_pools[typeIndex].get() : nullptr;
     }
 
-    void removeComponentImpl(EntityID id, std::type_index type) override {
-        auto it = m_components.find(type);
-        if (it != m_components.end())
-            it->second.erase(id);
+    void addPoolImpl(size_t typeIndex, std::unique_ptr<IComponentPool> pool) override {
+        if (typeIndex >= m_pools.size())
+            m_pools.resize(typeIndex + 1);
+        m_pools[typeIndex] = std::move(pool);
     }
 
-
 private:
-    std::unordered_map<std::type_index, std::unordered_map<EntityID, std::shared_ptr<Component>>> m_components;
+    std::vector<std::unique_ptr<IComponentPool>> m_pools;
 };
 #endif //COMPONENTMANAGER_H
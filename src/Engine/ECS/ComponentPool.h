@@ -0,0 +1,182 @@
+//
+// Created by SIMEON on 10/17/2026.
+//
+
+#ifndef COMPONENTPOOL_H
+#define COMPONENTPOOL_H
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <typeindex>
+#include <vector>
+#include "Component.h"
+#include "PoolAllocator.h"
+
+using EntityID = uint32_t;
+
+// Sparse set: m_sparse maps an EntityID to its slot in the dense arrays,
+// the dense arrays are packed and iterated linearly.
+class IComponentPool {
+public:
+    static constexpr uint32_t npos = UINT32_MAX;
+
+    virtual ~IComponentPool() = default;
+
+    virtual std::type_index type() const = 0;
+    virtual void remove(EntityID id) = 0;
+    virtual std::shared_ptr<Component> share(EntityID id) const = 0;
+
+    bool contains(EntityID id) const {
+        return id < m_sparse.size() && m_sparse[id] != npos;
+    }
+
+    size_t size() const { return m_entities.size(); }
+    bool empty() const { return m_entities.empty(); }
+    const std::vector<EntityID>& entities() const { return m_entities; }
+
+protected:
+    uint32_t indexOf(EntityID id) const {
+        return id < m_sparse.size() ? m_sparse[id] : npos;
+    }
+
+    void link(EntityID id) {
+        if (id >= m_sparse.size())
+            m_sparse.resize(static_cast<size_t>(id) + 1, npos);
+        m_sparse[id] = static_cast<uint32_t>(m_entities.size());
+        m_entities.push_back(id);
+    }
+
+    // Swap-and-pop; returns the dense index that was vacated.
+    uint32_t unlink(EntityID id) {
+        const uint32_t index = m_sparse[id];
+        const EntityID last = m_entities.back();
+        m_entities[index] = last;
+        m_sparse[last] = index;
+        m_sparse[id] = npos;
+        m_entities.pop_back();
+        return index;
+    }
+
+    std::vector<uint32_t> m_sparse;
+    std::vector<EntityID> m_entities;
+};
+
+template<typename T>
+class ComponentPool final : public IComponentPool {
+    // Components live in fixed-size pages so their addresses never change,
+    // which keeps T& / T* / shared_from_this() valid across inserts.
+    struct Storage {
+        static constexpr size_t PageSize = 256;
+
+        ~Storage() {
+            for (T* page : pages)
+                ::operator delete(page, std::align_val_t(alignof(T)));
+        }
+
+        T* acquire() {
+            std::lock_guard lock(mutex);
+            if (!freeSlots.empty()) {
+                T* slot = freeSlots.back();
+                freeSlots.pop_back();
+                return slot;
+            }
+            if (pages.empty() || used == PageSize) {
+                pages.push_back(static_cast<T*>(
+                    ::operator new(sizeof(T) * PageSize, std::align_val_t(alignof(T)))));
+                used = 0;
+            }
+            return pages.back() + used++;
+        }
+
+        void recycle(T* slot) {
+            std::lock_guard lock(mutex);
+            freeSlots.push_back(slot);
+        }
+
+        std::vector<T*> pages;
+        std::vector<T*> freeSlots;
+        size_t used = 0;
+        std::mutex mutex;
+    };
+
+    // Outstanding shared_ptrs keep the storage alive, so a component removed
+    // from the pool is only destroyed once its last owner lets go.
+    struct Release {
+        std::shared_ptr<Storage> storage;
+
+        void operator()(T* component) const {
+            std::destroy_at(component);
+            storage->recycle(component);
+        }
+    };
+
+public:
+    ComponentPool() : m_storage(std::make_shared<Storage>()) {}
+
+    ComponentPool(const ComponentPool&) = delete;
+    ComponentPool& operator=(const ComponentPool&) = delete;
+
+    template<typename... Args>
+    T& emplace(EntityID id, Args&&... args) {
+        if (contains(id))
+            remove(id);
+
+        T* slot = m_storage->acquire();
+        try {
+            std::construct_at(slot, std::forward<Args>(args)...);
+        } catch (...) {
+            m_storage->recycle(slot);
+            throw;
+        }
+
+        std::shared_ptr<T> handle(slot, Release{m_storage}, IDK::PoolAllocator<T>());
+        link(id);
+        m_components.push_back(slot);
+        m_handles.push_back(std::move(handle));
+        return *slot;
+    }
+
+    T* get(EntityID id) const {
+        const uint32_t index = indexOf(id);
+        return index != npos ? m_components[index] : nullptr;
+    }
+
+    void remove(EntityID id) override {
+        if (!contains(id)) return;
+
+        const uint32_t index = unlink(id);
+        m_components[index] = m_components.back();
+        m_components.pop_back();
+
+        std::swap(m_handles[index], m_handles.back());
+        m_handles.pop_back();
+    }
+
+    std::shared_ptr<Component> share(EntityID id) const override {
+        const uint32_t index = indexOf(id);
+        if constexpr (std::is_base_of_v<Component, T>) {
+            return index != npos ? m_handles[index] : nullptr;
+        } else {
+            return nullptr;
+        }
+    }
+
+    std::shared_ptr<T> handle(EntityID id) const {
+        const uint32_t index = indexOf(id);
+        return index != npos ? m_handles[index] : nullptr;
+    }
+
+    std::type_index type() const override { return typeid(T); }
+
+    // Dense component array, parallel to entities().
+    const std::vector<T*>& components() const { return m_components; }
+
+private:
+    std::shared_ptr<Storage> m_storage;
+    std::vector<T*> m_components;
+    std::vector<std::shared_ptr<T>> m_handles;
+};
+
+#endif //COMPONENTPOOL_H
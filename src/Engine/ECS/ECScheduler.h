@@ -5,12 +5,16 @@
 #ifndef ECSCHEDULER_H
 #define ECSCHEDULER_H
 
+#include <algorithm>
 #include <utility>
 #include <vector>
 #include <functional>
+#include <memory>
+#include <string>
 #include <thread>
 #include <atomic>
-#include <future>
+#include "JobSystem.h"
+#include "TypeIndex.h"
 
 namespace IDK
 {
@@ -25,13 +29,67 @@ namespace IDK
             ParallelBatch
         };
 
+        // Component types a system touches. Parallel systems that declare
+        // access are ordered by conflicts instead of running all at once.
+        struct SystemAccess
+        {
+            std::vector<size_t> reads;
+            std::vector<size_t> writes;
+
+            template<typename... Ts>
+            SystemAccess& read() {
+                (insert(reads, TypeIndex::get<Ts>()), ...);
+                return *this;
+            }
+
+            template<typename... Ts>
+            SystemAccess& write() {
+                (insert(writes, TypeIndex::get<Ts>()), ...);
+                return *this;
+            }
+
+            bool declared() const { return !reads.empty() || !writes.empty(); }
+
+            bool conflictsWith(const SystemAccess& other) const {
+                return intersects(writes, other.writes) ||
+                       intersects(writes, other.reads) ||
+                       intersects(reads, other.writes);
+            }
+
+        private:
+            static void insert(std::vector<size_t>& set, size_t type) {
+                auto it = std::lower_bound(set.begin(), set.end(), type);
+                if (it == set.end() || *it != type)
+                    set.insert(it, type);
+            }
+
+            static bool intersects(const std::vector<size_t>& a, const std::vector<size_t>& b) {
+                auto i = a.begin();
+                auto j = b.begin();
+                while (i != a.end() && j != b.end()) {
+                    if (*i == *j) return true;
+                    if (*i < *j) ++i; else ++j;
+                }
+                return false;
+            }
+        };
+
         struct System
         {
             std::function<void()> func;
             ExecutionPolicy policy;
             std::string name;
+            SystemAccess access = {};
+
+            // ParallelBatch only: func(begin, end) over [0, rangeSize())
+            std::function<void(size_t, size_t)> rangeFunc = nullptr;
+            std::function<size_t()> rangeSize = nullptr;
+            size_t minBatch = 64;
         };
 
+        // workerCount == 0 sizes the pool from hardware_concurrency()
+        explicit ECScheduler(size_t workerCount = 0) : jobs(workerCount) {}
+
         // for classes with update()
         template <typename T, typename... Args>
         void addSystem(ExecutionPolicy policy, Args&&... args)
@@ -42,6 +100,7 @@ namespace IDK
                 policy,
                 typeid(T).name()
             });
+            graphDirty = true;
         }
 
         // for raw func or classes with different method names
@@ -54,6 +113,7 @@ namespace IDK
                 policy,
                 typeid(T).name()
             });
+            graphDirty = true;
         }
 
         void addSystem(std::function<void()> func,
@@ -61,60 +121,140 @@ namespace IDK
             const std::string& name = "")
         {
             systems.push_back({std::move(func), policy, name});
+            graphDirty = true;
         }
 
+        // Systems writing a component run after earlier-registered systems
+        // that read or write it; non-conflicting ones run concurrently.
+        void addSystem(std::function<void()> func,
+            SystemAccess access,
+            ExecutionPolicy policy = ExecutionPolicy::Parallel,
+            const std::string& name = "")
+        {
+            systems.push_back({std::move(func), policy, name, std::move(access)});
+            graphDirty = true;
+        }
+
+        // Splits [0, rangeSize()) into chunks of at least minBatch that run across all workers.
+        void addBatchSystem(std::function<size_t()> rangeSize,
+            std::function<void(size_t, size_t)> rangeFunc,
+            const std::string& name = "",
+            size_t minBatch = 64)
+        {
+            systems.push_back({nullptr, ExecutionPolicy::ParallelBatch, name, {},
+                std::move(rangeFunc), std::move(rangeSize), minBatch});
+            graphDirty = true;
+        }
+
+        JobSystem& getJobSystem() { return jobs; }
+
         void runFrame() {
             if (!running) return;
 
             executeStage<ExecutionPolicy::Immediate>();
-            executeStage<ExecutionPolicy::Parallel>();
+            executeGraph();
+            executeStage<ExecutionPolicy::ParallelBatch>();
             executeStage<ExecutionPolicy::MainThread>();
         }
 
         void shutdown()
         {
             running = false;
+            jobs.wait(pending);
+        }
+
+    private:
+        // Dependency graph over the Parallel systems, rebuilt when systems change.
+        struct GraphNode
+        {
+            size_t system;
+            size_t dependencyCount = 0;
+            std::vector<size_t> dependents;
+        };
 
-            for (auto& f : futures)
+        std::vector<System> systems;
+        std::vector<GraphNode> graph;
+        std::unique_ptr<std::atomic<size_t>[]> remaining;
+        bool graphDirty = true;
+        JobCounter pending;
+        JobSystem jobs;
+        std::atomic<bool> running{true};
+
+        void buildGraph()
+        {
+            graph.clear();
+            for (size_t i = 0; i < systems.size(); ++i)
+            {
+                if (systems[i].policy == ExecutionPolicy::Parallel)
+                    graph.push_back({i, 0, {}});
+            }
+
+            // Edges only go forward in registration order, so the graph is acyclic.
+            for (size_t a = 0; a < graph.size(); ++a)
             {
-                if (f.valid())
+                const SystemAccess& first = systems[graph[a].system].access;
+                if (!first.declared()) continue;
+
+                for (size_t b = a + 1; b < graph.size(); ++b)
                 {
-                    f.wait();
+                    if (first.conflictsWith(systems[graph[b].system].access))
+                    {
+                        graph[a].dependents.push_back(b);
+                        ++graph[b].dependencyCount;
+                    }
                 }
             }
-            futures.clear();
+
+            remaining = std::make_unique<std::atomic<size_t>[]>(graph.size());
+            graphDirty = false;
         }
 
-    private:
-        std::vector<System> systems;
-        std::vector<std::future<void>> futures;
-        std::atomic<bool> running{true};
+        void submitNode(size_t node)
+        {
+            jobs.submit([this, node]() {
+                systems[graph[node].system].func();
+                for (const size_t dependent : graph[node].dependents)
+                {
+                    if (remaining[dependent].fetch_sub(1, std::memory_order_acq_rel) == 1)
+                        submitNode(dependent);
+                }
+            }, pending);
+        }
+
+        void executeGraph()
+        {
+            if (graphDirty)
+                buildGraph();
+
+            for (size_t i = 0; i < graph.size(); ++i)
+                remaining[i].store(graph[i].dependencyCount, std::memory_order_relaxed);
+
+            for (size_t i = 0; i < graph.size(); ++i)
+            {
+                if (graph[i].dependencyCount == 0)
+                    submitNode(i);
+            }
+            jobs.wait(pending);
+        }
 
         template<ExecutionPolicy policy>
         void executeStage()
         {
             for (auto& sys : systems)
             {
-                if (sys.policy == policy){
-                    if (sys.policy == ExecutionPolicy::Parallel)
-                    {
-                        futures.emplace_back(std::async(std::launch::async, sys.func));
-                    }else
-                    {
+                if (sys.policy != policy) continue;
+
+                if constexpr (policy == ExecutionPolicy::ParallelBatch)
+                {
+                    if (sys.rangeFunc)
+                        jobs.parallelFor(sys.rangeSize(), sys.minBatch, sys.rangeFunc);
+                    else
                         sys.func();
-                    }
                 }
-            }
-            if constexpr (policy == ExecutionPolicy::Parallel)
-            {
-                for (auto& f : futures)
+                else
                 {
-                    if (f.valid())
-                    {
-                        f.wait();
-                    }
+                    sys.func();
                 }
-                futures.clear();
             }
         }
     };
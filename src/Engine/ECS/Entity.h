@@ -12,6 +12,7 @@
 #include "Component.h"
 #include "IComponentManager.h"
 #include "Selectable.h"
+#include "Transform.h"
 
 class Entity : public Selectable{
 public:
@@ -20,6 +21,7 @@ public:
 
     EntityID getID() const noexcept { return m_id; }
     std::string getName() const noexcept override { return m_name; }
+    const std::string& getNameRef() const noexcept { return m_name; }
     EntityType getType() const noexcept { return m_type; }
 
     template<typename T>
@@ -46,6 +48,13 @@ public:
     }
     void addChild(const std::shared_ptr<Entity>& child) {
         m_children.push_back(child);
+
+        // Parent the transforms too so the child follows in world space.
+        Transform* transform = getComponent<Transform>();
+        Transform* childTransform = child ? child->getComponent<Transform>() : nullptr;
+        if (transform && childTransform) {
+            childTransform->setParent(transform);
+        }
     }
 
     const std::vector<std::shared_ptr<Entity>>& getChildren() const {
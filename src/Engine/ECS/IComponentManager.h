@@ -8,9 +8,10 @@
 #include <cstdint>
 #include <memory>
 #include <typeindex>
+#include <unordered_map>
 #include "Component.h"
-
-using EntityID = uint32_t;
+#include "ComponentPool.h"
+#include "TypeIndex.h"
 
 class IComponentManager {
 public:
@@ -19,37 +20,54 @@ public:
     template<typename T, typename... Args,
         typename = std::enable_if_t<std::is_constructible_v<T, Args...>>>
     T& addComponent(EntityID id, Args&&... args) {
-        auto comp = std::make_shared<T>(std::forward<Args>(args)...);
-        addComponentImpl(id, std::type_index(typeid(T)), comp);
-        return *comp;
+        return assurePool<T>().emplace(id, std::forward<Args>(args)...);
     }
 
     template<typename T, typename F,
         typename = std::enable_if_t<!std::is_constructible_v<T, F> && std::is_invocable_v<F, T&>>>
     T& addComponent(EntityID id, F&& initializer) {
         static_assert(std::is_default_constructible_v<T>, "T must be default constructible");
-        auto comp = std::make_shared<T>();
-        std::forward<F>(initializer)(*comp);
-        addComponentImpl(id, std::type_index(typeid(T)), comp);
-        return *comp;
+        T& comp = assurePool<T>().emplace(id);
+        std::forward<F>(initializer)(comp);
+        return comp;
     }
 
     template<typename T>
     T* getComponent(EntityID id) const {
-        return static_cast<T*>(getComponentImpl(id, std::type_index(typeid(T))));
+        const auto* pool = getPool<T>();
+        return pool ? pool->get(id) : nullptr;
     }
 
     template<typename T>
     void removeComponent(EntityID id) {
-        removeComponentImpl(id, std::type_index(typeid(T)));
+        if (auto* pool = getPool<T>())
+            pool->remove(id);
     }
+
+    template<typename T>
+    ComponentPool<T>* getPool() const {
+        return static_cast<ComponentPool<T>*>(getPoolImpl(TypeIndex::get<T>()));
+    }
+
     virtual std::unordered_map<std::type_index, std::shared_ptr<Component>>
       getAllComponentsForEntity(EntityID id) const = 0;
 
+    virtual void removeAllComponentsForEntity(EntityID id) = 0;
+
 protected:
-    virtual void* getComponentImpl(EntityID id, std::type_index type) const = 0;
-    virtual void addComponentImpl(EntityID id, std::type_index type, std::shared_ptr<Component> comp) = 0;
-    virtual void removeComponentImpl(EntityID id, std::type_index type) = 0;
+    template<typename T>
+    ComponentPool<T>& assurePool() {
+        if (auto* pool = getPool<T>())
+            return *pool;
+
+        auto pool = std::make_unique<ComponentPool<T>>();
+        auto& ref = *pool;
+        addPoolImpl(TypeIndex::get<T>(), std::move(pool));
+        return ref;
+    }
+
+    virtual IComponentPool* getPoolImpl(size_t typeIndex) const = 0;
+    virtual void addPoolImpl(size_t typeIndex, std::unique_ptr<IComponentPool> pool) = 0;
 };
 
-#endif //ICOMPONENTMANAGER_H
\ No newline at end of file
+#endif //ICOMPONENTMANAGER_H
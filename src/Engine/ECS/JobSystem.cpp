@@ -0,0 +1,173 @@
+//
+// Created by SIMEON on 10/17/2026.
+//
+
+#include "JobSystem.h"
+
+#include <algorithm>
+#include <exception>
+#include <iostream>
+
+namespace IDK
+{
+    namespace
+    {
+        constexpr size_t NotAWorker = static_cast<size_t>(-1);
+
+        thread_local const JobSystem* t_owner = nullptr;
+        thread_local size_t t_workerIndex = NotAWorker;
+
+        size_t currentWorker(const JobSystem* system) {
+            return t_owner == system ? t_workerIndex : NotAWorker;
+        }
+    }
+
+    JobSystem::JobSystem(size_t workerCount) {
+        if (workerCount == 0) {
+            const size_t hardware = std::thread::hardware_concurrency();
+            workerCount = hardware > 1 ? hardware - 1 : 0;
+        }
+
+        m_workers.reserve(workerCount);
+        for (size_t i = 0; i < workerCount; ++i)
+            m_workers.push_back(std::make_unique<Worker>());
+
+        for (size_t i = 0; i < workerCount; ++i)
+            m_workers[i]->thread = std::thread(&JobSystem::workerLoop, this, i);
+    }
+
+    JobSystem::~JobSystem() {
+        {
+            std::lock_guard lock(m_sleepMutex);
+            m_running = false;
+        }
+        m_wake.notify_all();
+
+        for (const auto& worker : m_workers) {
+            if (worker->thread.joinable())
+                worker->thread.join();
+        }
+    }
+
+    void JobSystem::submit(Job job, JobCounter& counter) {
+        counter.pending.fetch_add(1, std::memory_order_relaxed);
+
+        Job wrapped = [job = std::move(job), &counter]() {
+            try {
+                job();
+            } catch (const std::exception& e) {
+                std::cerr << "[JobSystem] Job threw: " << e.what() << std::endl;
+            } catch (...) {
+                std::cerr << "[JobSystem] Job threw an unknown exception" << std::endl;
+            }
+            counter.pending.fetch_sub(1, std::memory_order_release);
+        };
+
+        if (m_workers.empty()) {
+            wrapped();
+            return;
+        }
+
+        size_t target = currentWorker(this);
+        if (target == NotAWorker)
+            target = m_nextQueue.fetch_add(1, std::memory_order_relaxed) % m_workers.size();
+
+        m_queued.fetch_add(1, std::memory_order_release);
+        {
+            Worker& worker = *m_workers[target];
+            std::lock_guard lock(worker.mutex);
+            worker.queue.push_back(std::move(wrapped));
+        }
+
+        {
+            std::lock_guard lock(m_sleepMutex);
+        }
+        m_wake.notify_one();
+    }
+
+    void JobSystem::wait(const JobCounter& counter) {
+        const size_t self = currentWorker(this);
+        while (!counter.done()) {
+            if (!runOne(self))
+                std::this_thread::yield();
+        }
+    }
+
+    void JobSystem::parallelFor(size_t count, size_t minChunk, const RangeJob& func) {
+        if (count == 0) return;
+
+        const size_t lanes = m_workers.size() + 1;
+        const size_t chunk = std::max<size_t>(std::max<size_t>(minChunk, 1), (count + lanes * 4 - 1) / (lanes * 4));
+
+        if (chunk >= count || m_workers.empty()) {
+            func(0, count);
+            return;
+        }
+
+        JobCounter counter;
+        for (size_t begin = chunk; begin < count; begin += chunk) {
+            const size_t end = std::min(count, begin + chunk);
+            submit([&func, begin, end]() { func(begin, end); }, counter);
+        }
+
+        // The caller takes the first chunk itself, then helps drain the rest.
+        func(0, chunk);
+        wait(counter);
+    }
+
+    void JobSystem::workerLoop(size_t index) {
+        t_owner = this;
+        t_workerIndex = index;
+
+        while (m_running.load(std::memory_order_acquire)) {
+            if (runOne(index))
+                continue;
+
+            std::unique_lock lock(m_sleepMutex);
+            m_wake.wait(lock, [this]() {
+                return !m_running.load(std::memory_order_acquire) || m_queued.load(std::memory_order_acquire) > 0;
+            });
+        }
+    }
+
+    bool JobSystem::popLocal(size_t index, Job& job) {
+        Worker& worker = *m_workers[index];
+        std::lock_guard lock(worker.mutex);
+        if (worker.queue.empty()) return false;
+
+        job = std::move(worker.queue.back());
+        worker.queue.pop_back();
+        return true;
+    }
+
+    bool JobSystem::steal(size_t thief, Job& job) {
+        const size_t count = m_workers.size();
+        const size_t start = thief == NotAWorker ? 0 : thief + 1;
+
+        for (size_t i = 0; i < count; ++i) {
+            const size_t victim = (start + i) % count;
+            if (victim == thief) continue;
+
+            Worker& worker = *m_workers[victim];
+            std::lock_guard lock(worker.mutex);
+            if (worker.queue.empty()) continue;
+
+            job = std::move(worker.queue.front());
+            worker.queue.pop_front();
+            return true;
+        }
+        return false;
+    }
+
+    bool JobSystem::runOne(size_t index) {
+        if (m_workers.empty()) return false;
+
+        Job job;
+        if ((index != NotAWorker && popLocal(index, job)) || steal(index, job)) {
+            m_queued.fetch_sub(1, std::memory_order_acq_rel);
+            job();
+            return true;
+        }
+        return false;
+    }
+}
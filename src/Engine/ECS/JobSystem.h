@@ -0,0 +1,75 @@
+//
+// Created by SIMEON on 10/17/2026.
+//
+
+#ifndef JOBSYSTEM_H
+#define JOBSYSTEM_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace IDK
+{
+    // Tracks a group of submitted jobs; wait() returns once it drops to zero.
+    struct JobCounter
+    {
+        std::atomic<size_t> pending{0};
+
+        bool done() const { return pending.load(std::memory_order_acquire) == 0; }
+    };
+
+    // Persistent worker pool. Each worker owns a deque: it pushes and pops at
+    // the back, idle workers steal from the front of the others.
+    class JobSystem
+    {
+    public:
+        using Job = std::function<void()>;
+        using RangeJob = std::function<void(size_t begin, size_t end)>;
+
+        // workerCount == 0 picks hardware_concurrency() - 1 (the main thread helps out in wait()).
+        explicit JobSystem(size_t workerCount = 0);
+        ~JobSystem();
+
+        JobSystem(const JobSystem&) = delete;
+        JobSystem& operator=(const JobSystem&) = delete;
+
+        void submit(Job job, JobCounter& counter);
+
+        // Runs queued jobs on the calling thread until the counter reaches zero.
+        void wait(const JobCounter& counter);
+
+        // Splits [0, count) into chunks of at least minChunk and blocks until all ran.
+        void parallelFor(size_t count, size_t minChunk, const RangeJob& func);
+
+        size_t getWorkerCount() const { return m_workers.size(); }
+
+    private:
+        struct Worker
+        {
+            std::deque<Job> queue;
+            std::mutex mutex;
+            std::thread thread;
+        };
+
+        void workerLoop(size_t index);
+        bool popLocal(size_t index, Job& job);
+        bool steal(size_t thief, Job& job);
+        bool runOne(size_t index);
+
+        std::vector<std::unique_ptr<Worker>> m_workers;
+        std::atomic<size_t> m_queued{0};
+        std::atomic<size_t> m_nextQueue{0};
+        std::atomic<bool> m_running{true};
+        std::mutex m_sleepMutex;
+        std::condition_variable m_wake;
+    };
+}
+
+#endif //JOBSYSTEM_H
@@ -7,6 +7,7 @@
 
 #include "ComponentManager.h"
 #include "Entity.h"
+#include "View.h"
 #include <unordered_map>
 #include <memory>
 
@@ -26,9 +27,20 @@ public:
     }
 
     void destroyEntity(EntityID id) {
+        m_componentManager->removeAllComponentsForEntity(id);
         m_entities.erase(id);
     }
 
+    std::shared_ptr<Entity> getEntity(EntityID id) const {
+        auto it = m_entities.find(id);
+        return it != m_entities.end() ? it->second : nullptr;
+    }
+
+    template<typename... Ts>
+    View<Ts...> view() const {
+        return View<Ts...>(m_componentManager->getPool<Ts>()...);
+    }
+
     IComponentManager* getComponentManager() const {
         return m_componentManager.get();
     }
@@ -5,6 +5,8 @@
 #ifndef TYPEINDEX_H
 #define TYPEINDEX_H
 
+#include <atomic>
+#include <cstddef>
 #include <typeindex>
 #include <unordered_map>
 
@@ -0,0 +1,73 @@
+//
+// Created by SIMEON on 10/17/2026.
+//
+
+#ifndef VIEW_H
+#define VIEW_H
+
+#include <tuple>
+#include <type_traits>
+#include "ComponentPool.h"
+
+// Iterates the entities that own every component in Ts..., driven by the
+// smallest pool. Components are handed out by reference straight from the
+// dense pool storage. Adding or removing Ts components while iterating is
+// not supported.
+template<typename... Ts>
+class View {
+    static_assert(sizeof...(Ts) > 0, "View needs at least one component type");
+
+public:
+    explicit View(ComponentPool<Ts>*... pools) : m_pools(pools...) {}
+
+    bool contains(EntityID id) const {
+        return valid() && (std::get<ComponentPool<Ts>*>(m_pools)->contains(id) && ...);
+    }
+
+    template<typename T>
+    T& get(EntityID id) const {
+        return *std::get<ComponentPool<T>*>(m_pools)->get(id);
+    }
+
+    // Upper bound on the number of matches.
+    size_t sizeHint() const {
+        const IComponentPool* lead = leadPool();
+        return lead ? lead->size() : 0;
+    }
+
+    // func(EntityID, Ts&...) or func(Ts&...)
+    template<typename F>
+    void each(F&& func) const {
+        const IComponentPool* lead = leadPool();
+        if (!lead) return;
+
+        for (const EntityID id : lead->entities()) {
+            if (!(std::get<ComponentPool<Ts>*>(m_pools)->contains(id) && ...))
+                continue;
+
+            if constexpr (std::is_invocable_v<F, EntityID, Ts&...>) {
+                func(id, *std::get<ComponentPool<Ts>*>(m_pools)->get(id)...);
+            } else {
+                func(*std::get<ComponentPool<Ts>*>(m_pools)->get(id)...);
+            }
+        }
+    }
+
+private:
+    bool valid() const {
+        return ((std::get<ComponentPool<Ts>*>(m_pools) != nullptr) && ...);
+    }
+
+    const IComponentPool* leadPool() const {
+        if (!valid()) return nullptr;
+
+        const IComponentPool* lead = nullptr;
+        ((lead = !lead || std::get<ComponentPool<Ts>*>(m_pools)->size() < lead->size()
+            ? std::get<ComponentPool<Ts>*>(m_pools) : lead), ...);
+        return lead;
+    }
+
+    std::tuple<ComponentPool<Ts>*...> m_pools;
+};
+
+#endif //VIEW_H
@@ -25,25 +25,25 @@ public:
 
     }
 
-    void setUniforms(unsigned int shaderProgram) const override {
+    void setUniforms(const IDK::Graphics::Shader& shader) const override {
         if (!isInitialized()) {
             std::cerr << "DirectionalLight is not initialized. Cannot set uniforms." << std::endl;
             return;
         }
-        GLint dirLoc = glGetUniformLocation(shaderProgram, "dirLight.direction");
-        GLint ambLoc = glGetUniformLocation(shaderProgram, "dirLight.ambient");
-        GLint diffLoc = glGetUniformLocation(shaderProgram, "dirLight.diffuse");
-        GLint specLoc = glGetUniformLocation(shaderProgram, "dirLight.specular");
-
-        if (dirLoc == -1) std::cerr << "Uniform 'dirLight.direction' not found!" << std::endl;
-        if (ambLoc == -1) std::cerr << "Uniform 'dirLight.ambient' not found!" << std::endl;
-        if (diffLoc == -1) std::cerr << "Uniform 'dirLight.diffuse' not found!" << std::endl;
-        if (specLoc == -1) std::cerr << "Uniform 'dirLight.specular' not found!" << std::endl;
-
-        if (dirLoc != -1) glUniform3fv(dirLoc, 1, glm::value_ptr(direction));
-        if (ambLoc != -1) glUniform3fv(ambLoc, 1, glm::value_ptr(ambient));
-        if (diffLoc != -1) glUniform3fv(diffLoc, 1, glm::value_ptr(diffuse));
-        if (specLoc != -1) glUniform3fv(specLoc, 1, glm::value_ptr(specular));
+        static const IDK::Graphics::UniformHandle dirUniform("dirLight.direction");
+        static const IDK::Graphics::UniformHandle ambUniform("dirLight.ambient");
+        static const IDK::Graphics::UniformHandle diffUniform("dirLight.diffuse");
+        static const IDK::Graphics::UniformHandle specUniform("dirLight.specular");
+
+        if (!shader.hasUniform(dirUniform)) std::cerr << "Uniform 'dirLight.direction' not found!" << std::endl;
+        if (!shader.hasUniform(ambUniform)) std::cerr << "Uniform 'dirLight.ambient' not found!" << std::endl;
+        if (!shader.hasUniform(diffUniform)) std::cerr << "Uniform 'dirLight.diffuse' not found!" << std::endl;
+        if (!shader.hasUniform(specUniform)) std::cerr << "Uniform 'dirLight.specular' not found!" << std::endl;
+
+        shader.setVec3(dirUniform, direction);
+        shader.setVec3(ambUniform, ambient);
+        shader.setVec3(diffUniform, diffuse);
+        shader.setVec3(specUniform, specular);
 
 
         /*
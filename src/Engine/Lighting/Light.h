@@ -7,6 +7,7 @@
 
 #include "Transform.h"
 #include "../ECS/Component.h"
+#include "Shader.h"
 #include <unordered_map>
 #include <memory>
 #include <string>
@@ -19,8 +20,6 @@ namespace IDK::Graphics
     public:
         Light(const std::string& name)
             : name(name) {
-            std::cerr << "LIGHT()" << std::endl;
-
             transform = std::make_shared<Transform>();
             addComponent(transform);
         }
@@ -36,7 +35,7 @@ namespace IDK::Graphics
             }
         }
 
-        virtual void setUniforms(unsigned int shaderProgram) const = 0;
+        virtual void setUniforms(const Shader& shader) const = 0;
         virtual void updateDirectionFromRotation() {}
 
         std::shared_ptr<Transform> transform;
@@ -0,0 +1,267 @@
+//
+// Created by SIMEON on 10/17/2026.
+//
+
+#include "LightClusterer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "JobSystem.h"
+
+#if defined(__AVX__)
+    #include <immintrin.h>
+    #define IDK_CLUSTER_AVX 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define IDK_CLUSTER_SSE 1
+#endif
+
+// The vector loops in binSlice() cover a whole slice, leaving no scalar remainder.
+static_assert(IDK::Graphics::LightClusterer::ClustersPerSlice % 8 == 0,
+              "binSlice() needs ClustersPerSlice to be a multiple of the AVX width");
+
+namespace IDK::Graphics
+{
+    namespace
+    {
+        constexpr float PointLightCosOuter = -2.0f; // below any cosine, so never attenuated by the cone
+    }
+
+    void LightClusterer::clear() {
+        m_lights.clear();
+        m_bounds.clear();
+    }
+
+    void LightClusterer::reserve(size_t count) {
+        m_lights.reserve(count);
+        m_bounds.reserve(count);
+    }
+
+    uint32_t LightClusterer::addPointLight(const glm::vec3& position, float range, const glm::vec3& color, float intensity) {
+        m_lights.push_back({glm::vec4(position, range), glm::vec4(color, intensity),
+                            glm::vec4(0.0f, 0.0f, -1.0f, PointLightCosOuter), glm::vec4(1.0f, 0.0f, 0.0f, 0.0f)});
+        m_bounds.push_back({position, range});
+        return static_cast<uint32_t>(m_lights.size() - 1);
+    }
+
+    uint32_t LightClusterer::addSpotLight(const glm::vec3& position, const glm::vec3& direction, float range,
+                                          float innerAngle, float outerAngle, const glm::vec3& color, float intensity) {
+        const glm::vec3 axis = glm::normalize(direction);
+        const float cosOuter = std::cos(outerAngle);
+        const float cosInner = std::max(std::cos(innerAngle), cosOuter + 1e-4f);
+
+        m_lights.push_back({glm::vec4(position, range), glm::vec4(color, intensity),
+                            glm::vec4(axis, cosOuter), glm::vec4(1.0f / (cosInner - cosOuter), 0.0f, 0.0f, 0.0f)});
+
+        // Smallest sphere around the cone and its spherical cap: wide cones are
+        // bounded by their base circle, narrow ones by a sphere through the apex.
+        if (outerAngle > glm::radians(45.0f)) {
+            m_bounds.push_back({position + axis * (range * cosOuter), range * std::sin(outerAngle)});
+        } else {
+            const float radius = range / (2.0f * cosOuter);
+            m_bounds.push_back({position + axis * radius, radius});
+        }
+        return static_cast<uint32_t>(m_lights.size() - 1);
+    }
+
+    // Cluster boxes only depend on the projection, so they are rebuilt when it changes.
+    void LightClusterer::updateClusterBounds(const glm::mat4& projection) {
+        if (projection == m_boundsProjection && !m_minX.empty()) return;
+        m_boundsProjection = projection;
+
+        // Standard OpenGL perspective: near and far come back out of the depth terms.
+        const float nearPlane = projection[3][2] / (projection[2][2] - 1.0f);
+        const float farPlane = projection[3][2] / (projection[2][2] + 1.0f);
+
+        const float slices = static_cast<float>(GridZ);
+        const float logRatio = std::log(farPlane / nearPlane);
+        m_header.size = glm::uvec4(GridX, GridY, GridZ, 0);
+        m_header.slicing = glm::vec4(slices / logRatio, -slices * std::log(nearPlane) / logRatio, nearPlane, farPlane);
+
+        for (uint32_t k = 0; k <= GridZ; ++k)
+            m_sliceDepth[k] = nearPlane * std::pow(farPlane / nearPlane, static_cast<float>(k) / GridZ);
+
+        m_minX.resize(ClusterCount);
+        m_maxX.resize(ClusterCount);
+        m_minY.resize(ClusterCount);
+        m_maxY.resize(ClusterCount);
+
+        // At view depth d, NDC x maps to view x = d * (ndc + P[2][0]) / P[0][0]; y likewise.
+        const auto viewX = [&](float ndc, float depth) { return depth * (ndc + projection[2][0]) / projection[0][0]; };
+        const auto viewY = [&](float ndc, float depth) { return depth * (ndc + projection[2][1]) / projection[1][1]; };
+
+        for (uint32_t k = 0; k < GridZ; ++k) {
+            const float depths[2] = {m_sliceDepth[k], m_sliceDepth[k + 1]};
+            for (uint32_t j = 0; j < GridY; ++j) {
+                const float ndcY0 = -1.0f + 2.0f * static_cast<float>(j) / GridY;
+                const float ndcY1 = -1.0f + 2.0f * static_cast<float>(j + 1) / GridY;
+                for (uint32_t i = 0; i < GridX; ++i) {
+                    const float ndcX0 = -1.0f + 2.0f * static_cast<float>(i) / GridX;
+                    const float ndcX1 = -1.0f + 2.0f * static_cast<float>(i + 1) / GridX;
+
+                    const size_t cluster = k * ClustersPerSlice + j * GridX + i;
+                    m_minX[cluster] = m_minY[cluster] = std::numeric_limits<float>::max();
+                    m_maxX[cluster] = m_maxY[cluster] = std::numeric_limits<float>::lowest();
+                    for (const float depth : depths) {
+                        for (const float x : {viewX(ndcX0, depth), viewX(ndcX1, depth)}) {
+                            m_minX[cluster] = std::min(m_minX[cluster], x);
+                            m_maxX[cluster] = std::max(m_maxX[cluster], x);
+                        }
+                        for (const float y : {viewY(ndcY0, depth), viewY(ndcY1, depth)}) {
+                            m_minY[cluster] = std::min(m_minY[cluster], y);
+                            m_maxY[cluster] = std::max(m_maxY[cluster], y);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    void LightClusterer::build(const glm::mat4& view, const glm::mat4& projection, JobSystem* jobs) {
+        updateClusterBounds(projection);
+
+        const size_t lightCount = m_lights.size();
+        m_viewX.resize(lightCount);
+        m_viewY.resize(lightCount);
+        m_depth.resize(lightCount);
+        m_radius.resize(lightCount);
+        for (std::vector<uint32_t>& lights : m_sliceLights)
+            lights.clear();
+
+        // Spheres into view space, and each light into the slices its depth range reaches.
+        const float nearPlane = m_sliceDepth[0];
+        const float farPlane = m_sliceDepth[GridZ];
+        for (size_t l = 0; l < lightCount; ++l) {
+            const glm::vec3 center = glm::vec3(view * glm::vec4(m_bounds[l].center, 1.0f));
+            const float radius = m_bounds[l].radius;
+            m_viewX[l] = center.x;
+            m_viewY[l] = center.y;
+            m_depth[l] = -center.z;
+            m_radius[l] = radius;
+
+            const float front = m_depth[l] - radius;
+            const float back = m_depth[l] + radius;
+            if (back < nearPlane || front > farPlane) continue;
+
+            const auto sliceOf = [&](float depth) {
+                const float slice = std::floor(std::log(std::max(depth, nearPlane)) * m_header.slicing.x + m_header.slicing.y);
+                return static_cast<uint32_t>(std::clamp(slice, 0.0f, static_cast<float>(GridZ - 1)));
+            };
+            for (uint32_t k = sliceOf(front), last = sliceOf(back); k <= last; ++k)
+                m_sliceLights[k].push_back(static_cast<uint32_t>(l));
+        }
+
+        m_clusterCounts.assign(ClusterCount, 0);
+        m_clusterLists.resize(static_cast<size_t>(ClusterCount) * MaxLightsPerCluster);
+
+        if (jobs) {
+            jobs->parallelFor(GridZ, 1, [this](size_t begin, size_t end) {
+                for (size_t k = begin; k < end; ++k)
+                    binSlice(static_cast<uint32_t>(k));
+            });
+        } else {
+            for (uint32_t k = 0; k < GridZ; ++k)
+                binSlice(k);
+        }
+
+        // Compact the fixed-capacity lists into one index list.
+        m_clusters.resize(ClusterCount);
+        m_lightIndices.clear();
+        for (uint32_t c = 0; c < ClusterCount; ++c) {
+            const uint32_t count = m_clusterCounts[c];
+            const uint32_t* list = m_clusterLists.data() + static_cast<size_t>(c) * MaxLightsPerCluster;
+            m_clusters[c] = glm::uvec2(static_cast<uint32_t>(m_lightIndices.size()), count);
+            m_lightIndices.insert(m_lightIndices.end(), list, list + count);
+        }
+
+        m_header.size.w = static_cast<uint32_t>(lightCount);
+        m_stats.lights = lightCount;
+        m_stats.references = m_lightIndices.size();
+        m_stats.overflowed = 0;
+        for (const size_t overflow : m_sliceOverflow)
+            m_stats.overflowed += overflow;
+    }
+
+    // Sphere vs. box per cluster of one slice. The depth term is the same for
+    // every cluster in the slice, so the kernel only measures x and y.
+    void LightClusterer::binSlice(uint32_t slice) {
+        const size_t base = static_cast<size_t>(slice) * ClustersPerSlice;
+        const float* minX = m_minX.data() + base;
+        const float* maxX = m_maxX.data() + base;
+        const float* minY = m_minY.data() + base;
+        const float* maxY = m_maxY.data() + base;
+        uint32_t* counts = m_clusterCounts.data() + base;
+        uint32_t* lists = m_clusterLists.data() + base * MaxLightsPerCluster;
+
+        const float sliceNear = m_sliceDepth[slice];
+        const float sliceFar = m_sliceDepth[slice + 1];
+        size_t overflow = 0;
+
+        const auto append = [&](size_t cluster, uint32_t light) {
+            if (counts[cluster] < MaxLightsPerCluster)
+                lists[cluster * MaxLightsPerCluster + counts[cluster]++] = light;
+            else
+                ++overflow;
+        };
+
+        for (const uint32_t light : m_sliceLights[slice]) {
+            const float depth = m_depth[light];
+            const float dz = std::max(std::max(sliceNear - depth, depth - sliceFar), 0.0f);
+            const float remaining = m_radius[light] * m_radius[light] - dz * dz;
+            if (remaining < 0.0f) continue;
+
+            const float cx = m_viewX[light];
+            const float cy = m_viewY[light];
+            size_t c = 0;
+
+#if defined(IDK_CLUSTER_AVX)
+            const __m256 zero = _mm256_setzero_ps();
+            const __m256 x = _mm256_set1_ps(cx);
+            const __m256 y = _mm256_set1_ps(cy);
+            const __m256 limit = _mm256_set1_ps(remaining);
+            for (; c + 8 <= ClustersPerSlice; c += 8) {
+                const __m256 dx = _mm256_max_ps(_mm256_max_ps(_mm256_sub_ps(_mm256_loadu_ps(minX + c), x),
+                                                              _mm256_sub_ps(x, _mm256_loadu_ps(maxX + c))), zero);
+                const __m256 dy = _mm256_max_ps(_mm256_max_ps(_mm256_sub_ps(_mm256_loadu_ps(minY + c), y),
+                                                              _mm256_sub_ps(y, _mm256_loadu_ps(maxY + c))), zero);
+                const __m256 distance = _mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy));
+
+                const int mask = _mm256_movemask_ps(_mm256_cmp_ps(distance, limit, _CMP_LE_OQ));
+                for (int lane = 0; mask && lane < 8; ++lane) {
+                    if ((mask >> lane) & 1)
+                        append(c + lane, light);
+                }
+            }
+#elif defined(IDK_CLUSTER_SSE)
+            const __m128 zero = _mm_setzero_ps();
+            const __m128 x = _mm_set1_ps(cx);
+            const __m128 y = _mm_set1_ps(cy);
+            const __m128 limit = _mm_set1_ps(remaining);
+            for (; c + 4 <= ClustersPerSlice; c += 4) {
+                const __m128 dx = _mm_max_ps(_mm_max_ps(_mm_sub_ps(_mm_loadu_ps(minX + c), x),
+                                                        _mm_sub_ps(x, _mm_loadu_ps(maxX + c))), zero);
+                const __m128 dy = _mm_max_ps(_mm_max_ps(_mm_sub_ps(_mm_loadu_ps(minY + c), y),
+                                                        _mm_sub_ps(y, _mm_loadu_ps(maxY + c))), zero);
+                const __m128 distance = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+
+                const int mask = _mm_movemask_ps(_mm_cmple_ps(distance, limit));
+                for (int lane = 0; mask && lane < 4; ++lane) {
+                    if ((mask >> lane) & 1)
+                        append(c + lane, light);
+                }
+            }
+#else
+            for (; c < ClustersPerSlice; ++c) {
+                const float dx = std::max(std::max(minX[c] - cx, cx - maxX[c]), 0.0f);
+                const float dy = std::max(std::max(minY[c] - cy, cy - maxY[c]), 0.0f);
+                if (dx * dx + dy * dy <= remaining)
+                    append(c, light);
+            }
+#endif
+        }
+
+        m_sliceOverflow[slice] = overflow;
+    }
+}
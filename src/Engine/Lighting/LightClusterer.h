@@ -0,0 +1,111 @@
+//
+// Created by SIMEON on 10/17/2026.
+//
+
+#ifndef LIGHTCLUSTERER_H
+#define LIGHTCLUSTERER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "glm.hpp"
+
+namespace IDK
+{
+    class JobSystem;
+}
+
+namespace IDK::Graphics
+{
+    // One light as lightShader.frag reads it (std430). World space.
+    struct ClusterLight {
+        glm::vec4 positionRange;      // xyz position, w range
+        glm::vec4 colorIntensity;     // rgb color, a intensity
+        glm::vec4 directionCosOuter;  // xyz spot direction, w cos(outer angle); -2 for point lights
+        glm::vec4 spotScale;          // x 1 / (cos(inner) - cos(outer))
+    };
+
+    // Header of the cluster grid buffer, followed by one (offset, count)
+    // pair per cluster into the light index list.
+    struct ClusterGridHeader {
+        glm::uvec4 size;    // x, y, z cluster counts, w light count
+        glm::vec4 slicing;  // slice = floor(log(depth) * x + y)
+    };
+
+    struct LightClusterStats {
+        size_t lights = 0;
+        size_t references = 0;  // light indices over all clusters
+        size_t overflowed = 0;  // references dropped from full clusters
+    };
+
+    // Assigns lights to a froxel grid: screen tiles split into slices that
+    // grow exponentially with view depth. Each light's bounding sphere is
+    // tested against the view-space boxes of every cluster in the slices it
+    // reaches, 8 clusters per instruction with AVX, 4 with SSE. Slices are
+    // independent and run in parallel on the job system.
+    class LightClusterer
+    {
+    public:
+        static constexpr uint32_t GridX = 16;
+        static constexpr uint32_t GridY = 9;
+        static constexpr uint32_t GridZ = 24;
+        static constexpr uint32_t ClustersPerSlice = GridX * GridY;
+        static constexpr uint32_t ClusterCount = ClustersPerSlice * GridZ;
+        static constexpr uint32_t MaxLightsPerCluster = 256;
+
+        void clear();
+        void reserve(size_t count);
+
+        uint32_t addPointLight(const glm::vec3& position, float range, const glm::vec3& color, float intensity);
+        uint32_t addSpotLight(const glm::vec3& position, const glm::vec3& direction, float range,
+                              float innerAngle, float outerAngle, const glm::vec3& color, float intensity);
+        size_t size() const { return m_lights.size(); }
+
+        // Bins the added lights for a perspective projection. Without a job
+        // system the slices are binned on the calling thread.
+        void build(const glm::mat4& view, const glm::mat4& projection, JobSystem* jobs = nullptr);
+
+        const std::vector<ClusterLight>& getLights() const { return m_lights; }
+        const ClusterGridHeader& getHeader() const { return m_header; }
+        const std::vector<glm::uvec2>& getClusters() const { return m_clusters; }
+        const std::vector<uint32_t>& getLightIndices() const { return m_lightIndices; }
+        const LightClusterStats& getStats() const { return m_stats; }
+
+    private:
+        // Sphere enclosing the light's volume; for spots, the cone's.
+        struct Bounds {
+            glm::vec3 center;
+            float radius;
+        };
+
+        void updateClusterBounds(const glm::mat4& projection);
+        void binSlice(uint32_t slice);
+
+        std::vector<ClusterLight> m_lights;
+        std::vector<Bounds> m_bounds;
+
+        // Per light, view-space sphere, filled by build().
+        std::vector<float> m_viewX, m_viewY, m_depth, m_radius;
+
+        // Lights reaching each slice.
+        std::vector<uint32_t> m_sliceLights[GridZ];
+
+        // View-space cluster boxes, one SoA run of ClustersPerSlice per slice.
+        // All clusters in a slice share its depth range.
+        std::vector<float> m_minX, m_maxX, m_minY, m_maxY;
+        float m_sliceDepth[GridZ + 1] = {};
+        glm::mat4 m_boundsProjection{0.0f};
+
+        // Fixed-capacity lists filled in parallel, compacted afterwards.
+        std::vector<uint32_t> m_clusterLists;
+        std::vector<uint32_t> m_clusterCounts;
+        size_t m_sliceOverflow[GridZ] = {};
+
+        ClusterGridHeader m_header{};
+        std::vector<glm::uvec2> m_clusters;
+        std::vector<uint32_t> m_lightIndices;
+        LightClusterStats m_stats;
+    };
+}
+
+#endif //LIGHTCLUSTERER_H
@@ -9,6 +9,8 @@
 #include <vector>
 
 #include "DirectionalLight.h"
+#include "PointLight.h"
+#include "SpotLight.h"
 
 class LightManager {
 public:
@@ -25,12 +27,36 @@ public:
         return directionalLights;
     }
 
+    void addPointLight(const std::shared_ptr<PointLight>& light) {
+        if (!light || !light->isInitialized()) {
+            throw std::invalid_argument("Attempted to add an uninitialized PointLight.");
+        }
+        pointLights.push_back(light);
+    }
+
+    const std::vector<std::shared_ptr<PointLight>>& getPointLights() const {
+        return pointLights;
+    }
+
+    void addSpotLight(const std::shared_ptr<SpotLight>& light) {
+        if (!light || !light->isInitialized()) {
+            throw std::invalid_argument("Attempted to add an uninitialized SpotLight.");
+        }
+        spotLights.push_back(light);
+    }
+
+    const std::vector<std::shared_ptr<SpotLight>>& getSpotLights() const {
+        return spotLights;
+    }
+
     std::string getName() const {
         return name;
     }
 
 private:
     std::vector<std::shared_ptr<DirectionalLight>> directionalLights;
+    std::vector<std::shared_ptr<PointLight>> pointLights;
+    std::vector<std::shared_ptr<SpotLight>> spotLights;
     std::string name;
 
 };
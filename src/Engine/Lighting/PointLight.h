@@ -0,0 +1,37 @@
+//
+// Created by SIMEON on 10/17/2026.
+//
+
+#ifndef POINTLIGHT_H
+#define POINTLIGHT_H
+
+#include "glm.hpp"
+#include "Light.h"
+
+// Omni light with a finite range. Point and spot lights are not set as
+// uniforms one by one; the deferred lighting pass bins them into clusters
+// and uploads them all at once.
+class PointLight : public IDK::Graphics::Light {
+public:
+    glm::vec3 color;
+    float intensity;
+    float range;
+
+    PointLight(const std::string& name, const glm::vec3& position, const glm::vec3& color,
+               float intensity, float range)
+        : Light(name), color(color), intensity(intensity), range(range) {
+        setPosition(position);
+    }
+
+    void setUniforms(const IDK::Graphics::Shader&) const override {}
+
+    void setColor(const glm::vec3& value) { color = value; }
+    void setIntensity(float value) { intensity = value; }
+    void setRange(float value) { range = value; }
+
+    const glm::vec3& getColor() const { return color; }
+    float getIntensity() const { return intensity; }
+    float getRange() const { return range; }
+};
+
+#endif //POINTLIGHT_H
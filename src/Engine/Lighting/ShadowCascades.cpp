@@ -0,0 +1,95 @@
+//
+// Created by SIMEON on 10/17/2026.
+//
+
+#include "ShadowCascades.h"
+
+#include <algorithm>
+#include <cmath>
+#include "gtc/matrix_transform.hpp"
+
+namespace IDK::Graphics
+{
+    void ShadowCascades::ComputeSplits(float nearPlane, float farPlane, uint32_t count, float lambda, float* splits) {
+        splits[0] = nearPlane;
+        for (uint32_t i = 1; i < count; ++i) {
+            const float t = static_cast<float>(i) / static_cast<float>(count);
+            const float logarithmic = nearPlane * std::pow(farPlane / nearPlane, t);
+            const float uniform = nearPlane + (farPlane - nearPlane) * t;
+            splits[i] = lambda * logarithmic + (1.0f - lambda) * uniform;
+        }
+        splits[count] = farPlane;
+    }
+
+    // Slice corners lie sqrt(k2) * depth off the view axis. The center is where
+    // near and far corners are equally far away; when that falls past the far
+    // plane (wide, thin slices) the far corners alone decide the sphere.
+    void ShadowCascades::SliceBoundingSphere(float sliceNear, float sliceFar, float tanHalfFovY, float aspect,
+                                             float& centerDepth, float& radius) {
+        const float tanHalfFovX = tanHalfFovY * aspect;
+        const float k2 = tanHalfFovX * tanHalfFovX + tanHalfFovY * tanHalfFovY;
+
+        centerDepth = 0.5f * (sliceNear + sliceFar) * (1.0f + k2);
+        if (centerDepth >= sliceFar) {
+            centerDepth = sliceFar;
+            radius = sliceFar * std::sqrt(k2);
+        } else {
+            const float toFar = sliceFar - centerDepth;
+            radius = std::sqrt(toFar * toFar + sliceFar * sliceFar * k2);
+        }
+    }
+
+    void ShadowCascades::fit(const glm::mat4& cameraView, float fovY, float aspect, float nearPlane, float farPlane,
+                             const glm::vec3& lightDirection) {
+        m_cascadeCount = std::clamp(m_settings.cascadeCount, 1u, MaxCascades);
+
+        float splits[MaxCascades + 1];
+        ComputeSplits(nearPlane, std::min(farPlane, m_settings.maxDistance), m_cascadeCount, m_settings.splitLambda, splits);
+
+        const glm::mat4 cameraWorld = glm::inverse(cameraView);
+        const glm::vec3 eye(cameraWorld[3]);
+        const glm::vec3 forward = -glm::vec3(cameraWorld[2]);
+        const float tanHalfFovY = std::tan(0.5f * fovY);
+
+        // One light-space orientation for every cascade; only the origin moves.
+        const glm::vec3 direction = glm::normalize(lightDirection);
+        const glm::vec3 up = std::abs(direction.y) > 0.99f ? glm::vec3(0.0f, 0.0f, 1.0f) : glm::vec3(0.0f, 1.0f, 0.0f);
+        const glm::mat4 lightRotation = glm::lookAt(glm::vec3(0.0f), direction, up);
+        const float resolution = static_cast<float>(std::max(m_settings.resolution, 1u));
+
+        for (uint32_t c = 0; c < m_cascadeCount; ++c) {
+            ShadowCascade& cascade = m_cascades[c];
+            cascade.splitNear = splits[c];
+            cascade.splitFar = splits[c + 1];
+
+            float centerDepth, radius;
+            SliceBoundingSphere(cascade.splitNear, cascade.splitFar, tanHalfFovY, aspect, centerDepth, radius);
+
+            // Rounded up so float noise between frames cannot change the texel size.
+            radius = std::ceil(radius * 16.0f) / 16.0f;
+            const float texelSize = 2.0f * radius / resolution;
+
+            glm::vec3 center = glm::vec3(lightRotation * glm::vec4(eye + forward * centerDepth, 1.0f));
+            center.x = std::floor(center.x / texelSize) * texelSize;
+            center.y = std::floor(center.y / texelSize) * texelSize;
+
+            cascade.radius = radius;
+            cascade.texelSize = texelSize;
+            cascade.view = glm::translate(glm::mat4(1.0f), -center) * lightRotation;
+            // The near plane is pulled back toward the light so casters outside
+            // the slice still land in the depth range.
+            cascade.projection = glm::ortho(-radius, radius, -radius, radius,
+                                            -(radius + m_settings.casterDistance), radius);
+            cascade.viewProjection = cascade.projection * cascade.view;
+        }
+    }
+
+    void ShadowCascades::cullCasters(const FrustumCuller& culler, std::vector<uint8_t> (&visible)[MaxCascades]) const {
+        for (uint32_t c = 0; c < MaxCascades; ++c) {
+            if (c < m_cascadeCount)
+                culler.classify(Frustum::FromMatrix(m_cascades[c].viewProjection), visible[c]);
+            else
+                visible[c].clear();
+        }
+    }
+}
@@ -0,0 +1,80 @@
+//
+// Created by SIMEON on 10/17/2026.
+//
+
+#ifndef SHADOWCASCADES_H
+#define SHADOWCASCADES_H
+
+#include <cstdint>
+#include <vector>
+#include "glm.hpp"
+#include "FrustumCulling.h"
+
+namespace IDK::Graphics
+{
+    struct ShadowCascade {
+        glm::mat4 view{1.0f};
+        glm::mat4 projection{1.0f};
+        glm::mat4 viewProjection{1.0f};
+        float splitNear = 0.0f;   // view depth range covered
+        float splitFar = 0.0f;
+        float radius = 0.0f;      // of the bounding sphere the projection is fit to
+        float texelSize = 0.0f;   // world units per shadow map texel
+    };
+
+    // Cascaded shadow maps for one directional light. Pure CPU work: picks the
+    // split depths, fits an orthographic projection per cascade and decides
+    // which objects each cascade has to draw.
+    //
+    // Fitting is stable: each cascade covers the bounding sphere of its slice
+    // of the camera frustum, whose radius depends only on the projection, so it
+    // does not change as the camera turns; and the sphere center is snapped to
+    // whole texels in light space, so moving the camera shifts the shadow map
+    // contents by whole texels and edges do not shimmer.
+    class ShadowCascades
+    {
+    public:
+        static constexpr uint32_t MaxCascades = 4;
+
+        struct Settings {
+            uint32_t cascadeCount = 4;
+            uint32_t resolution = 2048;
+            float maxDistance = 150.0f;     // shadows end here or at the camera far plane
+            float splitLambda = 0.75f;      // 0 uniform splits, 1 logarithmic
+            float casterDistance = 100.0f;  // how far toward the light casters are kept
+        };
+
+        ShadowCascades() = default;
+        explicit ShadowCascades(const Settings& settings) : m_settings(settings) {}
+
+        const Settings& getSettings() const { return m_settings; }
+
+        // Practical split scheme: a lambda blend of logarithmic and uniform
+        // splits. Writes count + 1 depths, from nearPlane to farPlane.
+        static void ComputeSplits(float nearPlane, float farPlane, uint32_t count, float lambda, float* splits);
+
+        // Center (on the view axis, as a view depth) and radius of the
+        // smallest sphere around the frustum slice between the two depths.
+        static void SliceBoundingSphere(float sliceNear, float sliceFar, float tanHalfFovY, float aspect,
+                                        float& centerDepth, float& radius);
+
+        // fovY in radians. lightDirection points from the light into the scene.
+        void fit(const glm::mat4& cameraView, float fovY, float aspect, float nearPlane, float farPlane,
+                 const glm::vec3& lightDirection);
+
+        // Caster culling: visible[c][i] becomes 1 for every box i of culler
+        // that can cast into cascade c, including boxes between the cascade
+        // and the light. Does not add to the camera culling stats.
+        void cullCasters(const FrustumCuller& culler, std::vector<uint8_t> (&visible)[MaxCascades]) const;
+
+        uint32_t getCascadeCount() const { return m_cascadeCount; }
+        const ShadowCascade& getCascade(uint32_t index) const { return m_cascades[index]; }
+
+    private:
+        Settings m_settings;
+        ShadowCascade m_cascades[MaxCascades];
+        uint32_t m_cascadeCount = 0;
+    };
+}
+
+#endif //SHADOWCASCADES_H
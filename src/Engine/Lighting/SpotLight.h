@@ -0,0 +1,50 @@
+//
+// Created by SIMEON on 10/17/2026.
+//
+
+#ifndef SPOTLIGHT_H
+#define SPOTLIGHT_H
+
+#include "glm.hpp"
+#include "Light.h"
+
+// Cone light: full intensity inside innerAngle, fading to nothing at
+// outerAngle (half angles, radians). Clustered like PointLight.
+class SpotLight : public IDK::Graphics::Light {
+public:
+    glm::vec3 direction;
+    glm::vec3 color;
+    float intensity;
+    float range;
+    float innerAngle;
+    float outerAngle;
+
+    SpotLight(const std::string& name, const glm::vec3& position, const glm::vec3& dir, const glm::vec3& color,
+              float intensity, float range, float innerAngle, float outerAngle)
+        : Light(name), direction(glm::normalize(dir)), color(color), intensity(intensity), range(range),
+          innerAngle(innerAngle), outerAngle(outerAngle) {
+        setPosition(position);
+    }
+
+    void setUniforms(const IDK::Graphics::Shader&) const override {}
+
+    void updateDirectionFromRotation() override {
+        if (transform)
+            direction = glm::vec3(transform->getRotationMatrix() * glm::vec4(0.0f, 0.0f, -1.0f, 0.0f));
+    }
+
+    void setDirection(const glm::vec3& dir) { direction = glm::normalize(dir); }
+    void setColor(const glm::vec3& value) { color = value; }
+    void setIntensity(float value) { intensity = value; }
+    void setRange(float value) { range = value; }
+    void setAngles(float inner, float outer) { innerAngle = inner; outerAngle = outer; }
+
+    const glm::vec3& getDirection() const { return direction; }
+    const glm::vec3& getColor() const { return color; }
+    float getIntensity() const { return intensity; }
+    float getRange() const { return range; }
+    float getInnerAngle() const { return innerAngle; }
+    float getOuterAngle() const { return outerAngle; }
+};
+
+#endif //SPOTLIGHT_H
@@ -9,6 +9,7 @@
 #include "Ray.h"
 #include "gtx/string_cast.hpp"
 #include "glad/glad.h"
+#include "GLStateCache.h"
 
 class BoxCollider final : public Collider {
 public:
@@ -43,62 +44,41 @@ public:
     glm::vec3 m_position;
     glm::mat4 m_modelMatrix;
 
-    bool intersectsRay(const Ray& ray, const glm::mat4& transformMatrix, float distance) override {
-        glm::mat4 invTransform = glm::inverse(transformMatrix);
+    bool intersectsLocalRay(const glm::vec3& origin, const glm::vec3& direction,
+                            float maxDistance, float& hitDistance) const override {
+        // Slab test; axis-parallel rays divide to +-inf and fall out of the min/max.
+        const glm::vec3 invDir = 1.0f / direction;
+        const glm::vec3 t0s = (m_worldMin - origin) * invDir;
+        const glm::vec3 t1s = (m_worldMax - origin) * invDir;
 
-        glm::vec3 rayOriginLocal = glm::vec3(invTransform * glm::vec4(ray.getOrigin(), 1.0f));
-        glm::vec3 rayDirectionLocal = glm::normalize(glm::vec3(invTransform * glm::vec4(ray.getDirection(), 0.0f))); // Normalize here!
+        const glm::vec3 tmin = glm::min(t0s, t1s);
+        const glm::vec3 tmax = glm::max(t0s, t1s);
 
-        glm::vec3 rayDirectionWorld = glm::vec3(transformMatrix * glm::vec4(rayDirectionLocal, 0.0f));
-        if (glm::dot(rayDirectionWorld, m_worldMax - ray.getOrigin()) < 0) {
-            std::cerr << "Error: Ray is not pointing towards the bounding box!" << std::endl;
-            return false;
-        }
-
-        // Check if the ray direction is normalized
-        if (glm::length(rayDirectionLocal) < 0.99f || glm::length(rayDirectionLocal) > 1.01f) {
-            std::cerr << "Error: Ray direction is not normalized!" << std::endl;
-            return false;
-        }
-
-        // Check bounding box dimensions
-        if (m_worldMin.x >= m_worldMax.x || m_worldMin.y >= m_worldMax.y || m_worldMin.z >= m_worldMax.z) {
-            std::cerr << "Error: Invalid bounding box dimensions!" << std::endl;
-            return false;
-        }
+        const float tMin = std::max(tmin.x, std::max(tmin.y, tmin.z));
+        const float tMax = std::min(tmax.x, std::min(tmax.y, tmax.z));
 
-        if (rayDirectionLocal == glm::vec3(0.0f)) {
-            std::cerr << "Error: Division by zero!" << std::endl;
+        if (tMax < 0.0f || tMin > tMax) {
             return false;
         }
 
-        glm::vec3 invDir = 1.0f / rayDirectionLocal;
-        glm::vec3 t0s = (m_worldMin - rayOriginLocal) * invDir;
-        glm::vec3 t1s = (m_worldMax - rayOriginLocal) * invDir;
-
-        glm::vec3 tmin = glm::min(t0s, t1s);
-        glm::vec3 tmax = glm::max(t0s, t1s);
-
-        float tMin = std::max(tmin.x, std::max(tmin.y, tmin.z));
-        float tMax = std::min(tmax.x, std::min(tmax.y, tmax.z));
-
-        if (tMax < 0 || tMin > tMax) {
-            return false;
-        }
+        // Starting inside the box counts as a hit at the origin.
+        hitDistance = std::max(tMin, 0.0f);
+        return hitDistance <= maxDistance;
+    }
 
-        return true;
+    IDK::AABB getLocalBounds() const override {
+        return {m_worldMin, m_worldMax};
     }
 
     void Draw(IDK::Graphics::Shader& wireframe) override  {
         if (collider) {
-            glBindVertexArray(VAO);
+            IDK::Graphics::GLStateCache::Instance().bindVertexArray(VAO);
 
             glm::vec3 wireframeColor = glm::vec3(0.0f, 1.0f, 0.0f);
             wireframe.setVec3("m_wireframeColor", wireframeColor);
 
-            glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
+            // Already line primitives, so the polygon mode does not apply.
             glDrawElements(GL_LINES, 24, GL_UNSIGNED_INT, 0);
-            glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
         }
     }
 
@@ -128,7 +108,7 @@ private:
         glGenBuffers(1, &VBO);
         glGenBuffers(1, &EBO);
 
-        glBindVertexArray(VAO);
+        IDK::Graphics::GLStateCache::Instance().bindVertexArray(VAO);
 
         glBindBuffer(GL_ARRAY_BUFFER, VBO);
         glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
@@ -139,10 +119,11 @@ private:
         glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void*)0);
         glEnableVertexAttribArray(0);
 
-        glBindVertexArray(0);
+        IDK::Graphics::GLStateCache::Instance().bindVertexArray(0);
     }
 
     void cleanupBuffers() const {
+        IDK::Graphics::GLStateCache::Instance().forgetVertexArray(VAO);
         glDeleteVertexArrays(1, &VAO);
         glDeleteBuffers(1, &VBO);
         glDeleteBuffers(1, &EBO);
@@ -5,11 +5,13 @@
 #ifndef CAPSULECOLLIDER_H
 #define CAPSULECOLLIDER_H
 
+#include <limits>
 #include <memory>
 #include "Collider.h"
 #include "Ray.h"
 #include "Shader.h"
 #include "glad/glad.h"
+#include "GLStateCache.h"
 #include "gtx/norm.hpp"
 
 class CapsuleCollider final : public Collider {
@@ -24,6 +26,10 @@ public:
 
     ~CapsuleCollider() override {}
 
+    const glm::vec3& getPosition() const { return m_position; }
+    float getRadius() const { return radius; }
+    float getHeight() const { return height; }
+
     void updateModelMatrix() {
         m_modelMatrix = glm::translate(glm::mat4(1.0f), m_position);
     }
@@ -35,39 +41,33 @@ public:
         }
     }
 
-    bool intersectsRay(const Ray &ray, const glm::mat4 &transformMatrix, float distance) override {
-        glm::mat4 inverseTransform = glm::inverse(transformMatrix);
-        glm::vec3 localRayOrigin = glm::vec3(inverseTransform * glm::vec4(ray.m_origin, 1.0f));
-        glm::vec3 localRayDirection = glm::normalize(glm::vec3(inverseTransform * glm::vec4(ray.m_direction, 0.0f)));
-
+    bool intersectsLocalRay(const glm::vec3& origin, const glm::vec3& direction,
+                            float maxDistance, float& hitDistance) const override {
         glm::vec3 cylinderBottom = m_position - glm::vec3(0.0f, height / 2.0f, 0.0f);
         glm::vec3 cylinderTop = m_position + glm::vec3(0.0f, height / 2.0f, 0.0f);
 
+        // The nearest of the cylindrical part and both end spheres is the entry point.
+        hitDistance = std::numeric_limits<float>::max();
+
         float t0, t1;
-        // Check intersection with the cylindrical part
-        if (intersectsCylinder(localRayOrigin, localRayDirection, cylinderBottom, cylinderTop, radius, t0, t1)) {
-            if ((t0 >= 0.0f && t0 <= distance) || (t1 >= 0.0f && t1 <= distance)) {
-                return true;
-            }
+        if (intersectsCylinder(origin, direction, cylinderBottom, cylinderTop, radius, t0, t1)) {
+            hitDistance = std::max(t0, 0.0f);
         }
 
-        // Check intersection with the bottom hemisphere
         float t;
-        if (intersectsSphere(localRayOrigin, localRayDirection, cylinderBottom, radius, t)) {
-            if (t >= 0.0f && t <= distance) {
-                return true;
-            }
+        if (intersectsSphere(origin, direction, cylinderBottom, radius, t)) {
+            hitDistance = std::min(hitDistance, t);
         }
-
-        // Check intersection with the top hemisphere
-        if (intersectsSphere(localRayOrigin, localRayDirection, cylinderTop, radius, t)) {
-            if (t >= 0.0f && t <= distance) {
-                return true;
-            }
+        if (intersectsSphere(origin, direction, cylinderTop, radius, t)) {
+            hitDistance = std::min(hitDistance, t);
         }
 
-        return false;
+        return hitDistance < std::numeric_limits<float>::max() && hitDistance <= maxDistance;
+    }
 
+    IDK::AABB getLocalBounds() const override {
+        const glm::vec3 extents(radius, height / 2.0f + radius, radius);
+        return {m_position - extents, m_position + extents};
     }
 
 private:
@@ -88,7 +88,7 @@ private:
         float bard = glm::dot(ba, rayDirection);
         float baoc = glm::dot(ba, oc);
 
-        float k2 = baba - bard * bard;
+        float k2 = baba * glm::dot(rayDirection, rayDirection) - bard * bard;
         float k1 = baba * glm::dot(oc, rayDirection) - baoc * bard;
         float k0 = baba * glm::dot(oc, oc) - baoc * baoc - cylinderRadius * cylinderRadius * baba;
 
@@ -191,7 +191,7 @@ private:
         glGenVertexArrays(1, &VAO);
         glGenBuffers(1, &VBO);
 
-        glBindVertexArray(VAO);
+        IDK::Graphics::GLStateCache::Instance().bindVertexArray(VAO);
         glBindBuffer(GL_ARRAY_BUFFER, VBO);
         glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(glm::vec3), vertices.data(), GL_STATIC_DRAW);
 
@@ -200,6 +200,7 @@ private:
 
         glDrawArrays(GL_LINES, 0, vertices.size());
 
+        IDK::Graphics::GLStateCache::Instance().forgetVertexArray(VAO);
         glDeleteVertexArrays(1, &VAO);
         glDeleteBuffers(1, &VBO);
     }
@@ -225,7 +226,7 @@ private:
         glGenVertexArrays(1, &VAO);
         glGenBuffers(1, &VBO);
 
-        glBindVertexArray(VAO);
+        IDK::Graphics::GLStateCache::Instance().bindVertexArray(VAO);
         glBindBuffer(GL_ARRAY_BUFFER, VBO);
         glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(glm::vec3), vertices.data(), GL_STATIC_DRAW);
 
@@ -234,6 +235,7 @@ private:
 
         glDrawArrays(GL_LINES, 0, vertices.size());
 
+        IDK::Graphics::GLStateCache::Instance().forgetVertexArray(VAO);
         glDeleteVertexArrays(1, &VAO);
         glDeleteBuffers(1, &VBO);
 
@@ -6,6 +6,7 @@
 #define CORE_COLLIDER_H
 
 #include "../ECS/Component.h"
+#include "Bounds.h"
 #include "Ray.h"
 #include "Shader.h"
 
@@ -14,7 +15,22 @@ public:
     explicit Collider(const std::string& name)
      : Component(name) {}
 
-    virtual bool intersectsRay(const Ray& ray, const glm::mat4& transformMatrix, float disnce) = 0;
+    // Ray in the collider's local space. The direction is the world direction
+    // taken through the inverse model matrix without renormalizing, so the
+    // hit distance is measured along the world ray.
+    virtual bool intersectsLocalRay(const glm::vec3& origin, const glm::vec3& direction,
+                                    float maxDistance, float& hitDistance) const = 0;
+
+    // Local-space box around the collider shape, for broad phases.
+    virtual IDK::AABB getLocalBounds() const = 0;
+
+    bool intersectsRay(const Ray& ray, const glm::mat4& transformMatrix, float distance) const {
+        const glm::mat4 inverse = glm::inverse(transformMatrix);
+        float hitDistance;
+        return intersectsLocalRay(glm::vec3(inverse * glm::vec4(ray.getOrigin(), 1.0f)),
+                                  glm::vec3(inverse * glm::vec4(ray.getDirection(), 0.0f)), distance, hitDistance);
+    }
+
     virtual void Draw(IDK::Graphics::Shader& wireframe) = 0 ;
 };
 
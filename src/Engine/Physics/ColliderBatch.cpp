@@ -0,0 +1,364 @@
+//
+// Created by SIMEON on 10/17/2026.
+//
+
+#include "ColliderBatch.h"
+
+#include <cmath>
+#include <limits>
+#include <type_traits>
+
+#include "BoxCollider.h"
+#include "CapsuleCollider.h"
+#include "CylinderCollider.h"
+#include "SphereCollider.h"
+
+#if defined(__AVX__)
+    #include <immintrin.h>
+    #define IDK_RAY_AVX 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define IDK_RAY_SSE 1
+#endif
+
+namespace IDK
+{
+    namespace
+    {
+        // Just enough of a float vector for the kernels to be written once.
+        // Comparisons yield lane masks; min/max return the second operand on
+        // NaN in every width so all paths agree on degenerate rays.
+        struct Lane1 {
+            static constexpr size_t Width = 1;
+            float v;
+
+            static Lane1 load(const float* p) { return {*p}; }
+            static Lane1 set(float x) { return {x}; }
+            void store(float* p) const { *p = v; }
+
+            friend Lane1 operator+(Lane1 a, Lane1 b) { return {a.v + b.v}; }
+            friend Lane1 operator-(Lane1 a, Lane1 b) { return {a.v - b.v}; }
+            friend Lane1 operator*(Lane1 a, Lane1 b) { return {a.v * b.v}; }
+            friend Lane1 operator/(Lane1 a, Lane1 b) { return {a.v / b.v}; }
+            friend Lane1 min(Lane1 a, Lane1 b) { return {a.v < b.v ? a.v : b.v}; }
+            friend Lane1 max(Lane1 a, Lane1 b) { return {a.v > b.v ? a.v : b.v}; }
+            friend Lane1 sqrt(Lane1 a) { return {std::sqrt(a.v)}; }
+            friend bool operator<(Lane1 a, Lane1 b) { return a.v < b.v; }
+            friend bool operator<=(Lane1 a, Lane1 b) { return a.v <= b.v; }
+            friend bool operator>=(Lane1 a, Lane1 b) { return a.v >= b.v; }
+            friend Lane1 select(bool mask, Lane1 a, Lane1 b) { return mask ? a : b; }
+        };
+
+#if defined(IDK_RAY_AVX)
+        struct LaneN {
+            static constexpr size_t Width = 8;
+            __m256 v;
+
+            static LaneN load(const float* p) { return {_mm256_loadu_ps(p)}; }
+            static LaneN set(float x) { return {_mm256_set1_ps(x)}; }
+            void store(float* p) const { _mm256_storeu_ps(p, v); }
+
+            friend LaneN operator+(LaneN a, LaneN b) { return {_mm256_add_ps(a.v, b.v)}; }
+            friend LaneN operator-(LaneN a, LaneN b) { return {_mm256_sub_ps(a.v, b.v)}; }
+            friend LaneN operator*(LaneN a, LaneN b) { return {_mm256_mul_ps(a.v, b.v)}; }
+            friend LaneN operator/(LaneN a, LaneN b) { return {_mm256_div_ps(a.v, b.v)}; }
+            friend LaneN min(LaneN a, LaneN b) { return {_mm256_min_ps(a.v, b.v)}; }
+            friend LaneN max(LaneN a, LaneN b) { return {_mm256_max_ps(a.v, b.v)}; }
+            friend LaneN sqrt(LaneN a) { return {_mm256_sqrt_ps(a.v)}; }
+            friend LaneN operator<(LaneN a, LaneN b) { return {_mm256_cmp_ps(a.v, b.v, _CMP_LT_OQ)}; }
+            friend LaneN operator<=(LaneN a, LaneN b) { return {_mm256_cmp_ps(a.v, b.v, _CMP_LE_OQ)}; }
+            friend LaneN operator>=(LaneN a, LaneN b) { return {_mm256_cmp_ps(a.v, b.v, _CMP_GE_OQ)}; }
+            friend LaneN operator&(LaneN a, LaneN b) { return {_mm256_and_ps(a.v, b.v)}; }
+            friend LaneN operator|(LaneN a, LaneN b) { return {_mm256_or_ps(a.v, b.v)}; }
+            friend LaneN select(LaneN mask, LaneN a, LaneN b) { return {_mm256_blendv_ps(b.v, a.v, mask.v)}; }
+        };
+#elif defined(IDK_RAY_SSE)
+        struct LaneN {
+            static constexpr size_t Width = 4;
+            __m128 v;
+
+            static LaneN load(const float* p) { return {_mm_loadu_ps(p)}; }
+            static LaneN set(float x) { return {_mm_set1_ps(x)}; }
+            void store(float* p) const { _mm_storeu_ps(p, v); }
+
+            friend LaneN operator+(LaneN a, LaneN b) { return {_mm_add_ps(a.v, b.v)}; }
+            friend LaneN operator-(LaneN a, LaneN b) { return {_mm_sub_ps(a.v, b.v)}; }
+            friend LaneN operator*(LaneN a, LaneN b) { return {_mm_mul_ps(a.v, b.v)}; }
+            friend LaneN operator/(LaneN a, LaneN b) { return {_mm_div_ps(a.v, b.v)}; }
+            friend LaneN min(LaneN a, LaneN b) { return {_mm_min_ps(a.v, b.v)}; }
+            friend LaneN max(LaneN a, LaneN b) { return {_mm_max_ps(a.v, b.v)}; }
+            friend LaneN sqrt(LaneN a) { return {_mm_sqrt_ps(a.v)}; }
+            friend LaneN operator<(LaneN a, LaneN b) { return {_mm_cmplt_ps(a.v, b.v)}; }
+            friend LaneN operator<=(LaneN a, LaneN b) { return {_mm_cmple_ps(a.v, b.v)}; }
+            friend LaneN operator>=(LaneN a, LaneN b) { return {_mm_cmpge_ps(a.v, b.v)}; }
+            friend LaneN operator&(LaneN a, LaneN b) { return {_mm_and_ps(a.v, b.v)}; }
+            friend LaneN operator|(LaneN a, LaneN b) { return {_mm_or_ps(a.v, b.v)}; }
+            friend LaneN select(LaneN mask, LaneN a, LaneN b) {
+                return {_mm_or_ps(_mm_and_ps(mask.v, a.v), _mm_andnot_ps(mask.v, b.v))};
+            }
+        };
+#endif
+
+        template<typename V>
+        struct LocalRay {
+            V ox, oy, oz;
+            V dx, dy, dz;
+        };
+
+        // World ray through the inverse transforms of colliders [i, i + Width).
+        // The direction is not renormalized, so t stays a world distance.
+        template<typename V>
+        LocalRay<V> toLocal(const std::vector<float> (&frame)[12], size_t i, const glm::vec3& origin, const glm::vec3& direction) {
+            const V m00 = V::load(&frame[0][i]), m01 = V::load(&frame[1][i]), m02 = V::load(&frame[2][i]), m03 = V::load(&frame[3][i]);
+            const V m10 = V::load(&frame[4][i]), m11 = V::load(&frame[5][i]), m12 = V::load(&frame[6][i]), m13 = V::load(&frame[7][i]);
+            const V m20 = V::load(&frame[8][i]), m21 = V::load(&frame[9][i]), m22 = V::load(&frame[10][i]), m23 = V::load(&frame[11][i]);
+
+            const V ox = V::set(origin.x), oy = V::set(origin.y), oz = V::set(origin.z);
+            const V dx = V::set(direction.x), dy = V::set(direction.y), dz = V::set(direction.z);
+
+            return {m00 * ox + m01 * oy + m02 * oz + m03,
+                    m10 * ox + m11 * oy + m12 * oz + m13,
+                    m20 * ox + m21 * oy + m22 * oz + m23,
+                    m00 * dx + m01 * dy + m02 * dz,
+                    m10 * dx + m11 * dy + m12 * dz,
+                    m20 * dx + m21 * dy + m22 * dz};
+        }
+
+        template<typename V>
+        struct SphereRoots {
+            V discriminant;
+            V t0, t1; // t0 <= t1 where the discriminant is non-negative
+        };
+
+        // Ray against a sphere at the given origin offset.
+        template<typename V>
+        SphereRoots<V> sphereRoots(V ocx, V ocy, V ocz, const LocalRay<V>& ray, V radius) {
+            const V a = ray.dx * ray.dx + ray.dy * ray.dy + ray.dz * ray.dz;
+            const V b = V::set(2.0f) * (ocx * ray.dx + ocy * ray.dy + ocz * ray.dz);
+            const V c = ocx * ocx + ocy * ocy + ocz * ocz - radius * radius;
+
+            const V discriminant = b * b - V::set(4.0f) * a * c;
+            const V root = sqrt(max(discriminant, V::set(0.0f)));
+            const V twoA = V::set(2.0f) * a;
+            return {discriminant, (V::set(0.0f) - b - root) / twoA, (V::set(0.0f) - b + root) / twoA};
+        }
+
+        // Entry distance into a sphere, or infinity. From inside, the hit is
+        // at the origin.
+        template<typename V>
+        V sphereEntry(V ocx, V ocy, V ocz, const LocalRay<V>& ray, V radius) {
+            const SphereRoots<V> roots = sphereRoots(ocx, ocy, ocz, ray, radius);
+            return select((roots.discriminant >= V::set(0.0f)) & (roots.t1 >= V::set(0.0f)), max(roots.t0, V::set(0.0f)),
+                          V::set(std::numeric_limits<float>::infinity()));
+        }
+
+        template<typename V>
+        V boxKernel(const std::vector<float> (&p)[6], size_t i, const LocalRay<V>& ray) {
+            const V zero = V::set(0.0f);
+            const V invX = V::set(1.0f) / ray.dx;
+            const V invY = V::set(1.0f) / ray.dy;
+            const V invZ = V::set(1.0f) / ray.dz;
+
+            const V t0x = (V::load(&p[0][i]) - ray.ox) * invX, t1x = (V::load(&p[3][i]) - ray.ox) * invX;
+            const V t0y = (V::load(&p[1][i]) - ray.oy) * invY, t1y = (V::load(&p[4][i]) - ray.oy) * invY;
+            const V t0z = (V::load(&p[2][i]) - ray.oz) * invZ, t1z = (V::load(&p[5][i]) - ray.oz) * invZ;
+
+            const V tMin = max(max(min(t0x, t1x), min(t0y, t1y)), min(t0z, t1z));
+            const V tMax = min(min(max(t0x, t1x), max(t0y, t1y)), max(t0z, t1z));
+
+            return select((tMax >= zero) & (tMin <= tMax), max(tMin, zero),
+                          V::set(std::numeric_limits<float>::infinity()));
+        }
+
+        template<typename V>
+        V sphereKernel(const std::vector<float> (&p)[4], size_t i, const LocalRay<V>& ray) {
+            return sphereEntry(ray.ox - V::load(&p[0][i]), ray.oy - V::load(&p[1][i]), ray.oz - V::load(&p[2][i]),
+                               ray, V::load(&p[3][i]));
+        }
+
+        // Mirrors CapsuleCollider::intersectsLocalRay: the nearest of the
+        // segment's cylinder, clipped to its height by interpolating along the
+        // ray, and the two end spheres, which report their exit from inside.
+        template<typename V>
+        V capsuleKernel(const std::vector<float> (&p)[5], size_t i, const LocalRay<V>& ray) {
+            const V zero = V::set(0.0f);
+            const V infinity = V::set(std::numeric_limits<float>::infinity());
+            const V radius = V::load(&p[3][i]);
+            const V halfHeight = V::load(&p[4][i]);
+            const V height = halfHeight + halfHeight;
+
+            const V ocx = ray.ox - V::load(&p[0][i]);
+            const V ocy = ray.oy - V::load(&p[1][i]);
+            const V ocz = ray.oz - V::load(&p[2][i]);
+
+            const V a = ray.dx * ray.dx + ray.dz * ray.dz;
+            const V b = ocx * ray.dx + ocz * ray.dz;
+            const V c = ocx * ocx + ocz * ocz - radius * radius;
+            const V discriminant = b * b - a * c;
+            const V root = sqrt(max(discriminant, zero));
+            const V r0 = (zero - b - root) / a;
+            const V r1 = (zero - b + root) / a;
+            const V t0 = min(r0, r1);
+            const V t1 = max(r0, r1);
+
+            // Heights above the bottom end, where the scalar test measures them.
+            const V y0 = ocy + halfHeight + t0 * ray.dy;
+            const V y1 = ocy + halfHeight + t1 * ray.dy;
+            const V slope = (t1 - t0) / (y1 - y0);
+            const V bottomT = t0 + slope * (zero - y0);
+            const V topT = t0 + slope * (height - y0);
+
+            const V enter = select(y0 < zero, bottomT, select(height < y0, topT, t0));
+            const V exit = select(y1 < zero, bottomT, select(height < y1, topT, t1));
+            const auto spans = ((y0 >= zero) | (y1 >= zero)) & ((y0 <= height) | (y1 <= height));
+            const V side = select((discriminant >= zero) & spans & ((enter >= zero) | (exit >= zero)),
+                                  max(enter, zero), infinity);
+
+            const SphereRoots<V> bottom = sphereRoots(ocx, ocy + halfHeight, ocz, ray, radius);
+            const SphereRoots<V> top = sphereRoots(ocx, ocy - halfHeight, ocz, ray, radius);
+            const V bottomHit = select(bottom.discriminant >= zero,
+                                       select(bottom.t0 >= zero, bottom.t0, select(bottom.t1 >= zero, bottom.t1, infinity)), infinity);
+            const V topHit = select(top.discriminant >= zero,
+                                    select(top.t0 >= zero, top.t0, select(top.t1 >= zero, top.t1, infinity)), infinity);
+            return min(side, min(bottomHit, topHit));
+        }
+
+        // Mirrors CylinderCollider::intersectsLocalRay: side hits in front of
+        // the origin within the height, then the two caps.
+        template<typename V>
+        V cylinderKernel(const std::vector<float> (&p)[2], size_t i, const LocalRay<V>& ray) {
+            const V zero = V::set(0.0f);
+            const V infinity = V::set(std::numeric_limits<float>::infinity());
+            const V radius = V::load(&p[0][i]);
+            const V halfHeight = V::load(&p[1][i]);
+            const V radiusSq = radius * radius;
+
+            const V a = ray.dx * ray.dx + ray.dz * ray.dz;
+            const V b = V::set(2.0f) * (ray.ox * ray.dx + ray.oz * ray.dz);
+            const V c = ray.ox * ray.ox + ray.oz * ray.oz - radiusSq;
+            const V discriminant = b * b - V::set(4.0f) * a * c;
+            const V root = sqrt(max(discriminant, zero));
+            const V r1 = (zero - b - root) / (V::set(2.0f) * a);
+            const V r2 = (zero - b + root) / (V::set(2.0f) * a);
+            const V t1 = min(r1, r2);
+            const V t2 = max(r1, r2);
+
+            const V y1 = ray.oy + t1 * ray.dy;
+            const V y2 = ray.oy + t2 * ray.dy;
+            V hit = select((t1 >= zero) & (y1 >= zero - halfHeight) & (y1 <= halfHeight), t1, infinity);
+            hit = select((t2 >= zero) & (y2 >= zero - halfHeight) & (y2 <= halfHeight) & (t2 < hit), t2, hit);
+
+            const V tCap1 = (zero - halfHeight - ray.oy) / ray.dy;
+            const V cap1x = ray.ox + tCap1 * ray.dx, cap1z = ray.oz + tCap1 * ray.dz;
+            hit = select((tCap1 >= zero) & (cap1x * cap1x + cap1z * cap1z <= radiusSq) & (tCap1 < hit), tCap1, hit);
+
+            const V tCap2 = (halfHeight - ray.oy) / ray.dy;
+            const V cap2x = ray.ox + tCap2 * ray.dx, cap2z = ray.oz + tCap2 * ray.dz;
+            hit = select((tCap2 >= zero) & (cap2x * cap2x + cap2z * cap2z <= radiusSq) & (tCap2 < hit), tCap2, hit);
+
+            return select(discriminant >= zero, hit, infinity);
+        }
+
+        template<typename ColliderType, typename V, size_t ParamCount>
+        size_t raycastLanes(const std::vector<float> (&frame)[12], const std::vector<float> (&params)[ParamCount],
+                            size_t begin, size_t count, const glm::vec3& origin, const glm::vec3& direction,
+                            float maxDistance, float* distances) {
+            const V limit = V::set(maxDistance);
+            const V infinity = V::set(std::numeric_limits<float>::infinity());
+
+            size_t i = begin;
+            for (; i + V::Width <= count; i += V::Width) {
+                const LocalRay<V> ray = toLocal<V>(frame, i, origin, direction);
+
+                V hit;
+                if constexpr (std::is_same_v<ColliderType, BoxCollider>) hit = boxKernel(params, i, ray);
+                else if constexpr (std::is_same_v<ColliderType, SphereCollider>) hit = sphereKernel(params, i, ray);
+                else if constexpr (std::is_same_v<ColliderType, CapsuleCollider>) hit = capsuleKernel(params, i, ray);
+                else hit = cylinderKernel(params, i, ray);
+
+                select(hit <= limit, hit, infinity).store(distances + i);
+            }
+            return i;
+        }
+    }
+
+    template<typename ColliderType>
+    void ColliderBatch<ColliderType>::clear() {
+        for (std::vector<float>& row : m_frame) row.clear();
+        for (std::vector<float>& param : m_params) param.clear();
+        m_count = 0;
+    }
+
+    template<typename ColliderType>
+    void ColliderBatch<ColliderType>::reserve(size_t count) {
+        for (std::vector<float>& row : m_frame) row.reserve(count);
+        for (std::vector<float>& param : m_params) param.reserve(count);
+    }
+
+    template<typename ColliderType>
+    uint32_t ColliderBatch<ColliderType>::add(const ColliderType& collider, const glm::mat4& model) {
+        // glm is column-major: row r of the inverse is (inverse[0][r], inverse[1][r], inverse[2][r], inverse[3][r]).
+        const glm::mat4 inverse = glm::inverse(model);
+        for (int row = 0; row < 3; ++row) {
+            for (int column = 0; column < 4; ++column)
+                m_frame[row * 4 + column].push_back(inverse[column][row]);
+        }
+
+        if constexpr (std::is_same_v<ColliderType, BoxCollider>) {
+            const glm::vec3& min = collider.getMin();
+            const glm::vec3& max = collider.getMax();
+            for (int axis = 0; axis < 3; ++axis) {
+                m_params[axis].push_back(min[axis]);
+                m_params[3 + axis].push_back(max[axis]);
+            }
+        } else if constexpr (std::is_same_v<ColliderType, SphereCollider>) {
+            for (int axis = 0; axis < 3; ++axis)
+                m_params[axis].push_back(collider.getCenter()[axis]);
+            m_params[3].push_back(collider.getRadius());
+        } else if constexpr (std::is_same_v<ColliderType, CapsuleCollider>) {
+            for (int axis = 0; axis < 3; ++axis)
+                m_params[axis].push_back(collider.getPosition()[axis]);
+            m_params[3].push_back(collider.getRadius());
+            m_params[4].push_back(collider.getHeight() * 0.5f);
+        } else {
+            m_params[0].push_back(collider.radius);
+            m_params[1].push_back(collider.height * 0.5f);
+        }
+
+        return static_cast<uint32_t>(m_count++);
+    }
+
+    template<typename ColliderType>
+    void ColliderBatch<ColliderType>::raycast(const glm::vec3& origin, const glm::vec3& direction, float maxDistance,
+                                              std::vector<float>& distances) const {
+        distances.resize(m_count);
+        if (m_count == 0) return;
+
+        size_t i = 0;
+#if defined(IDK_RAY_AVX) || defined(IDK_RAY_SSE)
+        i = raycastLanes<ColliderType, LaneN>(m_frame, m_params, i, m_count, origin, direction, maxDistance, distances.data());
+#endif
+        raycastLanes<ColliderType, Lane1>(m_frame, m_params, i, m_count, origin, direction, maxDistance, distances.data());
+    }
+
+    template<typename ColliderType>
+    int32_t ColliderBatch<ColliderType>::raycastNearest(const glm::vec3& origin, const glm::vec3& direction,
+                                                        float maxDistance, float& distance) const {
+        raycast(origin, direction, maxDistance, m_distances);
+
+        int32_t nearest = -1;
+        distance = std::numeric_limits<float>::infinity();
+        for (size_t i = 0; i < m_distances.size(); ++i) {
+            if (m_distances[i] < distance) {
+                distance = m_distances[i];
+                nearest = static_cast<int32_t>(i);
+            }
+        }
+        return nearest;
+    }
+
+    template class ColliderBatch<BoxCollider>;
+    template class ColliderBatch<SphereCollider>;
+    template class ColliderBatch<CapsuleCollider>;
+    template class ColliderBatch<CylinderCollider>;
+}
@@ -0,0 +1,73 @@
+//
+// Created by SIMEON on 10/17/2026.
+//
+
+#ifndef COLLIDERBATCH_H
+#define COLLIDERBATCH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "glm.hpp"
+
+class BoxCollider;
+class SphereCollider;
+class CapsuleCollider;
+class CylinderCollider;
+
+namespace IDK
+{
+    // Local-space parameters each shape keeps per collider.
+    template<typename ColliderType> struct ColliderBatchLayout;
+    template<> struct ColliderBatchLayout<BoxCollider> { static constexpr size_t ParamCount = 6; };      // min, max
+    template<> struct ColliderBatchLayout<SphereCollider> { static constexpr size_t ParamCount = 4; };   // center, radius
+    template<> struct ColliderBatchLayout<CapsuleCollider> { static constexpr size_t ParamCount = 5; };  // center, radius, half height
+    template<> struct ColliderBatchLayout<CylinderCollider> { static constexpr size_t ParamCount = 2; }; // radius, half height
+
+    // One ray against many colliders of one shape, without a virtual call or
+    // matrix inverse per collider. Each collider is stored structure-of-arrays
+    // together with its inverse world transform, so every lane tests in the
+    // collider's own space exactly as intersectsLocalRay does. AVX runs 8
+    // colliders per iteration, SSE 4, and leftovers go through the scalar path.
+    template<typename ColliderType>
+    class ColliderBatch
+    {
+    public:
+        void clear();
+        void reserve(size_t count);
+
+        // Returns the collider's index into the raycast results.
+        uint32_t add(const ColliderType& collider, const glm::mat4& model);
+        size_t size() const { return m_count; }
+
+        // distances[i] becomes the hit distance along the ray for collider i,
+        // or infinity when it misses or lies beyond maxDistance.
+        void raycast(const glm::vec3& origin, const glm::vec3& direction, float maxDistance,
+                     std::vector<float>& distances) const;
+
+        // Index of the nearest hit, or -1.
+        int32_t raycastNearest(const glm::vec3& origin, const glm::vec3& direction, float maxDistance,
+                               float& distance) const;
+
+    private:
+        static constexpr size_t ParamCount = ColliderBatchLayout<ColliderType>::ParamCount;
+
+        std::vector<float> m_frame[12]; // rows of the inverse world transform's 3x4 part
+        std::vector<float> m_params[ParamCount];
+        size_t m_count = 0;
+
+        mutable std::vector<float> m_distances; // raycastNearest scratch
+    };
+
+    using BoxColliderBatch = ColliderBatch<BoxCollider>;
+    using SphereColliderBatch = ColliderBatch<SphereCollider>;
+    using CapsuleColliderBatch = ColliderBatch<CapsuleCollider>;
+    using CylinderColliderBatch = ColliderBatch<CylinderCollider>;
+
+    extern template class ColliderBatch<BoxCollider>;
+    extern template class ColliderBatch<SphereCollider>;
+    extern template class ColliderBatch<CapsuleCollider>;
+    extern template class ColliderBatch<CylinderCollider>;
+}
+
+#endif //COLLIDERBATCH_H
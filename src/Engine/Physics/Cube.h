@@ -29,25 +29,19 @@ private:
     void initialize() const
     {
         auto& transform = m_entity->addComponent<Transform>();
-        transform.position = glm::vec3(0.0f, 1.5f, 0.0f);
+        transform.setPosition(glm::vec3(0.0f, 1.5f, 0.0f));
 
         auto& meshFilter = m_entity->addComponent<IDK::Components::MeshFilter>();
-       // auto cubeMesh = std::make_shared<Mesh>("CubeMesh");
-        auto cubeMesh = std::allocate_shared<IDK::Graphics::Mesh>(IDK::MeshSharedAllocator<IDK::Graphics::Mesh>(), "CubeMesh");
-
-
-        cubeMesh->CreateMesh(IDK::Graphics::MeshType::Cube);
+        auto cubeMesh = IDK::MeshRegistry::Instance().acquire(
+            IDK::Graphics::ProceduralMeshKey::Default(IDK::Graphics::MeshType::Cube));
         meshFilter.setMesh(cubeMesh);
-        cubeMesh->printMemUsage();
-
-        IDK::MeshRegistry::Instance().registerMesh(cubeMesh);
 
         m_entity->addComponent<IDK::Components::MeshRenderer>([&](IDK::Components::MeshRenderer &mr) {
             mr.setMeshFilter(meshFilter.shared_from_this());
         });
 
         m_entity->addComponent<BoxCollider>(
-            transform.position,
+            transform.getPosition(),
             glm::vec3(-0.6f),
             glm::vec3(0.6f)
         );
@@ -8,7 +8,9 @@
 #include "Collider.h"
 #include "Ray.h"
 #include "glad/glad.h"
+#include "GLStateCache.h"
 #include "memory"
+#include <limits>
 #include <vector>
 
 #define M_PI 3.14159265358979323846
@@ -26,22 +28,19 @@ public:
     void Draw(IDK::Graphics::Shader& wireframe) override {
         wireframe.Use();
 
-        glBindVertexArray(VAO);
-        glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
+        auto& glState = IDK::Graphics::GLStateCache::Instance();
+        glState.bindVertexArray(VAO);
+        glState.setPolygonMode(GL_LINE);
         glDrawElements(GL_TRIANGLES, indices.size(), GL_UNSIGNED_INT, 0);
-        glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
-        glBindVertexArray(0);
+        glState.setPolygonMode(GL_FILL);
     }
 
-    bool intersectsRay(const Ray& ray, const glm::mat4& transformMatrix, float distance) override {
-        glm::mat4 invTransform = glm::inverse(transformMatrix);
-        glm::vec3 localRayOrigin = glm::vec3(invTransform * glm::vec4(ray.m_origin, 1.0f));
-        glm::vec3 localRayDirection = glm::normalize(glm::vec3(invTransform * glm::vec4(ray.m_direction, 0.0f)));
-
+    bool intersectsLocalRay(const glm::vec3& origin, const glm::vec3& direction,
+                            float maxDistance, float& hitDistance) const override {
         // Check intersection with infinite cylinder
-        float a = localRayDirection.x * localRayDirection.x + localRayDirection.z * localRayDirection.z;
-        float b = 2.0f * (localRayOrigin.x * localRayDirection.x + localRayOrigin.z * localRayDirection.z);
-        float c = localRayOrigin.x * localRayOrigin.x + localRayOrigin.z * localRayOrigin.z - radius * radius;
+        float a = direction.x * direction.x + direction.z * direction.z;
+        float b = 2.0f * (origin.x * direction.x + origin.z * direction.z);
+        float c = origin.x * origin.x + origin.z * origin.z - radius * radius;
 
         float discriminant = b * b - 4.0f * a * c;
         if (discriminant < 0.0f) {
@@ -55,35 +54,31 @@ public:
         if (t1 > t2) std::swap(t1, t2);
 
         // Check if the intersection points are within the height of the cylinder
-        float y1 = localRayOrigin.y + t1 * localRayDirection.y;
-        float y2 = localRayOrigin.y + t2 * localRayDirection.y;
-
-        bool intersectSide = false;
-        if ((y1 >= -height / 2.0f && y1 <= height / 2.0f) ||
-            (y2 >= -height / 2.0f && y2 <= height / 2.0f)) {
-            intersectSide = true;
-        }
+        float y1 = origin.y + t1 * direction.y;
+        float y2 = origin.y + t2 * direction.y;
 
-        float tCap1 = (-height / 2.0f - localRayOrigin.y) / localRayDirection.y;
-        float tCap2 = (height / 2.0f - localRayOrigin.y) / localRayDirection.y;
+        float tCap1 = (-height / 2.0f - origin.y) / direction.y;
+        float tCap2 = (height / 2.0f - origin.y) / direction.y;
 
-        float cap1x = localRayOrigin.x + tCap1 * localRayDirection.x;
-        float cap1z = localRayOrigin.z + tCap1 * localRayDirection.z;
+        float cap1x = origin.x + tCap1 * direction.x;
+        float cap1z = origin.z + tCap1 * direction.z;
         bool intersectCap1 = (tCap1 >= 0) && (cap1x * cap1x + cap1z * cap1z <= radius * radius);
 
-        float cap2x = localRayOrigin.x + tCap2 * localRayDirection.x;
-        float cap2z = localRayOrigin.z + tCap2 * localRayDirection.z;
+        float cap2x = origin.x + tCap2 * direction.x;
+        float cap2z = origin.z + tCap2 * direction.z;
         bool intersectCap2 = (tCap2 >= 0) && (cap2x * cap2x + cap2z * cap2z <= radius * radius);
 
-        distance = std::numeric_limits<float>::max();
-        if (intersectSide) {
-            if (y1 >= -height / 2.0f && y1 <= height / 2.0f) distance = t1;
-            if (y2 >= -height / 2.0f && y2 <= height / 2.0f && t2 < distance) distance = t2;
-        }
-        if (intersectCap1 && tCap1 < distance) distance = tCap1;
-        if (intersectCap2 && tCap2 < distance) distance = tCap2;
+        hitDistance = std::numeric_limits<float>::max();
+        if (t1 >= 0 && y1 >= -height / 2.0f && y1 <= height / 2.0f) hitDistance = t1;
+        if (t2 >= 0 && y2 >= -height / 2.0f && y2 <= height / 2.0f && t2 < hitDistance) hitDistance = t2;
+        if (intersectCap1 && tCap1 < hitDistance) hitDistance = tCap1;
+        if (intersectCap2 && tCap2 < hitDistance) hitDistance = tCap2;
+
+        return hitDistance < std::numeric_limits<float>::max() && hitDistance <= maxDistance;
+    }
 
-        return distance < std::numeric_limits<float>::max();
+    IDK::AABB getLocalBounds() const override {
+        return {glm::vec3(-radius, -height / 2.0f, -radius), glm::vec3(radius, height / 2.0f, radius)};
     }
 
 
@@ -156,7 +151,7 @@ private:
         glGenBuffers(1, &VBO);
         glGenBuffers(1, &EBO);
 
-        glBindVertexArray(VAO);
+        IDK::Graphics::GLStateCache::Instance().bindVertexArray(VAO);
 
         glBindBuffer(GL_ARRAY_BUFFER, VBO);
         glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(glm::vec3), &vertices[0], GL_STATIC_DRAW);
@@ -168,7 +163,7 @@ private:
         glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void*)0);
         glEnableVertexAttribArray(0);
 
-        glBindVertexArray(0);
+        IDK::Graphics::GLStateCache::Instance().bindVertexArray(0);
     }
 };
 
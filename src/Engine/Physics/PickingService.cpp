@@ -0,0 +1,156 @@
+//
+// Created by SIMEON on 10/17/2026.
+//
+
+#include "PickingService.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "BoxCollider.h"
+#include "CapsuleCollider.h"
+#include "CylinderCollider.h"
+#include "Registry.h"
+#include "SphereCollider.h"
+#include "Transform.h"
+
+namespace IDK
+{
+    namespace
+    {
+        constexpr int AreaRings = 2;
+        constexpr int AreaRingRays = 8;
+    }
+
+    std::optional<PickHit> PickingService::pick(const Ray& ray, float maxDistance) const {
+        const IComponentManager* components = Registry::instance().getComponentManager();
+        if (!components) return std::nullopt;
+
+        std::optional<PickHit> nearest;
+        m_spatialIndex.rayCast(ray.getOrigin(), ray.getDirection(), maxDistance,
+            [&](uint32_t entity, float clip) {
+                const Transform* transform = components->getComponent<Transform>(entity);
+                const Collider* collider = FindCollider(*components, entity);
+                if (!transform || !collider) return clip;
+
+                const glm::mat4& inverse = inverseWorld(entity, *transform);
+                const glm::vec3 origin(inverse * glm::vec4(ray.getOrigin(), 1.0f));
+                const glm::vec3 direction(inverse * glm::vec4(ray.getDirection(), 0.0f));
+
+                float distance;
+                if (!collider->intersectsLocalRay(origin, direction, clip, distance)) return clip;
+
+                nearest = PickHit{entity, distance};
+                // Keep the clip positive so a hit at the origin does not end the walk.
+                return std::max(distance, std::numeric_limits<float>::min());
+            });
+        return nearest;
+    }
+
+    std::optional<PickHit> PickingService::pickScreenArea(const glm::vec2& ndc, const glm::vec2& radius,
+                                                          const std::shared_ptr<Graphics::Camera>& camera) const {
+        if (auto hit = pickScreenPoint(ndc, camera)) return hit;
+
+        const IComponentManager* components = Registry::instance().getComponentManager();
+        if (!components) return std::nullopt;
+
+        std::vector<Ray> rays;
+        rays.reserve(AreaRings * AreaRingRays);
+        for (int ring = 1; ring <= AreaRings; ++ring) {
+            const glm::vec2 ringRadius = radius * (static_cast<float>(ring) / AreaRings);
+            for (int i = 0; i < AreaRingRays; ++i) {
+                // Each ring is turned half a step from the last so their rays interleave.
+                const float angle = 6.2831853f * (static_cast<float>(i) + 0.5f * static_cast<float>(ring - 1)) / AreaRingRays;
+                rays.push_back(Ray::getRayFromScreenPoint(ndc + ringRadius * glm::vec2(std::cos(angle), std::sin(angle)), camera));
+            }
+        }
+
+        m_areaCandidates.clear();
+        for (const Ray& ray : rays) {
+            m_spatialIndex.rayCast(ray.getOrigin(), ray.getDirection(), std::numeric_limits<float>::max(),
+                [&](uint32_t entity, float clip) {
+                    m_areaCandidates.push_back(entity);
+                    return clip;
+                });
+        }
+        std::sort(m_areaCandidates.begin(), m_areaCandidates.end());
+        m_areaCandidates.erase(std::unique(m_areaCandidates.begin(), m_areaCandidates.end()), m_areaCandidates.end());
+
+        m_areaBoxes.clear();
+        m_areaSpheres.clear();
+        m_areaCapsules.clear();
+        m_areaCylinders.clear();
+        for (EntityID entity : m_areaCandidates) {
+            const Transform* transform = components->getComponent<Transform>(entity);
+            if (!transform) continue;
+
+            // In FindCollider's order, so an entity is tested as the same shape.
+            const glm::mat4 model = transform->getModelMatrix();
+            if (m_areaBoxes.add(*components, entity, model)) continue;
+            if (m_areaSpheres.add(*components, entity, model)) continue;
+            if (m_areaCapsules.add(*components, entity, model)) continue;
+            m_areaCylinders.add(*components, entity, model);
+        }
+
+        for (int ring = 0; ring < AreaRings; ++ring) {
+            std::optional<PickHit> nearest;
+            for (int i = 0; i < AreaRingRays; ++i) {
+                const Ray& ray = rays[ring * AreaRingRays + i];
+                m_areaBoxes.raycastNearest(ray, nearest);
+                m_areaSpheres.raycastNearest(ray, nearest);
+                m_areaCapsules.raycastNearest(ray, nearest);
+                m_areaCylinders.raycastNearest(ray, nearest);
+            }
+            if (nearest) return nearest;
+        }
+        return std::nullopt;
+    }
+
+    Collider* PickingService::FindCollider(const IComponentManager& components, EntityID entity) {
+        if (Collider* collider = components.getComponent<BoxCollider>(entity)) return collider;
+        if (Collider* collider = components.getComponent<SphereCollider>(entity)) return collider;
+        if (Collider* collider = components.getComponent<CapsuleCollider>(entity)) return collider;
+        return components.getComponent<CylinderCollider>(entity);
+    }
+
+    const glm::mat4& PickingService::inverseWorld(EntityID entity, const Transform& transform) const {
+        if (entity >= m_inverseWorld.size())
+            m_inverseWorld.resize(entity + 1);
+
+        CachedInverse& cached = m_inverseWorld[entity];
+        if (cached.transform != &transform || cached.version != transform.getVersion()) {
+            cached.transform = &transform;
+            cached.version = transform.getVersion();
+            cached.inverse = glm::inverse(transform.getModelMatrix());
+        }
+        return cached.inverse;
+    }
+
+    template<typename ColliderType>
+    void PickingService::AreaBatch<ColliderType>::clear() {
+        colliders.clear();
+        entities.clear();
+    }
+
+    template<typename ColliderType>
+    bool PickingService::AreaBatch<ColliderType>::add(const IComponentManager& components, EntityID entity,
+                                                      const glm::mat4& model) {
+        const ColliderType* collider = components.getComponent<ColliderType>(entity);
+        if (!collider) return false;
+
+        colliders.add(*collider, model);
+        entities.push_back(entity);
+        return true;
+    }
+
+    template<typename ColliderType>
+    void PickingService::AreaBatch<ColliderType>::raycastNearest(const Ray& ray, std::optional<PickHit>& nearest) const {
+        if (entities.empty()) return;
+
+        float distance;
+        const int32_t index = colliders.raycastNearest(ray.getOrigin(), ray.getDirection(),
+                                                       nearest ? nearest->distance : std::numeric_limits<float>::max(), distance);
+        if (index >= 0 && (!nearest || distance < nearest->distance))
+            nearest = PickHit{entities[index], distance};
+    }
+}
@@ -0,0 +1,94 @@
+//
+// Created by SIMEON on 10/17/2026.
+//
+
+#ifndef PICKINGSERVICE_H
+#define PICKINGSERVICE_H
+
+#include <limits>
+#include <memory>
+#include <optional>
+#include <vector>
+#include "glm.hpp"
+#include "ColliderBatch.h"
+#include "Common.h"
+#include "DynamicAABBTree.h"
+#include "Ray.h"
+
+class Collider;
+class IComponentManager;
+class Transform;
+
+namespace IDK
+{
+    struct PickHit {
+        EntityID entity;
+        float distance; // along the ray, in units of its direction
+    };
+
+    // Scene-view picking: the spatial index narrows the ray to the few
+    // proxies it passes through, nearest first, and only those reach the
+    // collider tests. Inverse world matrices are cached per transform and
+    // recomputed only when the transform's version changes.
+    class PickingService
+    {
+    public:
+        explicit PickingService(const DynamicAABBTree& spatialIndex) : m_spatialIndex(spatialIndex) {}
+
+        std::optional<PickHit> pick(const Ray& ray, float maxDistance = std::numeric_limits<float>::max()) const;
+
+        // ndc in [-1, 1], y up.
+        std::optional<PickHit> pickScreenPoint(const glm::vec2& ndc, const std::shared_ptr<Graphics::Camera>& camera) const {
+            return pick(Ray::getRayFromScreenPoint(ndc, camera));
+        }
+
+        // Like pickScreenPoint, but when the ray under the cursor misses,
+        // two rings of rays out to radius (ndc units per axis) are tried, so
+        // thin or distant colliders can be clicked without pixel precision.
+        // A hit on the inner ring wins over the outer one.
+        std::optional<PickHit> pickScreenArea(const glm::vec2& ndc, const glm::vec2& radius,
+                                              const std::shared_ptr<Graphics::Camera>& camera) const;
+
+        void forget(EntityID entity) {
+            if (entity < m_inverseWorld.size()) m_inverseWorld[entity] = {};
+        }
+        void clearCache() { m_inverseWorld.clear(); }
+
+        // The component pools are keyed by concrete type, so a collider is
+        // looked up under each shape it can be.
+        static Collider* FindCollider(const IComponentManager& components, EntityID entity);
+
+    private:
+        struct CachedInverse {
+            const Transform* transform = nullptr;
+            uint32_t version = 0;
+            glm::mat4 inverse;
+        };
+
+        // The colliders of one shape that some ring ray passes near, so every
+        // ray tests them in one batch instead of a virtual call each.
+        template<typename ColliderType>
+        struct AreaBatch {
+            ColliderBatch<ColliderType> colliders;
+            std::vector<EntityID> entities; // by batch index
+
+            void clear();
+            bool add(const IComponentManager& components, EntityID entity, const glm::mat4& model);
+            void raycastNearest(const Ray& ray, std::optional<PickHit>& nearest) const;
+        };
+
+        const glm::mat4& inverseWorld(EntityID entity, const Transform& transform) const;
+
+        const DynamicAABBTree& m_spatialIndex;
+        mutable std::vector<CachedInverse> m_inverseWorld; // indexed by id; the registry hands them out densely
+
+        // pickScreenArea scratch, kept to reuse the allocations.
+        mutable std::vector<EntityID> m_areaCandidates;
+        mutable AreaBatch<BoxCollider> m_areaBoxes;
+        mutable AreaBatch<SphereCollider> m_areaSpheres;
+        mutable AreaBatch<CapsuleCollider> m_areaCapsules;
+        mutable AreaBatch<CylinderCollider> m_areaCylinders;
+    };
+}
+
+#endif //PICKINGSERVICE_H
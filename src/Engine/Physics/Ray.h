@@ -6,8 +6,6 @@
 #define CORE_RAY_H
 
 #include "glm.hpp"
-#include <iostream>
-#include "gtx/string_cast.hpp"
 #include "Camera.h"
 
 class Ray {
@@ -9,6 +9,7 @@
 #include <glad/glad.h>
 #include <vector>
 #include "Shader.h"
+#include "GLStateCache.h"
 
 #include "Collider.h"
 
@@ -28,28 +29,22 @@ public:
 
     ~SphereCollider() override {}
 
+    const glm::vec3& getCenter() const { return m_center; }
+    float getRadius() const { return m_radius; }
+
     void updateModelMatrix() {
         m_modelMatrix = glm::translate(glm::mat4(1.0f), m_position);
      }
-    bool intersectsRay(const Ray &ray, const glm::mat4 &transformMatrix, float distance) override {
-        glm::vec3 worldCenter = glm::vec3(transformMatrix * glm::vec4(m_center, 1.0f));
-
-        // Extract scaling factors from the transform matrix
-        float scaleX = glm::length(glm::vec3(transformMatrix[0]));
-        float scaleY = glm::length(glm::vec3(transformMatrix[1]));
-        float scaleZ = glm::length(glm::vec3(transformMatrix[2]));
-
-        // Compute the maximum scaling factor to scale the radius
-        float maxScale = std::max(scaleX, std::max(scaleY, scaleZ));
-        float worldRadius = m_radius * maxScale;
-
-        // Calculate the vector from the ray origin to the sphere center
-        glm::vec3 oc = ray.m_origin - worldCenter;
+    bool intersectsLocalRay(const glm::vec3& origin, const glm::vec3& direction,
+                            float maxDistance, float& hitDistance) const override {
+        // In local space a scaled sphere is still a sphere, so non-uniform
+        // scale is handled exactly.
+        glm::vec3 oc = origin - m_center;
 
         // Calculate coefficients of the quadratic equation
-        float a = glm::dot(ray.m_direction, ray.m_direction);
-        float b = 2.0f * glm::dot(oc, ray.m_direction);
-        float c = glm::dot(oc, oc) - worldRadius * worldRadius;
+        float a = glm::dot(direction, direction);
+        float b = 2.0f * glm::dot(oc, direction);
+        float c = glm::dot(oc, oc) - m_radius * m_radius;
 
         // Calculate the discriminant
         float discriminant = b * b - 4.0f * a * c;
@@ -62,13 +57,14 @@ public:
         float t0 = (-b - sqrtDiscriminant) / (2.0f * a);
         float t1 = (-b + sqrtDiscriminant) / (2.0f * a);
 
-        // Return true if either of the intersection points is within the distance
-        if ((t0 >= 0.0f && t0 <= distance) || (t1 >= 0.0f && t1 <= distance)) {
-            return true;
-        }
-
-        return false;
+        // Nearest point in front of the origin, or the origin itself from inside
+        if (t1 < 0.0f) return false;
+        hitDistance = std::max(t0, 0.0f);
+        return hitDistance <= maxDistance;
+    }
 
+    IDK::AABB getLocalBounds() const override {
+        return {m_center - m_radius, m_center + m_radius};
     }
 
     void SetupMesh(float radius, int resolution) {
@@ -90,7 +86,7 @@ public:
         glGenVertexArrays(1, &VAO);
         glGenBuffers(1, &VBO);
 
-        glBindVertexArray(VAO);
+        IDK::Graphics::GLStateCache::Instance().bindVertexArray(VAO);
 
         glBindBuffer(GL_ARRAY_BUFFER, VBO);
         glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(SphereColVertex), &vertices[0], GL_STATIC_DRAW);
@@ -98,15 +94,14 @@ public:
         glEnableVertexAttribArray(0);
         glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(SphereColVertex), (void*)0);
 
-        glBindVertexArray(0);
+        IDK::Graphics::GLStateCache::Instance().bindVertexArray(0);
     }
 
     void Draw(IDK::Graphics::Shader &wireframe) override {
         if(sphereCollider) {
             wireframe.Use();
-            glBindVertexArray(VAO);
+            IDK::Graphics::GLStateCache::Instance().bindVertexArray(VAO);
             glDrawArrays(GL_LINES, 0, static_cast<GLsizei>(vertices.size()));
-            glBindVertexArray(0);
         }
     }
 
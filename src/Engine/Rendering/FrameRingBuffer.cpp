@@ -0,0 +1,144 @@
+//
+// Created by SIMEON on 10/17/2026.
+//
+
+#include "FrameRingBuffer.h"
+
+#include <algorithm>
+#include <iostream>
+
+namespace
+{
+    size_t AlignUp(size_t value, size_t alignment) {
+        return (value + alignment - 1) / alignment * alignment;
+    }
+
+    // Instance data is addressed by base instance, so regions must start on a
+    // multiple of the largest element type streamed through the ring (mat4).
+    constexpr size_t RegionAlignment = 256;
+}
+
+namespace IDK::Graphics
+{
+    FrameRingBuffer::FrameRingBuffer(size_t bytesPerFrame)
+        : m_frameCapacity(AlignUp(std::max<size_t>(bytesPerFrame, 64u << 10), RegionAlignment)) {}
+
+    FrameRingBuffer::~FrameRingBuffer() {
+        waitIdle();
+        unmap();
+        if (m_buffer) glDeleteBuffers(1, &m_buffer);
+    }
+
+    void FrameRingBuffer::create(size_t bytesPerFrame) {
+        GLint alignment = 0;
+        glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment);
+        m_uniformAlignment = std::max<size_t>(static_cast<size_t>(alignment), 16);
+        glGetIntegerv(GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT, &alignment);
+        m_storageAlignment = std::max<size_t>(static_cast<size_t>(alignment), 16);
+
+        m_frameCapacity = AlignUp(bytesPerFrame, RegionAlignment);
+        const GLsizeiptr totalBytes = static_cast<GLsizeiptr>(m_frameCapacity * FramesInFlight);
+        constexpr GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+        glGenBuffers(1, &m_buffer);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, m_buffer);
+        glBufferStorage(GL_COPY_WRITE_BUFFER, totalBytes, nullptr, flags);
+        m_mapped = static_cast<uint8_t*>(glMapBufferRange(GL_COPY_WRITE_BUFFER, 0, totalBytes, flags));
+        glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+        if (!m_mapped)
+            std::cerr << "[FrameRingBuffer] Persistent mapping of " << totalBytes << " bytes failed." << std::endl;
+
+        m_stats.capacity = m_mapped ? m_frameCapacity : 0;
+    }
+
+    void FrameRingBuffer::waitIdle() {
+        for (GLsync& fence : m_fences) {
+            if (fence) {
+                glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, GL_TIMEOUT_IGNORED);
+                glDeleteSync(fence);
+                fence = nullptr;
+            }
+        }
+    }
+
+    void FrameRingBuffer::unmap() {
+        if (m_buffer && m_mapped) {
+            glBindBuffer(GL_COPY_WRITE_BUFFER, m_buffer);
+            glUnmapBuffer(GL_COPY_WRITE_BUFFER);
+            glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+        }
+        m_mapped = nullptr;
+    }
+
+    void FrameRingBuffer::beginFrame() {
+        // When the last frame asked for more than a region holds, the buffer is
+        // replaced once the GPU is done with every region.
+        const size_t overflow = m_overflow.exchange(0);
+        if (m_buffer == 0 || overflow > 0) {
+            size_t size = m_frameCapacity;
+            if (m_buffer != 0) {
+                const size_t required = m_stats.bytesUsed + overflow;
+                size = std::max(required + required / 2, m_frameCapacity * 2);
+                std::cout << "[FrameRingBuffer] Growing to " << size << " bytes per frame." << std::endl;
+            }
+            waitIdle();
+            unmap();
+
+            // The new buffer is created before the old one is deleted so it
+            // cannot get the old name back: meshes remember which buffer their
+            // instance attributes point at.
+            const GLuint retired = m_buffer;
+            create(size);
+            if (retired) glDeleteBuffers(1, &retired);
+            m_frame = 0;
+        }
+
+        GLsync& fence = m_fences[m_frame];
+        if (fence) {
+            GLenum result = glClientWaitSync(fence, 0, 0);
+            if (result == GL_TIMEOUT_EXPIRED) {
+                ++m_stats.fenceWaits;
+                result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, GL_TIMEOUT_IGNORED);
+            }
+            if (result == GL_WAIT_FAILED)
+                std::cerr << "[FrameRingBuffer] Fence wait failed." << std::endl;
+            glDeleteSync(fence);
+            fence = nullptr;
+        }
+
+        m_frameBase = static_cast<size_t>(m_frame) * m_frameCapacity;
+        m_offset.store(0, std::memory_order_relaxed);
+        m_inFrame = m_mapped != nullptr;
+    }
+
+    void FrameRingBuffer::endFrame() {
+        if (!m_inFrame) return;
+
+        m_fences[m_frame] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        m_stats.bytesUsed = std::min(m_offset.load(std::memory_order_relaxed), m_frameCapacity);
+        m_stats.overflowed = m_overflow.load(std::memory_order_relaxed);
+        m_frame = (m_frame + 1) % FramesInFlight;
+        m_inFrame = false;
+    }
+
+    // Bump allocation with a compare-exchange loop, so concurrent callers each
+    // get a disjoint, aligned range without taking a lock.
+    RingAllocation FrameRingBuffer::allocate(size_t bytes, size_t alignment) {
+        if (!m_inFrame || bytes == 0) return {};
+
+        size_t offset = m_offset.load(std::memory_order_relaxed);
+        size_t aligned, end;
+        do {
+            aligned = AlignUp(offset, alignment);
+            end = aligned + bytes;
+            if (end > m_frameCapacity) {
+                m_overflow.fetch_add(bytes + alignment, std::memory_order_relaxed);
+                return {};
+            }
+        } while (!m_offset.compare_exchange_weak(offset, end, std::memory_order_relaxed));
+
+        const size_t position = m_frameBase + aligned;
+        return {m_mapped + position, static_cast<GLintptr>(position), static_cast<GLsizeiptr>(bytes)};
+    }
+}
@@ -0,0 +1,88 @@
+//
+// Created by SIMEON on 10/17/2026.
+//
+
+#ifndef FRAMERINGBUFFER_H
+#define FRAMERINGBUFFER_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include "glad/glad.h"
+
+namespace IDK::Graphics
+{
+    // A piece of the current frame's region. data stays writable until the
+    // frame ends; bind it with glBindBufferRange(target, index, buffer, offset, size).
+    struct RingAllocation {
+        void* data = nullptr;
+        GLintptr offset = 0;
+        GLsizeiptr size = 0;
+
+        explicit operator bool() const { return data != nullptr; }
+    };
+
+    struct RingStats {
+        size_t bytesUsed = 0;     // allocated in the last finished frame
+        size_t overflowed = 0;    // bytes refused in the last finished frame
+        size_t fenceWaits = 0;    // frames that had to wait for the GPU, since creation
+        size_t capacity = 0;      // per frame
+    };
+
+    // Streaming buffer for per-frame data: one persistently mapped, coherent
+    // buffer split into FramesInFlight regions. Each frame writes its own
+    // region while the GPU may still be reading the previous ones, and a fence
+    // per region makes beginFrame() block only when the GPU is a full ring
+    // behind. Nothing is mapped, orphaned or reallocated per frame.
+    //
+    // allocate() is lock-free and may be called from worker threads between
+    // beginFrame() and endFrame(); all GL calls stay on the render thread. A
+    // request that does not fit fails, and the next beginFrame() grows the
+    // buffer to what the frame asked for.
+    class FrameRingBuffer
+    {
+    public:
+        static constexpr uint32_t FramesInFlight = 3;
+
+        explicit FrameRingBuffer(size_t bytesPerFrame = 4u << 20);
+        ~FrameRingBuffer();
+
+        FrameRingBuffer(const FrameRingBuffer&) = delete;
+        FrameRingBuffer& operator=(const FrameRingBuffer&) = delete;
+
+        // Render thread. Creates the buffer on first use.
+        void beginFrame();
+        // Render thread, after the last command that reads this frame's data.
+        void endFrame();
+
+        RingAllocation allocate(size_t bytes, size_t alignment);
+
+        GLuint getBuffer() const { return m_buffer; }
+        // Alignments to pass to allocate() for UBO and SSBO ranges.
+        size_t getUniformAlignment() const { return m_uniformAlignment; }
+        size_t getStorageAlignment() const { return m_storageAlignment; }
+        const RingStats& getStats() const { return m_stats; }
+
+    private:
+        void create(size_t bytesPerFrame);
+        void waitIdle();
+        void unmap();
+
+        GLuint m_buffer = 0;
+        uint8_t* m_mapped = nullptr;
+        size_t m_frameCapacity;
+        size_t m_uniformAlignment = 256;
+        size_t m_storageAlignment = 256;
+
+        GLsync m_fences[FramesInFlight] = {};
+        uint32_t m_frame = 0;  // region being written
+        size_t m_frameBase = 0;
+        bool m_inFrame = false;
+
+        std::atomic<size_t> m_offset{0};
+        std::atomic<size_t> m_overflow{0};
+        RingStats m_stats;
+    };
+}
+
+#endif //FRAMERINGBUFFER_H
@@ -0,0 +1,175 @@
+//
+// Created by SIMEON on 10/17/2026.
+//
+
+#include "FrustumCulling.h"
+
+#include <cmath>
+
+#if defined(__AVX__)
+    #include <immintrin.h>
+    #define IDK_CULL_AVX 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define IDK_CULL_SSE 1
+#endif
+
+namespace IDK::Graphics
+{
+    namespace
+    {
+        // Plane terms in the form the kernels consume: n, |n| and w.
+        struct CullPlane {
+            float nx, ny, nz, w;
+            float ax, ay, az;
+        };
+
+        void preparePlanes(const Frustum& frustum, CullPlane (&planes)[6]) {
+            for (int p = 0; p < 6; ++p) {
+                const glm::vec4& plane = frustum.planes[p];
+                planes[p] = {plane.x, plane.y, plane.z, plane.w,
+                             std::abs(plane.x), std::abs(plane.y), std::abs(plane.z)};
+            }
+        }
+    }
+
+    Frustum Frustum::FromMatrix(const glm::mat4& m) {
+        // glm is column-major: row r of the matrix is (m[0][r], m[1][r], m[2][r], m[3][r]).
+        const glm::vec4 row0(m[0][0], m[1][0], m[2][0], m[3][0]);
+        const glm::vec4 row1(m[0][1], m[1][1], m[2][1], m[3][1]);
+        const glm::vec4 row2(m[0][2], m[1][2], m[2][2], m[3][2]);
+        const glm::vec4 row3(m[0][3], m[1][3], m[2][3], m[3][3]);
+
+        Frustum frustum;
+        frustum.planes[0] = row3 + row0;
+        frustum.planes[1] = row3 - row0;
+        frustum.planes[2] = row3 + row1;
+        frustum.planes[3] = row3 - row1;
+        frustum.planes[4] = row3 + row2;
+        frustum.planes[5] = row3 - row2;
+
+        for (glm::vec4& plane : frustum.planes)
+            plane /= glm::length(glm::vec3(plane));
+        return frustum;
+    }
+
+    void FrustumCuller::clear() {
+        m_centerX.clear(); m_centerY.clear(); m_centerZ.clear();
+        m_extentX.clear(); m_extentY.clear(); m_extentZ.clear();
+        m_count = 0;
+    }
+
+    void FrustumCuller::reserve(size_t count) {
+        for (std::vector<float>* array : {&m_centerX, &m_centerY, &m_centerZ, &m_extentX, &m_extentY, &m_extentZ})
+            array->reserve(count);
+    }
+
+    uint32_t FrustumCuller::add(const AABB& bounds) {
+        const glm::vec3 center = bounds.center();
+        const glm::vec3 extents = bounds.extents();
+
+        m_centerX.push_back(center.x);
+        m_centerY.push_back(center.y);
+        m_centerZ.push_back(center.z);
+        m_extentX.push_back(extents.x);
+        m_extentY.push_back(extents.y);
+        m_extentZ.push_back(extents.z);
+        return static_cast<uint32_t>(m_count++);
+    }
+
+    void FrustumCuller::cull(const Frustum& frustum, std::vector<uint8_t>& visible) const {
+        classify(frustum, visible);
+
+        size_t visibleCount = 0;
+        for (const uint8_t flag : visible)
+            visibleCount += flag;
+        s_stats.visible += visibleCount;
+        s_stats.culled += m_count - visibleCount;
+    }
+
+    void FrustumCuller::classify(const Frustum& frustum, std::vector<uint8_t>& visible) const {
+        visible.resize(m_count);
+        if (m_count == 0) return;
+
+        CullBoxes(frustum, m_centerX.data(), m_centerY.data(), m_centerZ.data(),
+                  m_extentX.data(), m_extentY.data(), m_extentZ.data(), m_count, visible.data());
+    }
+
+    void FrustumCuller::CullBoxes(const Frustum& frustum,
+                                  const float* centerX, const float* centerY, const float* centerZ,
+                                  const float* extentX, const float* extentY, const float* extentZ,
+                                  size_t count, uint8_t* visible) {
+        CullPlane planes[6];
+        preparePlanes(frustum, planes);
+
+        // A box is outside when it lies fully behind any plane:
+        // dot(n, center) + w + dot(|n|, extents) < 0.
+        size_t i = 0;
+
+#if defined(IDK_CULL_AVX)
+        const __m256 zero = _mm256_setzero_ps();
+        for (; i + 8 <= count; i += 8) {
+            const __m256 cx = _mm256_loadu_ps(centerX + i);
+            const __m256 cy = _mm256_loadu_ps(centerY + i);
+            const __m256 cz = _mm256_loadu_ps(centerZ + i);
+            const __m256 ex = _mm256_loadu_ps(extentX + i);
+            const __m256 ey = _mm256_loadu_ps(extentY + i);
+            const __m256 ez = _mm256_loadu_ps(extentZ + i);
+
+            __m256 outside = zero;
+            for (const CullPlane& plane : planes) {
+                __m256 distance = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(plane.nx), cx), _mm256_set1_ps(plane.w));
+                distance = _mm256_add_ps(distance, _mm256_mul_ps(_mm256_set1_ps(plane.ny), cy));
+                distance = _mm256_add_ps(distance, _mm256_mul_ps(_mm256_set1_ps(plane.nz), cz));
+
+                __m256 radius = _mm256_mul_ps(_mm256_set1_ps(plane.ax), ex);
+                radius = _mm256_add_ps(radius, _mm256_mul_ps(_mm256_set1_ps(plane.ay), ey));
+                radius = _mm256_add_ps(radius, _mm256_mul_ps(_mm256_set1_ps(plane.az), ez));
+
+                outside = _mm256_or_ps(outside, _mm256_cmp_ps(_mm256_add_ps(distance, radius), zero, _CMP_LT_OQ));
+            }
+
+            const int mask = _mm256_movemask_ps(outside);
+            for (int lane = 0; lane < 8; ++lane)
+                visible[i + lane] = static_cast<uint8_t>(((mask >> lane) & 1) ^ 1);
+        }
+#elif defined(IDK_CULL_SSE)
+        const __m128 zero = _mm_setzero_ps();
+        for (; i + 4 <= count; i += 4) {
+            const __m128 cx = _mm_loadu_ps(centerX + i);
+            const __m128 cy = _mm_loadu_ps(centerY + i);
+            const __m128 cz = _mm_loadu_ps(centerZ + i);
+            const __m128 ex = _mm_loadu_ps(extentX + i);
+            const __m128 ey = _mm_loadu_ps(extentY + i);
+            const __m128 ez = _mm_loadu_ps(extentZ + i);
+
+            __m128 outside = zero;
+            for (const CullPlane& plane : planes) {
+                __m128 distance = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(plane.nx), cx), _mm_set1_ps(plane.w));
+                distance = _mm_add_ps(distance, _mm_mul_ps(_mm_set1_ps(plane.ny), cy));
+                distance = _mm_add_ps(distance, _mm_mul_ps(_mm_set1_ps(plane.nz), cz));
+
+                __m128 radius = _mm_mul_ps(_mm_set1_ps(plane.ax), ex);
+                radius = _mm_add_ps(radius, _mm_mul_ps(_mm_set1_ps(plane.ay), ey));
+                radius = _mm_add_ps(radius, _mm_mul_ps(_mm_set1_ps(plane.az), ez));
+
+                outside = _mm_or_ps(outside, _mm_cmplt_ps(_mm_add_ps(distance, radius), zero));
+            }
+
+            const int mask = _mm_movemask_ps(outside);
+            for (int lane = 0; lane < 4; ++lane)
+                visible[i + lane] = static_cast<uint8_t>(((mask >> lane) & 1) ^ 1);
+        }
+#endif
+
+        for (; i < count; ++i) {
+            bool outside = false;
+            for (const CullPlane& plane : planes) {
+                const float distance = plane.nx * centerX[i] + plane.ny * centerY[i] + plane.nz * centerZ[i] + plane.w;
+                const float radius = plane.ax * extentX[i] + plane.ay * extentY[i] + plane.az * extentZ[i];
+                outside |= distance + radius < 0.0f;
+            }
+            visible[i] = outside ? 0 : 1;
+        }
+    }
+}
@@ -0,0 +1,69 @@
+//
+// Created by SIMEON on 10/17/2026.
+//
+
+#ifndef FRUSTUMCULLING_H
+#define FRUSTUMCULLING_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "glm.hpp"
+#include "Bounds.h"
+
+namespace IDK::Graphics
+{
+    // Six normalized planes (left, right, bottom, top, near, far) with normals
+    // pointing inside: a point p is inside a plane when dot(n, p) + w >= 0.
+    struct Frustum {
+        glm::vec4 planes[6];
+
+        // Gribb-Hartmann extraction from projection * view.
+        static Frustum FromMatrix(const glm::mat4& viewProjection);
+    };
+
+    struct CullingStats {
+        size_t visible = 0;
+        size_t culled = 0;
+    };
+
+    // Frustum vs. world AABB culling over boxes stored structure-of-arrays,
+    // 8 per instruction with AVX, 4 with SSE, with a scalar fallback.
+    // Conservative: boxes crossing a plane count as visible.
+    class FrustumCuller
+    {
+    public:
+        void clear();
+        void reserve(size_t count);
+
+        // Returns the box's index into the visibility results.
+        uint32_t add(const AABB& bounds);
+        size_t size() const { return m_count; }
+
+        // visible[i] becomes 1 for every box i that may be on screen, else 0.
+        void cull(const Frustum& frustum, std::vector<uint8_t>& visible) const;
+        // Same as cull() but leaves the stats alone, for views other than the
+        // camera's such as shadow cascades.
+        void classify(const Frustum& frustum, std::vector<uint8_t>& visible) const;
+
+        // Kernel over raw SoA arrays of box centers and half-extents; leftover
+        // boxes that do not fill a vector go through the scalar path.
+        static void CullBoxes(const Frustum& frustum,
+                              const float* centerX, const float* centerY, const float* centerZ,
+                              const float* extentX, const float* extentY, const float* extentZ,
+                              size_t count, uint8_t* visible);
+
+        // Accumulated over every cull() call until reset, like the uniform stats.
+        static CullingStats GetStats() { return s_stats; }
+        static void ResetStats() { s_stats = {}; }
+
+    private:
+        std::vector<float> m_centerX, m_centerY, m_centerZ;
+        std::vector<float> m_extentX, m_extentY, m_extentZ;
+        size_t m_count = 0;
+
+        static inline CullingStats s_stats;
+    };
+}
+
+#endif //FRUSTUMCULLING_H
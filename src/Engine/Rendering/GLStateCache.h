@@ -0,0 +1,154 @@
+//
+// Created by SIMEON on 10/17/2026.
+//
+
+#ifndef GLSTATECACHE_H
+#define GLSTATECACHE_H
+
+#include <cstddef>
+#include <cstdint>
+#include "glad/glad.h"
+
+namespace IDK::Graphics
+{
+    // Shadows the GL state the scene passes touch and drops calls that would
+    // not change it. Only valid on the thread that owns the context; call
+    // invalidate() whenever code outside the cache may have changed the state
+    // (ImGui, framebuffer rebuilds).
+    class GLStateCache
+    {
+    public:
+        struct Stats
+        {
+            size_t issued = 0;
+            size_t skipped = 0;
+        };
+
+        static constexpr GLuint MaxTextureUnits = 16;
+
+        static GLStateCache& Instance() {
+            static GLStateCache instance;
+            return instance;
+        }
+
+        void useProgram(GLuint program) {
+            if (!changed(m_program, program)) return;
+            glUseProgram(program);
+        }
+
+        void bindVertexArray(GLuint vao) {
+            if (!changed(m_vertexArray, vao)) return;
+            glBindVertexArray(vao);
+        }
+
+        void bindTexture(GLuint unit, GLenum target, GLuint texture) {
+            if (unit >= MaxTextureUnits) {
+                ++m_stats.issued;
+                activeTexture(unit);
+                glBindTexture(target, texture);
+                return;
+            }
+
+            TextureBinding& binding = m_textures[unit];
+            if (binding.target == target && binding.texture == texture) {
+                ++m_stats.skipped;
+                return;
+            }
+
+            activeTexture(unit);
+            glBindTexture(target, texture);
+            ++m_stats.issued;
+            binding = {target, texture};
+        }
+
+        void setBlend(bool enabled)     { setCapability(m_blend, GL_BLEND, enabled); }
+        void setDepthTest(bool enabled) { setCapability(m_depthTest, GL_DEPTH_TEST, enabled); }
+        void setCullFace(bool enabled)  { setCapability(m_cullFace, GL_CULL_FACE, enabled); }
+
+        void setDepthMask(bool enabled) {
+            if (!changed(m_depthMask, static_cast<int8_t>(enabled ? 1 : 0))) return;
+            glDepthMask(enabled ? GL_TRUE : GL_FALSE);
+        }
+
+        // Front and back faces always share a mode in this engine.
+        void setPolygonMode(GLenum mode) {
+            if (!changed(m_polygonMode, mode)) return;
+            glPolygonMode(GL_FRONT_AND_BACK, mode);
+        }
+
+        // Deleting a bound object resets the binding to 0 and frees its name for reuse.
+        void forgetVertexArray(GLuint vao) {
+            if (m_vertexArray == vao) m_vertexArray = Unknown;
+        }
+
+        void forgetTexture(GLuint texture) {
+            for (TextureBinding& binding : m_textures) {
+                if (binding.texture == texture) binding = {};
+            }
+        }
+
+        void invalidate() {
+            m_program = Unknown;
+            m_vertexArray = Unknown;
+            m_activeUnit = Unknown;
+            m_polygonMode = Unknown;
+            m_blend = m_depthTest = m_cullFace = m_depthMask = -1;
+            for (TextureBinding& binding : m_textures)
+                binding = {};
+        }
+
+        Stats getStats() const { return m_stats; }
+        void resetStats() { m_stats = {}; }
+
+        GLStateCache(const GLStateCache&) = delete;
+        GLStateCache& operator=(const GLStateCache&) = delete;
+
+    private:
+        static constexpr GLuint Unknown = ~0u;
+
+        struct TextureBinding
+        {
+            GLenum target = 0;
+            GLuint texture = Unknown;
+        };
+
+        GLStateCache() = default;
+
+        template<typename T>
+        bool changed(T& shadow, T value) {
+            if (shadow == value) {
+                ++m_stats.skipped;
+                return false;
+            }
+            shadow = value;
+            ++m_stats.issued;
+            return true;
+        }
+
+        // Unit selection is an implementation detail of bindTexture and is not counted.
+        void activeTexture(GLuint unit) {
+            if (m_activeUnit == unit) return;
+            glActiveTexture(GL_TEXTURE0 + unit);
+            m_activeUnit = unit;
+        }
+
+        void setCapability(int8_t& shadow, GLenum capability, bool enabled) {
+            if (!changed(shadow, static_cast<int8_t>(enabled ? 1 : 0))) return;
+            if (enabled) glEnable(capability);
+            else glDisable(capability);
+        }
+
+        GLuint m_program = Unknown;
+        GLuint m_vertexArray = Unknown;
+        GLuint m_activeUnit = Unknown;
+        GLenum m_polygonMode = Unknown;
+        int8_t m_blend = -1;
+        int8_t m_depthTest = -1;
+        int8_t m_cullFace = -1;
+        int8_t m_depthMask = -1;
+        TextureBinding m_textures[MaxTextureUnits];
+        Stats m_stats;
+    };
+}
+
+#endif //GLSTATECACHE_H
@@ -0,0 +1,68 @@
+//
+// Created by SIMEON on 10/17/2026.
+//
+
+#include "InstanceBatcher.h"
+
+#include <functional>
+
+namespace IDK::Graphics
+{
+    size_t InstanceBatcher::BatchKeyHash::operator()(const BatchKey& key) const noexcept {
+        const size_t mesh = std::hash<const void*>()(key.mesh);
+        const size_t shader = std::hash<const void*>()(key.shader);
+        return mesh ^ (shader + 0x9e3779b97f4a7c15ull + (mesh << 6) + (mesh >> 2));
+    }
+
+    void InstanceBatcher::clear() {
+        m_draws.clear();
+        m_drawBatch.clear();
+        m_batches.clear();
+        m_instanceData.clear();
+        m_lookup.clear();
+    }
+
+    void InstanceBatcher::add(const Mesh* mesh, const Shader* shader, const glm::mat4& model) {
+        m_draws.push_back({mesh, shader, model});
+    }
+
+    void InstanceBatcher::build() {
+        m_batches.clear();
+        m_lookup.clear();
+        m_drawBatch.resize(m_draws.size());
+
+        // Count instances per group. Sorted input (see RenderQueue) arrives in
+        // runs, so only the first draw of each run needs the lookup...
+        for (size_t i = 0; i < m_draws.size(); ++i) {
+            const Draw& draw = m_draws[i];
+            if (i > 0 && draw.mesh == m_draws[i - 1].mesh && draw.shader == m_draws[i - 1].shader) {
+                m_drawBatch[i] = m_drawBatch[i - 1];
+                ++m_batches[m_drawBatch[i]].instanceCount;
+                continue;
+            }
+
+            const auto [it, inserted] = m_lookup.try_emplace(BatchKey{draw.mesh, draw.shader},
+                                                             static_cast<uint32_t>(m_batches.size()));
+            if (inserted)
+                m_batches.push_back({draw.mesh, draw.shader, 0, 0});
+
+            m_drawBatch[i] = it->second;
+            ++m_batches[it->second].instanceCount;
+        }
+
+        // ...give each group its range...
+        uint32_t first = 0;
+        for (InstanceBatch& batch : m_batches) {
+            batch.firstInstance = first;
+            first += batch.instanceCount;
+            batch.instanceCount = 0;
+        }
+
+        // ...and scatter the matrices into place.
+        m_instanceData.resize(m_draws.size());
+        for (size_t i = 0; i < m_draws.size(); ++i) {
+            InstanceBatch& batch = m_batches[m_drawBatch[i]];
+            m_instanceData[batch.firstInstance + batch.instanceCount++] = m_draws[i].model;
+        }
+    }
+}
@@ -0,0 +1,71 @@
+//
+// Created by SIMEON on 10/17/2026.
+//
+
+#ifndef INSTANCEBATCHER_H
+#define INSTANCEBATCHER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include "glm.hpp"
+
+namespace IDK::Graphics
+{
+    class Mesh;
+    class Shader;
+
+    // One instanced draw: instanceCount model matrices starting at
+    // firstInstance in the packed instance data.
+    struct InstanceBatch {
+        const Mesh* mesh = nullptr;
+        const Shader* shader = nullptr;
+        uint32_t firstInstance = 0;
+        uint32_t instanceCount = 0;
+    };
+
+    // Groups per-object draws by (mesh, shader) and packs their model matrices
+    // so each group's instances are contiguous. Pure CPU work; the caller
+    // uploads getInstanceData() and issues one instanced draw per batch.
+    // Buffers are kept between frames, so steady-state frames do not allocate.
+    class InstanceBatcher
+    {
+    public:
+        void clear();
+        void add(const Mesh* mesh, const Shader* shader, const glm::mat4& model);
+
+        // Batches come out in order of first submission; instances keep their
+        // submission order within a batch.
+        void build();
+
+        const std::vector<InstanceBatch>& getBatches() const { return m_batches; }
+        const std::vector<glm::mat4>& getInstanceData() const { return m_instanceData; }
+        size_t getInstanceCount() const { return m_draws.size(); }
+
+    private:
+        struct Draw {
+            const Mesh* mesh;
+            const Shader* shader;
+            glm::mat4 model;
+        };
+
+        struct BatchKey {
+            const Mesh* mesh;
+            const Shader* shader;
+            bool operator==(const BatchKey&) const = default;
+        };
+
+        struct BatchKeyHash {
+            size_t operator()(const BatchKey& key) const noexcept;
+        };
+
+        std::vector<Draw> m_draws;
+        std::vector<uint32_t> m_drawBatch;
+        std::vector<InstanceBatch> m_batches;
+        std::vector<glm::mat4> m_instanceData;
+        std::unordered_map<BatchKey, uint32_t, BatchKeyHash> m_lookup;
+    };
+}
+
+#endif //INSTANCEBATCHER_H
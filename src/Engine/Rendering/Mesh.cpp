@@ -3,10 +3,19 @@
 //
 
 #include "Mesh.h"
+#include "GLStateCache.h"
 #include <ext/scalar_constants.hpp>
+#include <cstdint>
 
 namespace IDK::Graphics
 {
+    namespace
+    {
+        const UniformHandle u_positionOffset("positionOffset");
+        const UniformHandle u_positionScale("positionScale");
+        const UniformHandle u_octNormals("octNormals");
+    }
+
     Mesh::Mesh(const Mesh& other, const std::string& newName)
         : AssetItem(
             newName,          // or: std::filesystem::path(newName).stem().string() if you like
@@ -17,6 +26,7 @@ namespace IDK::Graphics
         this->vertices = other.vertices;
         this->indices  = other.indices;
         this->name = newName;
+        this->vertexFormat = other.vertexFormat;
 
         if (!this->vertices.empty()) {
             SetupMesh();
@@ -39,6 +49,7 @@ namespace IDK::Graphics
                 this->vertices.push_back({pos, norm});
             }
 
+            Optimize();
             SetupMesh();
         } else {
             std::cerr << "Warning: Invalid vertex data provided." << std::endl;
@@ -56,6 +67,7 @@ namespace IDK::Graphics
 
     Mesh::~Mesh() {
         if (VAO) {
+            GLStateCache::Instance().forgetVertexArray(VAO);
             glDeleteVertexArrays(1, &VAO);
             VAO = 0;
         }
@@ -70,7 +82,11 @@ namespace IDK::Graphics
     }
 
     void Mesh::SetupMesh() {
-        if (VAO) glDeleteVertexArrays(1, &VAO);
+        geometryId.renew();
+        if (VAO) {
+            GLStateCache::Instance().forgetVertexArray(VAO);
+            glDeleteVertexArrays(1, &VAO);
+        }
         if (VBO) glDeleteBuffers(1, &VBO);
         if (EBO) glDeleteBuffers(1, &EBO);
 
@@ -81,54 +97,146 @@ namespace IDK::Graphics
 
         glGenVertexArrays(1, &VAO);
         glGenBuffers(1, &VBO);
+        instanceBuffer = 0;
         if (!indices.empty()) {
             glGenBuffers(1, &EBO);
         }
 
-        glBindVertexArray(VAO);
+        GLStateCache::Instance().bindVertexArray(VAO);
 
         glBindBuffer(GL_ARRAY_BUFFER, VBO);
-        glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(Vertex), vertices.data(), GL_STATIC_DRAW);
+        gpuBytes = vertices.size() * VertexCompression::VertexStride(vertexFormat);
+
+        localBounds = {};
+        for (const Vertex& vertex : vertices)
+            localBounds.expand(vertex.position);
+
+        if (VertexCompression::IsCompact(vertexFormat)) {
+            quantization = VertexCompression::ComputeQuantization(localBounds.min, localBounds.max);
+
+            std::vector<CompactVertex, IDK::MeshPoolAllocator<CompactVertex>> compact;
+            compact.reserve(vertices.size());
+            for (const Vertex& vertex : vertices)
+                compact.push_back(VertexCompression::Encode(vertex.position, vertex.normal, quantization, vertexFormat));
+
+            glBufferData(GL_ARRAY_BUFFER, compact.size() * sizeof(CompactVertex), compact.data(), GL_STATIC_DRAW);
+
+            // Positions (bounds-relative, rescaled in basic.vert)
+            if (vertexFormat == VertexFormat::CompactHalf)
+                glVertexAttribPointer(0, 3, GL_HALF_FLOAT, GL_FALSE, sizeof(CompactVertex), (void*)offsetof(CompactVertex, position));
+            else
+                glVertexAttribPointer(0, 3, GL_SHORT, GL_TRUE, sizeof(CompactVertex), (void*)offsetof(CompactVertex, position));
+            glEnableVertexAttribArray(0);
+            // Normals (octahedral)
+            glVertexAttribPointer(1, 2, GL_SHORT, GL_TRUE, sizeof(CompactVertex), (void*)offsetof(CompactVertex, normal));
+            glEnableVertexAttribArray(1);
+        } else {
+            quantization = PositionQuantization{};
+            glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(Vertex), vertices.data(), GL_STATIC_DRAW);
+
+            // Positions
+            glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, position));
+            glEnableVertexAttribArray(0);
+            // Normals
+            glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, normal));
+            glEnableVertexAttribArray(1);
+        }
 
         if (!indices.empty()) {
             glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
-            glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int), indices.data(), GL_STATIC_DRAW);
-        }
 
-        // Positions
-        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, position));
-        glEnableVertexAttribArray(0);
-        // Normals
-        glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, normal));
-        glEnableVertexAttribArray(1);
+            if (VertexCompression::FitsUInt16Indices(vertices.size())) {
+                std::vector<uint16_t, IDK::MeshPoolAllocator<uint16_t>> shortIndices(indices.begin(), indices.end());
+                glBufferData(GL_ELEMENT_ARRAY_BUFFER, shortIndices.size() * sizeof(uint16_t), shortIndices.data(), GL_STATIC_DRAW);
+                indexType = GL_UNSIGNED_SHORT;
+                gpuBytes += shortIndices.size() * sizeof(uint16_t);
+            } else {
+                glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int), indices.data(), GL_STATIC_DRAW);
+                indexType = GL_UNSIGNED_INT;
+                gpuBytes += indices.size() * sizeof(unsigned int);
+            }
+        }
 
         glBindBuffer(GL_ARRAY_BUFFER, 0);
-        glBindVertexArray(0);
+        GLStateCache::Instance().bindVertexArray(0);
 
 
         std::cout << "Mesh is setup for object (" << name << ")" << std::endl;
     }
+    void Mesh::setVertexFormat(VertexFormat format) {
+        if (vertexFormat == format) return;
+
+        vertexFormat = format;
+        if (VAO)
+            SetupMesh();
+    }
+
+    void Mesh::Optimize() {
+        if (vertices.empty()) return;
+
+        MeshOptimizer::Report report;
+        report.verticesBefore = vertices.size();
+
+        if (indices.empty()) {
+            report.before.acmr = 3.0f;
+            report.before.atvr = 1.0f;
+        } else {
+            report.before = MeshOptimizer::AnalyzeVertexCache(indices.data(), indices.size(), vertices.size());
+        }
+
+        std::vector<unsigned int> remap;
+        size_t vertexCount = MeshOptimizer::BuildWeldRemap(remap, vertices.data(), vertices.size(), sizeof(Vertex),
+                                                           indices.empty() ? nullptr : indices.data(), indices.size());
+        if (indices.empty()) {
+            indices.assign(remap.begin(), remap.end());
+        } else {
+            for (unsigned int& index : indices)
+                index = remap[index];
+        }
+        MeshOptimizer::RemapVertices(vertices, remap, vertexCount);
+
+        MeshOptimizer::OptimizeVertexCache(indices.data(), indices.size(), vertices.size());
+
+        vertexCount = MeshOptimizer::BuildFetchRemap(remap, indices.data(), indices.size(), vertices.size());
+        for (unsigned int& index : indices)
+            index = remap[index];
+        MeshOptimizer::RemapVertices(vertices, remap, vertexCount);
+
+        report.verticesAfter = vertices.size();
+        report.after = MeshOptimizer::AnalyzeVertexCache(indices.data(), indices.size(), vertices.size());
+        optimizationReport = report;
+
+        std::cout << "[MeshOptimizer] " << name << ": vertices " << report.verticesBefore << " -> " << report.verticesAfter
+                  << ", ACMR " << report.before.acmr << " -> " << report.after.acmr
+                  << ", ATVR " << report.before.atvr << " -> " << report.after.atvr << std::endl;
+    }
+
     void Mesh::CreateMesh(MeshType type) {
+        CreateMesh(ProceduralMeshKey::Default(type));
+    }
+
+    void Mesh::CreateMesh(const ProceduralMeshKey& key) {
         vertices.clear();
         indices.clear();
 
-        switch (type) {
+        switch (key.type) {
         case MeshType::Cube:
             CreateCube();
             break;
         case MeshType::Capsule:
-            CreateCapsule(1.0f, 2.0f);
+            CreateCapsule(key.radius, key.height);
             break;
         case MeshType::Sphere:
-            CreateSphere(1.0f, 20, 20);
+            CreateSphere(key.radius, key.stacks, key.sectors);
             break;
         case MeshType::Cylinder:
-            CreateCylinder(0.5f, 0.5f, 2.0f, 30);
+            CreateCylinder(key.radius, key.topRadius, key.height, key.sectors);
             break;
         default:
             break;
         }
 
+        Optimize();
         SetupMesh();
     }
     void Mesh::Draw(const Shader& shader) const
@@ -136,17 +244,65 @@ namespace IDK::Graphics
         shader.Use();
         //  glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
 
-        glBindVertexArray(VAO);
+        setDecodeUniforms(shader, true);
+
+        // The VAO stays bound: the next draw of the same mesh skips the bind.
+        GLStateCache::Instance().bindVertexArray(VAO);
         if (!indices.empty()) {
-            glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(indices.size()), GL_UNSIGNED_INT, 0);
+            glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(indices.size()), indexType, 0);
         } else {
             glDrawArrays(GL_TRIANGLES, 0, static_cast<GLsizei>(vertices.size()));
         }
-        glBindVertexArray(0);
+
+        setDecodeUniforms(shader, false);
 
         //   glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
     }
 
+    void Mesh::DrawInstanced(const Shader& shader, GLuint instances, GLuint baseInstance, GLsizei count) const
+    {
+        if (count <= 0) return;
+
+        shader.Use();
+        setDecodeUniforms(shader, true);
+
+        GLStateCache::Instance().bindVertexArray(VAO);
+        if (instanceBuffer != instances) {
+            // The attribute layout lives in the VAO, so this runs once per mesh
+            // and buffer; reallocating the buffer's storage keeps it valid.
+            glBindBuffer(GL_ARRAY_BUFFER, instances);
+            for (GLuint column = 0; column < 4; ++column) {
+                const GLuint location = InstanceModelLocation + column;
+                glEnableVertexAttribArray(location);
+                glVertexAttribPointer(location, 4, GL_FLOAT, GL_FALSE, sizeof(glm::mat4),
+                                      reinterpret_cast<void*>(sizeof(glm::vec4) * column));
+                glVertexAttribDivisor(location, 1);
+            }
+            glBindBuffer(GL_ARRAY_BUFFER, 0);
+            instanceBuffer = instances;
+        }
+
+        if (!indices.empty()) {
+            glDrawElementsInstancedBaseInstance(GL_TRIANGLES, static_cast<GLsizei>(indices.size()), indexType,
+                                                nullptr, count, baseInstance);
+        } else {
+            glDrawArraysInstancedBaseInstance(GL_TRIANGLES, 0, static_cast<GLsizei>(vertices.size()), count, baseInstance);
+        }
+
+        setDecodeUniforms(shader, false);
+    }
+
+    // Compact meshes need their decode parameters for the draw; afterwards the
+    // shader's defaults are put back for standard meshes and other geometry.
+    void Mesh::setDecodeUniforms(const Shader& shader, bool drawing) const {
+        if (!VertexCompression::IsCompact(vertexFormat))
+            return;
+
+        shader.setVec3(u_positionOffset, drawing ? quantization.offset : glm::vec3(0.0f));
+        shader.setVec3(u_positionScale, drawing ? quantization.scale : glm::vec3(1.0f));
+        shader.setInt(u_octNormals, drawing ? 1 : 0);
+    }
+
     void Mesh::CreateSphere(float radius, int stacks, int sectors) {
         vertices.clear();
         indices.clear();
@@ -11,7 +11,11 @@
 #include "Shader.h"
 #include <filesystem>
 #include "AssetItem.h"
+#include "Bounds.h"
 #include "MainAllocator.h"
+#include "MeshArena.h"
+#include "MeshOptimizer.h"
+#include "VertexCompression.h"
 
 namespace IDK::Graphics
 {
@@ -27,6 +31,28 @@ namespace IDK::Graphics
         Cylinder
     };
 
+    // Everything procedural generation depends on; equal keys give identical geometry.
+    struct ProceduralMeshKey {
+        MeshType type = MeshType::Cube;
+        float radius = 0.0f;
+        float topRadius = 0.0f;
+        float height = 0.0f;
+        int stacks = 0;
+        int sectors = 0;
+
+        bool operator==(const ProceduralMeshKey&) const = default;
+
+        // The parameters CreateMesh(type) has always used.
+        static ProceduralMeshKey Default(MeshType type) {
+            switch (type) {
+            case MeshType::Capsule:  return {type, 1.0f, 1.0f, 2.0f, 0, 0};
+            case MeshType::Sphere:   return {type, 1.0f, 1.0f, 0.0f, 20, 20};
+            case MeshType::Cylinder: return {type, 0.5f, 0.5f, 2.0f, 0, 30};
+            default:                 return {MeshType::Cube};
+            }
+        }
+    };
+
     class Mesh final : public AssetItem {
     public:
         Mesh(const Mesh &other, const std::string &newName);
@@ -46,13 +72,37 @@ namespace IDK::Graphics
 
         void Draw(const Shader& shader) const;
 
+        // Draws count instances whose model matrices start at baseInstance in
+        // the instances buffer (one mat4 each, read from locations 3-6).
+        void DrawInstanced(const Shader& shader, GLuint instances, GLuint baseInstance, GLsizei count) const;
+        static constexpr GLuint InstanceModelLocation = 3;
+
+        // Applies on the next SetupMesh(); meshes pick up the default when constructed.
+        void setVertexFormat(VertexFormat format);
+        VertexFormat getVertexFormat() const { return vertexFormat; }
+        static void SetDefaultVertexFormat(VertexFormat format) { s_defaultVertexFormat = format; }
+
+        size_t getGpuMemoryUsage() const { return gpuBytes; }
+
+        // Object-space bounds of the uploaded vertices; see AABB::Transform for world space.
+        const AABB& getLocalBounds() const { return localBounds; }
+
+        // Renewed by every SetupMesh(); keys this geometry in MeshArena.
+        const MeshGeometryId& getGeometryId() const { return geometryId; }
+
         Mesh(Mesh&& other) noexcept = default;
         Mesh& operator=(Mesh&& other) noexcept = default;
 
         void CreateMesh(MeshType type);
+        void CreateMesh(const ProceduralMeshKey& key);
 
         const std::string& getName() const { return name; }
         void SetupMesh();
+
+        // Welds duplicates, reorders triangles for the vertex cache and vertices for fetch locality.
+        // Unindexed meshes come out indexed.
+        void Optimize();
+        const MeshOptimizer::Report& getOptimizationReport() const { return optimizationReport; }
         bool hasMesh() const { return !vertices.empty(); }
 
         void CreateSphere(float radius, int stacks, int sectors);
@@ -73,14 +123,26 @@ namespace IDK::Graphics
         }
 
         static void* operator new(std::size_t size) {
-            return IDK::MeshPoolAllocator<Mesh>::aligned_allocate(size, alignof(Mesh));
+            return IDK::BlockPool::Allocate(size, alignof(Mesh));
         }
-        static void operator delete(void* ptr) {
-            IDK::MeshPoolAllocator<Mesh>::aligned_deallocate(static_cast<Mesh*>(ptr));
+        static void operator delete(void* ptr, std::size_t size) {
+            IDK::BlockPool::Deallocate(ptr, size, alignof(Mesh));
         }
 
     private:
+        void setDecodeUniforms(const Shader& shader, bool drawing) const;
+
         GLuint VAO{}, VBO{}, EBO{};
+        mutable GLuint instanceBuffer = 0; // instance buffer the VAO's model attributes point at
+        GLenum indexType = GL_UNSIGNED_INT;
+        VertexFormat vertexFormat = s_defaultVertexFormat;
+        PositionQuantization quantization;
+        AABB localBounds;
+        size_t gpuBytes = 0;
+        MeshOptimizer::Report optimizationReport;
+        MeshGeometryId geometryId;
+
+        static inline VertexFormat s_defaultVertexFormat = VertexFormat::Standard;
         std::vector<Vertex, IDK::MeshPoolAllocator<Vertex>> vertices;
         std::vector<unsigned int, IDK::MeshPoolAllocator<unsigned int>> indices;
     };
@@ -0,0 +1,264 @@
+//
+// Created by SIMEON on 10/17/2026.
+//
+
+#include "MeshArena.h"
+
+#include <algorithm>
+#include <atomic>
+#include <iterator>
+#include <mutex>
+#include <vector>
+
+#include "GLStateCache.h"
+#include "Mesh.h"
+
+namespace
+{
+    constexpr size_t InitialVertexBytes = 1u << 20;
+    constexpr size_t InitialIndexBytes = 1u << 20;
+
+    // Replaces buffer with a larger one holding the same first used bytes.
+    void GrowBuffer(GLuint& buffer, size_t& capacity, size_t used, size_t required, size_t initial) {
+        if (required <= capacity) return;
+
+        const size_t newCapacity = std::max({required, capacity * 2, initial});
+        GLuint grown = 0;
+        glGenBuffers(1, &grown);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, grown);
+        glBufferData(GL_COPY_WRITE_BUFFER, static_cast<GLsizeiptr>(newCapacity), nullptr, GL_STATIC_DRAW);
+
+        if (buffer != 0) {
+            if (used > 0) {
+                glBindBuffer(GL_COPY_READ_BUFFER, buffer);
+                glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0, static_cast<GLsizeiptr>(used));
+                glBindBuffer(GL_COPY_READ_BUFFER, 0);
+            }
+            glDeleteBuffers(1, &buffer);
+        }
+        glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+        buffer = grown;
+        capacity = newCapacity;
+    }
+
+    // Every live arena, so a mesh can release its geometry without knowing
+    // which arenas hold it.
+    struct ArenaRegistry {
+        std::mutex mutex;
+        std::vector<IDK::Graphics::MeshArena*> arenas;
+    };
+
+    ArenaRegistry& Arenas() {
+        static ArenaRegistry registry;
+        return registry;
+    }
+}
+
+namespace IDK::Graphics
+{
+    uint64_t MeshGeometryId::Next() {
+        static std::atomic<uint64_t> next{1};
+        return next.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    MeshGeometryId::MeshGeometryId(MeshGeometryId&& other) noexcept
+        : m_value(other.m_value), m_inArena(other.m_inArena) {
+        other.m_value = Next();
+        other.m_inArena = false;
+    }
+
+    MeshGeometryId& MeshGeometryId::operator=(MeshGeometryId&& other) noexcept {
+        if (this != &other) {
+            release();
+            m_value = other.m_value;
+            m_inArena = other.m_inArena;
+            other.m_value = Next();
+            other.m_inArena = false;
+        }
+        return *this;
+    }
+
+    void MeshGeometryId::renew() {
+        release();
+        m_value = Next();
+    }
+
+    void MeshGeometryId::release() {
+        if (!m_inArena) return;
+        m_inArena = false;
+        MeshArena::Release(m_value);
+    }
+
+    MeshArena::MeshArena() {
+        ArenaRegistry& registry = Arenas();
+        std::lock_guard lock(registry.mutex);
+        registry.arenas.push_back(this);
+    }
+
+    MeshArena::~MeshArena() {
+        {
+            ArenaRegistry& registry = Arenas();
+            std::lock_guard lock(registry.mutex);
+            std::erase(registry.arenas, this);
+        }
+
+        if (m_vao) {
+            GLStateCache::Instance().forgetVertexArray(m_vao);
+            glDeleteVertexArrays(1, &m_vao);
+        }
+        if (m_vertexBuffer) glDeleteBuffers(1, &m_vertexBuffer);
+        if (m_indexBuffer) glDeleteBuffers(1, &m_indexBuffer);
+    }
+
+    void MeshArena::Release(uint64_t geometryId) {
+        ArenaRegistry& registry = Arenas();
+        std::lock_guard lock(registry.mutex);
+        for (MeshArena* arena : registry.arenas)
+            arena->m_released.push_back(geometryId);
+    }
+
+    void MeshArena::collectReleased() {
+        std::vector<uint64_t> released;
+        {
+            ArenaRegistry& registry = Arenas();
+            std::lock_guard lock(registry.mutex);
+            released.swap(m_released);
+        }
+
+        for (const uint64_t geometryId : released) {
+            const auto found = m_entries.find(geometryId);
+            if (found == m_entries.end()) continue;
+
+            freeEntry(found->second);
+            m_entries.erase(found);
+            --m_stats.meshes;
+        }
+    }
+
+    void MeshArena::freeEntry(const Entry& entry) {
+        FreeSpan(m_freeVertices, m_vertexEnd, static_cast<size_t>(entry.range.baseVertex), entry.vertexCount);
+        FreeSpan(m_freeIndices, m_indexEnd, entry.range.firstIndex, entry.range.indexCount);
+        m_stats.vertices -= entry.vertexCount;
+        m_stats.indices -= entry.range.indexCount;
+    }
+
+    // First fit, else past the end.
+    size_t MeshArena::AllocateSpan(std::vector<Span>& spans, size_t& end, size_t count) {
+        for (auto span = spans.begin(); span != spans.end(); ++span) {
+            if (span->count < count) continue;
+
+            const size_t offset = span->offset;
+            span->offset += count;
+            span->count -= count;
+            if (span->count == 0) spans.erase(span);
+            return offset;
+        }
+
+        const size_t offset = end;
+        end += count;
+        return offset;
+    }
+
+    void MeshArena::FreeSpan(std::vector<Span>& spans, size_t& end, size_t offset, size_t count) {
+        auto span = std::lower_bound(spans.begin(), spans.end(), offset,
+                                     [](const Span& free, size_t value) { return free.offset < value; });
+        span = spans.insert(span, {offset, count});
+
+        const auto next = std::next(span);
+        if (next != spans.end() && span->offset + span->count == next->offset) {
+            span->count += next->count;
+            spans.erase(next);
+        }
+        if (span != spans.begin()) {
+            const auto previous = std::prev(span);
+            if (previous->offset + previous->count == span->offset) {
+                previous->count += span->count;
+                span = std::prev(spans.erase(span));
+            }
+        }
+
+        // A run that reaches the end hands its space back to the end.
+        if (span->offset + span->count == end) {
+            end = span->offset;
+            spans.erase(span);
+        }
+    }
+
+    void MeshArena::reserve(size_t vertexBytes, size_t indexBytes) {
+        // The ends already include the data about to be written, which the
+        // old buffers may not hold, so the copy stops at their capacity.
+        const GLuint oldVertexBuffer = m_vertexBuffer, oldIndexBuffer = m_indexBuffer;
+        GrowBuffer(m_vertexBuffer, m_vertexCapacity, std::min(m_vertexEnd * sizeof(Vertex), m_vertexCapacity), vertexBytes,
+                   InitialVertexBytes);
+        GrowBuffer(m_indexBuffer, m_indexCapacity, std::min(m_indexEnd * sizeof(uint32_t), m_indexCapacity), indexBytes,
+                   InitialIndexBytes);
+        if (m_vao != 0 && m_vertexBuffer == oldVertexBuffer && m_indexBuffer == oldIndexBuffer) return;
+
+        if (m_vao == 0)
+            glGenVertexArrays(1, &m_vao);
+        GLStateCache::Instance().bindVertexArray(m_vao);
+
+        glBindBuffer(GL_ARRAY_BUFFER, m_vertexBuffer);
+        glEnableVertexAttribArray(0);
+        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), reinterpret_cast<void*>(offsetof(Vertex, position)));
+        glEnableVertexAttribArray(1);
+        glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), reinterpret_cast<void*>(offsetof(Vertex, normal)));
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_indexBuffer);
+
+        m_stats.capacityBytes = m_vertexCapacity + m_indexCapacity;
+    }
+
+    const MeshRange* MeshArena::acquire(const Mesh& mesh) {
+        collectReleased();
+
+        const auto& vertices = mesh.getVertices();
+        const auto& indices = mesh.getIndices();
+        if (vertices.empty()) return nullptr;
+
+        const MeshGeometryId& geometryId = mesh.getGeometryId();
+        const auto found = m_entries.find(geometryId.value());
+        if (found != m_entries.end() && found->second.vertexCount == vertices.size() &&
+            found->second.meshIndexCount == indices.size())
+            return &found->second.range;
+
+        // Same geometry id with other counts: the vertices changed without
+        // SetupMesh(), so the old copy is stale.
+        if (found != m_entries.end())
+            freeEntry(found->second);
+
+        const size_t indexCount = indices.empty() ? vertices.size() : indices.size();
+        const size_t firstVertex = AllocateSpan(m_freeVertices, m_vertexEnd, vertices.size());
+        const size_t firstIndex = AllocateSpan(m_freeIndices, m_indexEnd, indexCount);
+        reserve(m_vertexEnd * sizeof(Vertex), m_indexEnd * sizeof(uint32_t));
+
+        glBindBuffer(GL_COPY_WRITE_BUFFER, m_vertexBuffer);
+        glBufferSubData(GL_COPY_WRITE_BUFFER, static_cast<GLintptr>(firstVertex * sizeof(Vertex)),
+                        static_cast<GLsizeiptr>(vertices.size() * sizeof(Vertex)), vertices.data());
+
+        glBindBuffer(GL_COPY_WRITE_BUFFER, m_indexBuffer);
+        const GLintptr indexOffset = static_cast<GLintptr>(firstIndex * sizeof(uint32_t));
+        if (indices.empty()) {
+            std::vector<uint32_t> sequential(indexCount);
+            for (size_t i = 0; i < indexCount; ++i) sequential[i] = static_cast<uint32_t>(i);
+            glBufferSubData(GL_COPY_WRITE_BUFFER, indexOffset, static_cast<GLsizeiptr>(indexCount * sizeof(uint32_t)),
+                            sequential.data());
+        } else {
+            glBufferSubData(GL_COPY_WRITE_BUFFER, indexOffset, static_cast<GLsizeiptr>(indexCount * sizeof(uint32_t)),
+                            indices.data());
+        }
+        glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+        const MeshRange range{static_cast<uint32_t>(indexCount), static_cast<uint32_t>(firstIndex),
+                              static_cast<int32_t>(firstVertex)};
+
+        if (found == m_entries.end()) ++m_stats.meshes;
+        m_stats.vertices += vertices.size();
+        m_stats.indices += indexCount;
+
+        Entry& entry = m_entries[geometryId.value()];
+        entry = {range, vertices.size(), indices.size()};
+        geometryId.m_inArena = true;
+        return &entry.range;
+    }
+}
@@ -0,0 +1,121 @@
+//
+// Created by SIMEON on 10/17/2026.
+//
+
+#ifndef MESHARENA_H
+#define MESHARENA_H
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include "glad/glad.h"
+
+namespace IDK::Graphics
+{
+    class Mesh;
+
+    // Where a mesh lives in the arena, in the terms of a
+    // DrawElementsIndirectCommand.
+    struct MeshRange {
+        uint32_t indexCount = 0;
+        uint32_t firstIndex = 0;
+        int32_t baseVertex = 0;
+    };
+
+    struct MeshArenaStats {
+        size_t meshes = 0;
+        size_t vertices = 0;       // held by live meshes
+        size_t indices = 0;
+        size_t capacityBytes = 0;  // vertex and index storage allocated on the GPU
+    };
+
+    // Names one upload of a mesh's geometry. Unlike the mesh's address it is
+    // never reused, and every arena holding the geometry is told when it goes
+    // away: the owner is destroyed, renews it for new geometry, or is
+    // overwritten by a move. Moving hands the geometry to the new owner.
+    class MeshGeometryId
+    {
+    public:
+        MeshGeometryId() : m_value(Next()) {}
+        ~MeshGeometryId() { release(); }
+
+        MeshGeometryId(MeshGeometryId&& other) noexcept;
+        MeshGeometryId& operator=(MeshGeometryId&& other) noexcept;
+
+        MeshGeometryId(const MeshGeometryId&) = delete;
+        MeshGeometryId& operator=(const MeshGeometryId&) = delete;
+
+        void renew();
+        uint64_t value() const { return m_value; }
+
+    private:
+        friend class MeshArena;
+
+        static uint64_t Next();
+        void release();
+
+        uint64_t m_value;
+        mutable bool m_inArena = false;
+    };
+
+    // Static geometry of many meshes in one vertex buffer and one index
+    // buffer behind one VAO, so any set of them can be drawn with a single
+    // multi-draw. Vertices are stored in the standard layout (float position
+    // at location 0, float normal at location 1) whatever format the mesh
+    // itself was uploaded with; unindexed meshes get sequential indices.
+    //
+    // Meshes are added on first use, keyed by their MeshGeometryId. When that
+    // geometry goes away its ranges are freed on the next acquire() and
+    // reused first-fit, so a scene that keeps replacing meshes stays bounded.
+    class MeshArena
+    {
+    public:
+        MeshArena();
+        ~MeshArena();
+
+        MeshArena(const MeshArena&) = delete;
+        MeshArena& operator=(const MeshArena&) = delete;
+
+        // Render thread. nullptr for meshes without vertices.
+        const MeshRange* acquire(const Mesh& mesh);
+
+        // Attributes 0 and 1 and the element buffer are owned by the arena;
+        // other locations are left for the caller.
+        GLuint getVertexArray() const { return m_vao; }
+        const MeshArenaStats& getStats() const { return m_stats; }
+
+        // Any thread. Queues the geometry's ranges in every arena for freeing.
+        static void Release(uint64_t geometryId);
+
+    private:
+        struct Entry {
+            MeshRange range;
+            size_t vertexCount;       // in the arena
+            size_t meshIndexCount;    // in the mesh; 0 for unindexed meshes
+        };
+
+        // Free runs of vertices or indices, sorted by offset and coalesced.
+        struct Span {
+            size_t offset;
+            size_t count;
+        };
+
+        void reserve(size_t vertexBytes, size_t indexBytes);
+        void collectReleased();
+        void freeEntry(const Entry& entry);
+
+        static size_t AllocateSpan(std::vector<Span>& spans, size_t& end, size_t count);
+        static void FreeSpan(std::vector<Span>& spans, size_t& end, size_t offset, size_t count);
+
+        GLuint m_vao = 0, m_vertexBuffer = 0, m_indexBuffer = 0;
+        size_t m_vertexCapacity = 0, m_indexCapacity = 0;  // bytes
+        size_t m_vertexEnd = 0, m_indexEnd = 0;            // past the last used element
+        std::vector<Span> m_freeVertices, m_freeIndices;
+        std::unordered_map<uint64_t, Entry> m_entries;
+        std::vector<uint64_t> m_released;                  // guarded by the registry mutex
+        MeshArenaStats m_stats;
+    };
+}
+
+#endif //MESHARENA_H
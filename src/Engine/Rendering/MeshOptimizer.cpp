@@ -0,0 +1,217 @@
+//
+// Created by SIMEON on 10/17/2026.
+//
+
+#include "MeshOptimizer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <string_view>
+#include <unordered_map>
+
+namespace IDK::Graphics::MeshOptimizer
+{
+    namespace
+    {
+        // Forsyth's tuning constants; the modelled cache is larger than the
+        // real one on purpose, it only drives the scoring.
+        constexpr int ScoreCacheSize = 32;
+        constexpr float CacheDecayPower = 1.5f;
+        constexpr float LastTriangleScore = 0.75f;
+        constexpr float ValenceBoostScale = 2.0f;
+        constexpr float ValenceBoostPower = 0.5f;
+
+        float vertexScore(int cachePosition, unsigned int remainingTriangles) {
+            if (remainingTriangles == 0)
+                return -1.0f;
+
+            float score = 0.0f;
+            if (cachePosition >= 0) {
+                if (cachePosition < 3) {
+                    score = LastTriangleScore;
+                } else {
+                    const float scaler = 1.0f / (ScoreCacheSize - 3);
+                    score = std::pow(1.0f - (cachePosition - 3) * scaler, CacheDecayPower);
+                }
+            }
+
+            return score + ValenceBoostScale * std::pow(static_cast<float>(remainingTriangles), -ValenceBoostPower);
+        }
+    }
+
+    size_t BuildWeldRemap(std::vector<unsigned int>& remap, const void* vertices, size_t vertexCount, size_t vertexSize,
+                          const unsigned int* indices, size_t indexCount) {
+        remap.assign(vertexCount, ~0u);
+
+        const auto* bytes = static_cast<const char*>(vertices);
+        std::unordered_map<std::string_view, unsigned int> unique;
+        unique.reserve(vertexCount);
+
+        size_t next = 0;
+        const size_t references = indices ? indexCount : vertexCount;
+        for (size_t i = 0; i < references; ++i) {
+            const unsigned int vertex = indices ? indices[i] : static_cast<unsigned int>(i);
+            if (remap[vertex] != ~0u) continue;
+
+            const std::string_view key(bytes + vertex * vertexSize, vertexSize);
+            const auto [it, inserted] = unique.try_emplace(key, static_cast<unsigned int>(next));
+            if (inserted) ++next;
+            remap[vertex] = it->second;
+        }
+        return next;
+    }
+
+    void OptimizeVertexCache(unsigned int* indices, size_t indexCount, size_t vertexCount) {
+        const size_t triangleCount = indexCount / 3;
+        if (triangleCount == 0) return;
+
+        // Per-vertex lists of triangles that still need emitting.
+        std::vector<unsigned int> remaining(vertexCount, 0);
+        for (size_t i = 0; i < triangleCount * 3; ++i)
+            ++remaining[indices[i]];
+
+        std::vector<unsigned int> offsets(vertexCount + 1, 0);
+        for (size_t v = 0; v < vertexCount; ++v)
+            offsets[v + 1] = offsets[v] + remaining[v];
+
+        std::vector<unsigned int> adjacency(triangleCount * 3);
+        std::vector<unsigned int> fill(offsets.begin(), offsets.end() - 1);
+        for (size_t t = 0; t < triangleCount; ++t) {
+            for (int k = 0; k < 3; ++k)
+                adjacency[fill[indices[t * 3 + k]]++] = static_cast<unsigned int>(t);
+        }
+
+        std::vector<int> cachePosition(vertexCount, -1);
+        std::vector<float> score(vertexCount);
+        for (size_t v = 0; v < vertexCount; ++v)
+            score[v] = vertexScore(-1, remaining[v]);
+
+        std::vector<float> triangleScore(triangleCount);
+        for (size_t t = 0; t < triangleCount; ++t)
+            triangleScore[t] = score[indices[t * 3]] + score[indices[t * 3 + 1]] + score[indices[t * 3 + 2]];
+
+        std::vector<bool> emitted(triangleCount, false);
+        std::vector<unsigned int> output(triangleCount * 3);
+
+        std::vector<unsigned int> cache, nextCache;
+        cache.reserve(ScoreCacheSize + 3);
+        nextCache.reserve(ScoreCacheSize + 3);
+
+        size_t bestTriangle = 0;
+        for (size_t t = 1; t < triangleCount; ++t) {
+            if (triangleScore[t] > triangleScore[bestTriangle])
+                bestTriangle = t;
+        }
+
+        size_t scanCursor = 0;
+        for (size_t written = 0; written < triangleCount; ++written) {
+            const unsigned int* triangle = indices + bestTriangle * 3;
+            emitted[bestTriangle] = true;
+            triangleScore[bestTriangle] = -1.0f;
+
+            nextCache.clear();
+            for (int k = 0; k < 3; ++k) {
+                const unsigned int v = triangle[k];
+                output[written * 3 + k] = v;
+                if (std::find(nextCache.begin(), nextCache.end(), v) == nextCache.end())
+                    nextCache.push_back(v);
+
+                // Drop the triangle from the vertex's live list.
+                const auto first = adjacency.begin() + offsets[v];
+                const auto last = first + remaining[v];
+                std::iter_swap(std::find(first, last, static_cast<unsigned int>(bestTriangle)), last - 1);
+                --remaining[v];
+            }
+
+            for (const unsigned int v : cache) {
+                if (v != triangle[0] && v != triangle[1] && v != triangle[2])
+                    nextCache.push_back(v);
+            }
+
+            // Vertices pushed out of the modelled cache lose their position bonus.
+            for (size_t i = ScoreCacheSize; i < nextCache.size(); ++i) {
+                const unsigned int v = nextCache[i];
+                cachePosition[v] = -1;
+
+                const float updated = vertexScore(-1, remaining[v]);
+                for (unsigned int a = offsets[v]; a < offsets[v] + remaining[v]; ++a)
+                    triangleScore[adjacency[a]] += updated - score[v];
+                score[v] = updated;
+            }
+            if (nextCache.size() > ScoreCacheSize)
+                nextCache.resize(ScoreCacheSize);
+            cache.swap(nextCache);
+
+            float bestScore = -1.0f;
+            for (size_t i = 0; i < cache.size(); ++i) {
+                const unsigned int v = cache[i];
+                cachePosition[v] = static_cast<int>(i);
+
+                const float updated = vertexScore(static_cast<int>(i), remaining[v]);
+                const float delta = updated - score[v];
+                score[v] = updated;
+
+                for (unsigned int a = offsets[v]; a < offsets[v] + remaining[v]; ++a) {
+                    const unsigned int t = adjacency[a];
+                    triangleScore[t] += delta;
+                    if (triangleScore[t] > bestScore) {
+                        bestScore = triangleScore[t];
+                        bestTriangle = t;
+                    }
+                }
+            }
+
+            // Nothing adjacent to the cache is left: restart from the best remaining triangle.
+            if (bestScore < 0.0f && written + 1 < triangleCount) {
+                while (emitted[scanCursor]) ++scanCursor;
+                bestTriangle = scanCursor;
+                for (size_t t = scanCursor + 1; t < triangleCount; ++t) {
+                    if (!emitted[t] && triangleScore[t] > triangleScore[bestTriangle])
+                        bestTriangle = t;
+                }
+            }
+        }
+
+        std::copy(output.begin(), output.end(), indices);
+    }
+
+    size_t BuildFetchRemap(std::vector<unsigned int>& remap, const unsigned int* indices, size_t indexCount, size_t vertexCount) {
+        remap.assign(vertexCount, ~0u);
+
+        unsigned int next = 0;
+        for (size_t i = 0; i < indexCount; ++i) {
+            if (remap[indices[i]] == ~0u)
+                remap[indices[i]] = next++;
+        }
+        return next;
+    }
+
+    CacheStats AnalyzeVertexCache(const unsigned int* indices, size_t indexCount, size_t vertexCount, unsigned int cacheSize) {
+        CacheStats stats;
+        const size_t triangleCount = indexCount / 3;
+        if (triangleCount == 0) return stats;
+
+        // FIFO cache modelled with per-vertex insertion timestamps.
+        std::vector<size_t> insertedAt(vertexCount, 0);
+        std::vector<bool> referenced(vertexCount, false);
+        size_t clock = cacheSize + 1;
+        size_t misses = 0, uniqueVertices = 0;
+
+        for (size_t i = 0; i < triangleCount * 3; ++i) {
+            const unsigned int v = indices[i];
+            if (!referenced[v]) {
+                referenced[v] = true;
+                ++uniqueVertices;
+            }
+
+            if (clock - insertedAt[v] > cacheSize) {
+                insertedAt[v] = clock++;
+                ++misses;
+            }
+        }
+
+        stats.acmr = static_cast<float>(misses) / triangleCount;
+        stats.atvr = static_cast<float>(misses) / uniqueVertices;
+        return stats;
+    }
+}
@@ -0,0 +1,61 @@
+//
+// Created by SIMEON on 10/17/2026.
+//
+
+#ifndef MESHOPTIMIZER_H
+#define MESHOPTIMIZER_H
+
+#include <cstddef>
+#include <vector>
+
+namespace IDK::Graphics::MeshOptimizer
+{
+    // Post-transform cache behaviour of an index buffer under a FIFO cache.
+    struct CacheStats {
+        float acmr = 0.0f; // misses per triangle (0.5 is ideal for large grids, 3 is worst)
+        float atvr = 0.0f; // misses per referenced vertex (1 is ideal)
+    };
+
+    struct Report {
+        size_t verticesBefore = 0;
+        size_t verticesAfter = 0;
+        CacheStats before;
+        CacheStats after;
+    };
+
+    constexpr unsigned int DefaultCacheSize = 16;
+
+    // Merges bytewise-identical vertices. remap[i] receives the new index of
+    // vertex i (unreferenced vertices get ~0u); returns the unique count.
+    // indices may be null for an unindexed vertex list.
+    size_t BuildWeldRemap(std::vector<unsigned int>& remap, const void* vertices, size_t vertexCount, size_t vertexSize,
+                          const unsigned int* indices, size_t indexCount);
+
+    // Reorders triangles for the post-transform cache (Forsyth's linear-speed algorithm).
+    void OptimizeVertexCache(unsigned int* indices, size_t indexCount, size_t vertexCount);
+
+    // Renumbers vertices in first-use order so fetches walk the vertex buffer
+    // linearly. Same remap contract as BuildWeldRemap.
+    size_t BuildFetchRemap(std::vector<unsigned int>& remap, const unsigned int* indices, size_t indexCount, size_t vertexCount);
+
+    CacheStats AnalyzeVertexCache(const unsigned int* indices, size_t indexCount, size_t vertexCount,
+                                  unsigned int cacheSize = DefaultCacheSize);
+
+    // Applies a remap to a vertex array, keeping the first vertex mapped to each slot.
+    template<typename VertexVector>
+    void RemapVertices(VertexVector& vertices, const std::vector<unsigned int>& remap, size_t newCount) {
+        VertexVector remapped(newCount, vertices.get_allocator());
+        std::vector<bool> written(newCount, false);
+
+        for (size_t i = 0; i < vertices.size(); ++i) {
+            const unsigned int target = remap[i];
+            if (target == ~0u || written[target]) continue;
+
+            remapped[target] = vertices[i];
+            written[target] = true;
+        }
+        vertices.swap(remapped);
+    }
+}
+
+#endif //MESHOPTIMIZER_H
@@ -8,13 +8,36 @@
 #include <vector>
 #include <memory>
 #include <mutex>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include "Mesh.h"
 
 namespace IDK {
-    class Mesh;
+    struct ProceduralMeshKeyHash
+    {
+        size_t operator()(const Graphics::ProceduralMeshKey& key) const noexcept {
+            size_t hash = std::hash<int>()(static_cast<int>(key.type));
+            auto combine = [&hash](size_t value) { hash ^= value + 0x9e3779b97f4a7c15ull + (hash << 6) + (hash >> 2); };
+            combine(std::hash<float>()(key.radius));
+            combine(std::hash<float>()(key.topRadius));
+            combine(std::hash<float>()(key.height));
+            combine(std::hash<int>()(key.stacks));
+            combine(std::hash<int>()(key.sectors));
+            return hash;
+        }
+    };
 
     class MeshRegistry
     {
     public:
+        struct SharedMeshInfo
+        {
+            Graphics::ProceduralMeshKey key;
+            std::shared_ptr<Graphics::Mesh> mesh;
+            long users; // owners outside the cache, i.e. mesh filters
+        };
+
         static MeshRegistry& Instance()
         {
             static MeshRegistry instance;
@@ -26,6 +49,7 @@ namespace IDK {
             static_assert(std::is_base_of<IDK::Graphics::Mesh, MeshT>::value,
                          "Must register a type derived from IDK::Mesh");
             std::lock_guard<std::mutex> lock(m_mutex);
+            pruneExpired();
             m_meshes.push_back(std::weak_ptr<IDK::Graphics::Mesh>(mesh));
         }
 
@@ -34,14 +58,68 @@ namespace IDK {
             return m_meshes;
         }
 
+        // Returns the shared mesh for these generation parameters, building and
+        // uploading it only on first use. Shared meshes must not be modified.
+        // The cache holds weak references: geometry is freed with its last user.
+        std::shared_ptr<Graphics::Mesh> acquire(const Graphics::ProceduralMeshKey& key) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            const auto found = m_procedural.find(key);
+            if (found != m_procedural.end()) {
+                if (auto mesh = found->second.lock())
+                    return mesh;
+            }
+
+            // Only building a mesh can leave a new entry behind, so this is
+            // where stale ones are swept, including this key's own.
+            pruneExpired();
+
+            auto mesh = std::allocate_shared<Graphics::Mesh>(MeshSharedAllocator<Graphics::Mesh>(), meshName(key.type));
+            mesh->CreateMesh(key);
+
+            m_procedural[key] = mesh;
+            m_meshes.push_back(std::weak_ptr<Graphics::Mesh>(mesh));
+            return mesh;
+        }
+
+        std::vector<SharedMeshInfo> getSharedMeshes() const {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            std::vector<SharedMeshInfo> shared;
+            shared.reserve(m_procedural.size());
+            for (const auto& [key, weakMesh] : m_procedural) {
+                if (auto mesh = weakMesh.lock()) {
+                    const long users = mesh.use_count() - 1;
+                    shared.push_back({key, std::move(mesh), users});
+                }
+            }
+            return shared;
+        }
+
     private:
         MeshRegistry() = default;
         ~MeshRegistry() = default;
         MeshRegistry(const MeshRegistry&) = delete;
         MeshRegistry& operator=(const MeshRegistry&) = delete;
 
+        // Caller holds m_mutex.
+        void pruneExpired() {
+            std::erase_if(m_procedural, [](const auto& entry) { return entry.second.expired(); });
+            std::erase_if(m_meshes, [](const std::weak_ptr<Graphics::Mesh>& mesh) { return mesh.expired(); });
+        }
+
+        static std::string meshName(Graphics::MeshType type) {
+            switch (type) {
+            case Graphics::MeshType::Capsule:  return "CapsuleMesh";
+            case Graphics::MeshType::Sphere:   return "SphereMesh";
+            case Graphics::MeshType::Cylinder: return "CylinderMesh";
+            default:                           return "CubeMesh";
+            }
+        }
+
         mutable std::mutex m_mutex;
         std::vector<std::weak_ptr<IDK::Graphics::Mesh>> m_meshes;
+        std::unordered_map<Graphics::ProceduralMeshKey, std::weak_ptr<Graphics::Mesh>, ProceduralMeshKeyHash> m_procedural;
     };
 }
 #endif //MESHREGISTRY_H
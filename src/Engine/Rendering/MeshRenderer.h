@@ -32,6 +32,10 @@ namespace IDK::Components
 
             meshFilter->getMesh()->Draw(*shader);
         }
+
+        const IDK::Graphics::Mesh* getMesh() const {
+            return meshFilter ? meshFilter->getMesh().get() : nullptr;
+        }
     private:
         std::shared_ptr<IDK::Components::MeshFilter> meshFilter;
     };
@@ -0,0 +1,98 @@
+//
+// Created by SIMEON on 10/17/2026.
+//
+
+#include "RenderQueue.h"
+
+#include <utility>
+
+namespace IDK::Graphics
+{
+    void RenderQueue::clear() {
+        m_commands.clear();
+        m_transforms.clear();
+        resetIfFull(m_shaderIds);
+        resetIfFull(m_materialIds);
+        resetIfFull(m_meshIds);
+    }
+
+    void RenderQueue::record(RenderPass pass, const Mesh* mesh, const Shader* shader, const Material* material,
+                             const glm::mat4& model, uint32_t depth) {
+        const uint64_t key = SortKey::Make(pass,
+                                           idOf(m_shaderIds, shader, SortKey::ShaderBits),
+                                           idOf(m_materialIds, material, SortKey::MaterialBits),
+                                           idOf(m_meshIds, mesh, SortKey::MeshBits),
+                                           depth);
+
+        m_commands.push_back({key, mesh, shader, static_cast<uint32_t>(m_transforms.size())});
+        m_transforms.push_back(model);
+    }
+
+    void RenderQueue::sort() {
+        RadixSort(m_commands, m_scratch);
+    }
+
+    void RenderQueue::RadixSort(std::vector<RenderCommand>& commands, std::vector<RenderCommand>& scratch) {
+        const size_t count = commands.size();
+        if (count < 2) return;
+        scratch.resize(count);
+
+        // All eight histograms in one read of the keys.
+        uint32_t histograms[8][256] = {};
+        for (const RenderCommand& command : commands) {
+            for (unsigned digit = 0; digit < 8; ++digit)
+                ++histograms[digit][(command.key >> (digit * 8)) & 0xFF];
+        }
+
+        RenderCommand* source = commands.data();
+        RenderCommand* target = scratch.data();
+        for (unsigned digit = 0; digit < 8; ++digit) {
+            uint32_t* offsets = histograms[digit];
+            const unsigned shift = digit * 8;
+            if (offsets[(source[0].key >> shift) & 0xFF] == count)
+                continue;
+
+            uint32_t offset = 0;
+            for (unsigned bucket = 0; bucket < 256; ++bucket) {
+                const uint32_t size = offsets[bucket];
+                offsets[bucket] = offset;
+                offset += size;
+            }
+
+            for (size_t i = 0; i < count; ++i)
+                target[offsets[(source[i].key >> shift) & 0xFF]++] = source[i];
+            std::swap(source, target);
+        }
+
+        if (source != commands.data())
+            commands.swap(scratch);
+    }
+
+    uint32_t RenderQueue::idOf(IdTable& table, const void* object, unsigned bits) {
+        if (!object) return 0;
+        if (object == table.last) return table.lastId;
+
+        const uint32_t overflowId = (1u << bits) - 1;
+        uint32_t id = overflowId;
+        if (const auto it = table.ids.find(object); it != table.ids.end()) {
+            id = it->second;
+        } else if (table.ids.size() + 1 < overflowId) {
+            id = static_cast<uint32_t>(table.ids.size() + 1);
+            table.ids.emplace(object, id);
+        } else {
+            table.full = true;
+        }
+
+        table.last = object;
+        table.lastId = id;
+        return id;
+    }
+
+    void RenderQueue::resetIfFull(IdTable& table) {
+        if (!table.full) return;
+        table.ids.clear();
+        table.last = nullptr;
+        table.lastId = 0;
+        table.full = false;
+    }
+}
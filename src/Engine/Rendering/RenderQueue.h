@@ -0,0 +1,115 @@
+//
+// Created by SIMEON on 10/17/2026.
+//
+
+#ifndef RENDERQUEUE_H
+#define RENDERQUEUE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include "glm.hpp"
+
+namespace IDK::Graphics
+{
+    class Material;
+    class Mesh;
+    class Shader;
+
+    enum class RenderPass : uint8_t {
+        Opaque,      // front to back
+        Transparent  // back to front
+    };
+
+    // Sort keys pack, from the most significant bits down:
+    // pass (4) | shader (12) | material (12) | mesh (16) | depth (20).
+    // Ascending order therefore groups by pass, then by state, and draws each
+    // group in depth order; equal StateBits() can share one instanced draw.
+    namespace SortKey
+    {
+        constexpr unsigned PassBits = 4;
+        constexpr unsigned ShaderBits = 12;
+        constexpr unsigned MaterialBits = 12;
+        constexpr unsigned MeshBits = 16;
+        constexpr unsigned DepthBits = 20;
+        static_assert(PassBits + ShaderBits + MaterialBits + MeshBits + DepthBits == 64);
+
+        constexpr uint64_t Field(uint64_t value, unsigned bits, unsigned shift) {
+            return (value & ((uint64_t(1) << bits) - 1)) << shift;
+        }
+
+        constexpr uint64_t Make(RenderPass pass, uint32_t shader, uint32_t material, uint32_t mesh, uint32_t depth) {
+            if (pass == RenderPass::Transparent)
+                depth = ~depth;
+
+            return Field(static_cast<uint64_t>(pass), PassBits, 60)
+                 | Field(shader, ShaderBits, 48)
+                 | Field(material, MaterialBits, 36)
+                 | Field(mesh, MeshBits, DepthBits)
+                 | Field(depth, DepthBits, 0);
+        }
+
+        constexpr uint64_t StateBits(uint64_t key) { return key >> DepthBits; }
+
+        // Maps a view-space distance in [0, farPlane] onto the depth field.
+        inline uint32_t QuantizeDepth(float viewDepth, float farPlane) {
+            constexpr uint32_t maxDepth = (1u << DepthBits) - 1;
+            if (!(viewDepth > 0.0f) || farPlane <= 0.0f) return 0;
+            if (viewDepth >= farPlane) return maxDepth;
+            return static_cast<uint32_t>(viewDepth / farPlane * maxDepth);
+        }
+    }
+
+    struct RenderCommand {
+        uint64_t key;
+        const Mesh* mesh;
+        const Shader* shader;
+        uint32_t transform; // index into RenderQueue::getTransforms()
+    };
+
+    // Scene traversal records commands here; the renderer sorts them and
+    // submits in one pass. No GL calls, so recording and sorting can run
+    // and be measured without a context.
+    class RenderQueue
+    {
+    public:
+        void clear();
+
+        void record(RenderPass pass, const Mesh* mesh, const Shader* shader, const Material* material,
+                    const glm::mat4& model, uint32_t depth);
+
+        void sort();
+
+        const std::vector<RenderCommand>& getCommands() const { return m_commands; }
+        const std::vector<glm::mat4>& getTransforms() const { return m_transforms; }
+
+        // LSD radix sort on the 64-bit key, 8 bits per pass. Stable; digits
+        // every key shares are skipped, which is most of them in practice.
+        static void RadixSort(std::vector<RenderCommand>& commands, std::vector<RenderCommand>& scratch);
+
+    private:
+        struct IdTable {
+            std::unordered_map<const void*, uint32_t> ids;
+            const void* last = nullptr; // traversal tends to repeat the same object
+            uint32_t lastId = 0;
+            bool full = false;
+        };
+
+        // Small per-object ids for the key fields, stable across frames.
+        // Null maps to 0. Once a field runs out of ids, new objects share its
+        // top id for the rest of the frame and clear() starts the table over;
+        // ids never change mid-frame, so that only costs sort quality.
+        static uint32_t idOf(IdTable& table, const void* object, unsigned bits);
+        static void resetIfFull(IdTable& table);
+
+        std::vector<RenderCommand> m_commands;
+        std::vector<RenderCommand> m_scratch;
+        std::vector<glm::mat4> m_transforms;
+        IdTable m_shaderIds;
+        IdTable m_materialIds;
+        IdTable m_meshIds;
+    };
+}
+
+#endif //RENDERQUEUE_H
@@ -4,11 +4,76 @@
 
 #include "DeferredRenderer.h"
 
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iterator>
+
 #include "Collider.h"
+#include "GLStateCache.h"
+#include "JobSystem.h"
+#include "Mesh.h"
 #include "MeshRenderer.h"
+#include "Registry.h"
+
+namespace
+{
+    const IDK::Graphics::UniformHandle u_view("view");
+    const IDK::Graphics::UniformHandle u_projection("projection");
+    const IDK::Graphics::UniformHandle u_model("model");
+    const IDK::Graphics::UniformHandle u_objectColor("objectColor");
+    const IDK::Graphics::UniformHandle u_wireframe("wireframe");
+    const IDK::Graphics::UniformHandle u_wireframeColor("wireframeColor");
+    const IDK::Graphics::UniformHandle u_packedNormals("packedNormals");
+    const IDK::Graphics::UniformHandle u_compactGBuffer("compactGBuffer");
+    const IDK::Graphics::UniformHandle u_lightViewProjection("lightViewProjection");
+    const IDK::Graphics::UniformHandle u_shadowMap("shadowMap");
+
+    constexpr GLuint ShadowMapUnit = 4;
+
+    // std140 mirrors of the uniform blocks streamed through the frame ring.
+    constexpr GLuint FrameDataBinding = 0;
+    constexpr GLuint ShadowDataBinding = 1;
+
+    struct FrameData {
+        glm::mat4 view;
+        glm::mat4 projection;
+        glm::mat4 inverseViewProjection;
+        glm::vec4 viewPos;
+    };
+
+    struct ShadowData {
+        glm::mat4 cascades[IDK::Graphics::ShadowCascades::MaxCascades];
+        glm::ivec4 cascadeCount;
+    };
+
+    // Instance copies at least this large are split across the job system.
+    constexpr size_t ParallelCopyInstances = 4096;
+
+    using PassClock = std::chrono::steady_clock;
+
+    double ElapsedMilliseconds(const PassClock::time_point start, const PassClock::time_point end) {
+        return std::chrono::duration<double, std::milli>(end - start).count();
+    }
+
+    // Binds the buffer to an indexed binding point with room for bytes. Last
+    // frame's storage is orphaned so the upload does not wait on its draws.
+    void ReserveStorage(GLenum target, GLuint& buffer, size_t& capacity, GLuint binding, size_t bytes) {
+        if (buffer == 0)
+            glGenBuffers(1, &buffer);
+
+        bytes = std::max<size_t>(bytes, 16);
+        if (bytes > capacity)
+            capacity = std::max(bytes, capacity * 2);
+
+        glBindBuffer(target, buffer);
+        glBufferData(target, static_cast<GLsizeiptr>(capacity), nullptr, GL_STREAM_DRAW);
+        glBindBufferBase(target, binding, buffer);
+    }
+}
 
 DeferredRenderer::DeferredRenderer(const std::shared_ptr<IDK::Scene>& scene, const std::shared_ptr<IDK::Graphics::Camera>& camera,
-                                   GLFWwindow* window, const std::string& rendererType)
+                                   GLFWwindow* window, const std::string& rendererType, IDK::JobSystem* jobs)
     : gPosition(0),
         gNormal(0),
         gAlbedoSpec(0),
@@ -22,6 +87,7 @@ DeferredRenderer::DeferredRenderer(const std::shared_ptr<IDK::Scene>& scene, con
         quadVAO(0), quadVBO(0),
         width(0),
         height(0),
+        jobs(jobs),
         scene(scene),
         camera(camera)
 {
@@ -44,20 +110,54 @@ DeferredRenderer::~DeferredRenderer() {
     if (gBuffer) glDeleteFramebuffers(1, &gBuffer);
     if (lightingFramebuffer) glDeleteFramebuffers(1, &lightingFramebuffer);
     if (finalFramebuffer) glDeleteFramebuffers(1, &finalFramebuffer);
-    if (quadVAO) glDeleteVertexArrays(1, &quadVAO);
+    if (quadVAO) {
+        IDK::Graphics::GLStateCache::Instance().forgetVertexArray(quadVAO);
+        glDeleteVertexArrays(1, &quadVAO);
+    }
     if (quadVBO) glDeleteBuffers(1, &quadVBO);
+    if (instanceVBO) glDeleteBuffers(1, &instanceVBO);
+    if (clusterLightSSBO) glDeleteBuffers(1, &clusterLightSSBO);
+    if (clusterGridSSBO) glDeleteBuffers(1, &clusterGridSSBO);
+    if (clusterIndexSSBO) glDeleteBuffers(1, &clusterIndexSSBO);
+    if (frameDataFallback) glDeleteBuffers(1, &frameDataFallback);
+    if (shadowDataFallback) glDeleteBuffers(1, &shadowDataFallback);
+    if (shadowFramebuffer) glDeleteFramebuffers(1, &shadowFramebuffer);
+    if (shadowMap) glDeleteTextures(1, &shadowMap);
     if (gPosition) glDeleteTextures(1, &gPosition);
     if (gNormal) glDeleteTextures(1, &gNormal);
     if (gAlbedoSpec) glDeleteTextures(1, &gAlbedoSpec);
+    if (gDepth) glDeleteTextures(1, &gDepth);
     if (lightingTexture) glDeleteTextures(1, &lightingTexture);
     if (finalPassTexture) glDeleteTextures(1, &finalPassTexture);
     if (rboDepth) glDeleteRenderbuffers(1, &rboDepth);
 }
 
 void DeferredRenderer::render() {
+    const PassClock::time_point start = PassClock::now();
+    frameRing.beginFrame();
+
+    if (camera) {
+        const glm::mat4 view = camera->getViewMatrix();
+        const glm::mat4& projection = camera->getProjectionMatrix();
+        const FrameData frameData{view, projection, glm::inverse(projection * view), glm::vec4(camera->getPosition(), 1.0f)};
+        StreamRange(GL_UNIFORM_BUFFER, FrameDataBinding, {{&frameData, sizeof(frameData)}},
+                    frameDataFallback, frameDataFallbackCapacity);
+    }
+
     RenderGeometryPass();
+    const PassClock::time_point geometryEnd = PassClock::now();
+    RenderShadowPass();
+    const PassClock::time_point shadowEnd = PassClock::now();
     RenderLightingPass();
+    const PassClock::time_point lightingEnd = PassClock::now();
     RenderFinalPass();
+    frameRing.endFrame();
+    const PassClock::time_point finalEnd = PassClock::now();
+
+    passTimings.geometry = ElapsedMilliseconds(start, geometryEnd);
+    passTimings.shadow = ElapsedMilliseconds(geometryEnd, shadowEnd);
+    passTimings.lighting = ElapsedMilliseconds(shadowEnd, lightingEnd);
+    passTimings.final = ElapsedMilliseconds(lightingEnd, finalEnd);
    // std::cerr << "DeferredRenderer Render Complete" << std::endl;
 }
 
@@ -77,7 +177,7 @@ void DeferredRenderer::initFullscreenQuad() {
 
     glGenVertexArrays(1, &quadVAO);
     glGenBuffers(1, &quadVBO);
-    glBindVertexArray(quadVAO);
+    IDK::Graphics::GLStateCache::Instance().bindVertexArray(quadVAO);
 
     glBindBuffer(GL_ARRAY_BUFFER, quadVBO);
     glBufferData(GL_ARRAY_BUFFER, sizeof(quadVertices), quadVertices, GL_STATIC_DRAW);
@@ -100,25 +200,33 @@ void DeferredRenderer::updateViewportFramebuffer(const int & viewportWidth,const
 
     if (gBuffer != 0) {
         glDeleteFramebuffers(1, &gBuffer);
-        glDeleteTextures(1, &gPosition);
+        if (gPosition) glDeleteTextures(1, &gPosition);
         glDeleteTextures(1, &gNormal);
         glDeleteTextures(1, &gAlbedoSpec);
-        glDeleteRenderbuffers(1, &rboDepth);
+        if (gDepth) glDeleteTextures(1, &gDepth);
+        if (rboDepth) glDeleteRenderbuffers(1, &rboDepth);
+        gPosition = gDepth = rboDepth = 0;
     }
 
+    // The compact layout has no position target and keeps depth in a texture
+    // the lighting pass can sample instead.
+    const bool compact = gBufferLayout == IDK::Graphics::GBufferLayout::Compact;
+
     glGenFramebuffers(1, &gBuffer);
     glBindFramebuffer(GL_FRAMEBUFFER, gBuffer);
 
-    glGenTextures(1, &gPosition);
-    glBindTexture(GL_TEXTURE_2D, gPosition);
-    glTexStorage2D(GL_TEXTURE_2D, 1, GL_RGB16F, width, height); // Immutable storage
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST); // Faster filtering
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, gPosition, 0);
+    if (!compact) {
+        glGenTextures(1, &gPosition);
+        glBindTexture(GL_TEXTURE_2D, gPosition);
+        glTexStorage2D(GL_TEXTURE_2D, 1, GL_RGB16F, width, height); // Immutable storage
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST); // Faster filtering
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, gPosition, 0);
+    }
 
     glGenTextures(1, &gNormal);
     glBindTexture(GL_TEXTURE_2D, gNormal);
-    glTexStorage2D(GL_TEXTURE_2D, 1, GL_RGB16F, width, height); // Immutable storage
+    glTexStorage2D(GL_TEXTURE_2D, 1, compact ? GL_RG16 : GL_RGB16F, width, height); // Immutable storage
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST); // Faster filtering
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
     glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT1, GL_TEXTURE_2D, gNormal, 0);
@@ -130,17 +238,30 @@ void DeferredRenderer::updateViewportFramebuffer(const int & viewportWidth,const
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
     glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT2, GL_TEXTURE_2D, gAlbedoSpec, 0);
 
-    constexpr GLuint attachments[3] = {
-        GL_COLOR_ATTACHMENT0,
+    const GLenum attachments[3] = {
+        static_cast<GLenum>(compact ? GL_NONE : GL_COLOR_ATTACHMENT0),
         GL_COLOR_ATTACHMENT1,
         GL_COLOR_ATTACHMENT2
     };
     glDrawBuffers(3, attachments);
 
-    glGenRenderbuffers(1, &rboDepth);
-    glBindRenderbuffer(GL_RENDERBUFFER, rboDepth);
-    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, width, height);
-    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, rboDepth);
+    if (compact) {
+        glGenTextures(1, &gDepth);
+        glBindTexture(GL_TEXTURE_2D, gDepth);
+        glTexStorage2D(GL_TEXTURE_2D, 1, GL_DEPTH_COMPONENT32F, width, height);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_TEXTURE_2D, gDepth, 0);
+    } else {
+        glGenRenderbuffers(1, &rboDepth);
+        glBindRenderbuffer(GL_RENDERBUFFER, rboDepth);
+        glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, width, height);
+        glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, rboDepth);
+    }
+
+    // Nominal bytes per pixel; drivers commonly pad RGB16F to 8 and DEPTH24 to 4.
+    const size_t bytesPerPixel = compact ? 4 + 4 + 4 : 6 + 6 + 4 + 4;
+    gBufferBytes = bytesPerPixel * static_cast<size_t>(width) * static_cast<size_t>(height);
 
     checkFramebufferStatus();
 
@@ -184,64 +305,281 @@ void DeferredRenderer::RenderGeometryPass()const {
     glViewport(0, 0, width, height);
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
-    glEnable(GL_DEPTH_TEST);
-    glDepthMask(GL_TRUE);
+    auto& glState = IDK::Graphics::GLStateCache::Instance();
+    glState.setDepthTest(true);
+    glState.setDepthMask(true);
 
     const auto& viewF = glm::mat4(camera->getViewMatrix());
     const auto& projectF = glm::mat4(camera->getProjectionMatrix());
 
+    RecordGeometry(viewF, projectF);
+    renderQueue.sort();
+
+    RenderInstanceBatches();
+
     shaderProgram->Use();
-    shaderProgram->setMat4("view", viewF);
-    shaderProgram->setMat4("projection", projectF);
+    shaderProgram->setMat4(u_view, viewF);
+    shaderProgram->setMat4(u_projection, projectF);
+    shaderProgram->setVec3(u_objectColor, glm::vec3(0.2f, 0.2f, 0.2f));
+    shaderProgram->setInt(u_packedNormals, gBufferLayout == IDK::Graphics::GBufferLayout::Compact);
+
+    RenderWireframes();
+    scene->DrawGrid(10.0, 1.0f);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+}
+
+// Scene traversal only; no GL calls until the queue is sorted.
+void DeferredRenderer::RecordGeometry(const glm::mat4& view, const glm::mat4& projection) const {
+    renderQueue.clear();
+    wireframeDraws.clear();
+    cullCandidates.clear();
+    frustumCuller.clear();
+
+    const Registry& registry = Registry::instance();
+    const IComponentManager* components = registry.getComponentManager();
+    const float farPlane = camera->getFarPlane();
 
-    for (const auto& obj : scene->getComponents()) {
+    registry.view<Transform, IDK::Components::MeshRenderer>().each(
+        [&](EntityID id, Transform& transform, const IDK::Components::MeshRenderer& meshRenderer) {
 
-        const auto transform = obj->getComponent<Transform>();
-        if (!transform) {
-            std::cerr << "[ERROR] Missing Transform for object: " << "\n";
-            continue;
+        const glm::mat4 model = transform.getModelMatrix();
+
+        int32_t bounds = -1;
+        if (const IDK::Graphics::Mesh* mesh = meshRenderer.getMesh()) {
+            cullCandidates.push_back({mesh, model});
+            bounds = static_cast<int32_t>(frustumCuller.add(IDK::AABB::Transform(mesh->getLocalBounds(), model)));
         }
 
-        glm::mat4 model = transform->getModelMatrix();
-        shaderProgram->setMat4("model", model);
+        if (auto collider = components->getComponent<Collider>(id))
+            wireframeDraws.push_back({collider, model, bounds});
+    });
+
+    frustumCuller.cull(IDK::Graphics::Frustum::FromMatrix(projection * view), cullVisibility);
+
+    for (size_t i = 0; i < cullCandidates.size(); ++i) {
+        if (!cullVisibility[i]) continue;
+
+        const CullCandidate& candidate = cullCandidates[i];
+        const float viewDepth = -(view * candidate.model[3]).z;
+        renderQueue.record(IDK::Graphics::RenderPass::Opaque, candidate.mesh, instancedShader.get(), nullptr,
+                           candidate.model, IDK::Graphics::SortKey::QuantizeDepth(viewDepth, farPlane));
+    }
+}
 
-        auto collider = obj->getComponent<Collider>();
-        if (collider) {
-            const GLuint & programID = shaderProgram->getProgramID();
+void DeferredRenderer::RenderInstanceBatches() const {
+    // Sorted commands come in (shader, material, mesh) runs, front to back within each.
+    const std::vector<glm::mat4>& transforms = renderQueue.getTransforms();
+    instanceBatcher.clear();
+    for (const IDK::Graphics::RenderCommand& command : renderQueue.getCommands())
+        instanceBatcher.add(command.mesh, command.shader, transforms[command.transform]);
+    instanceBatcher.build();
+
+    const std::vector<glm::mat4>& instances = instanceBatcher.getInstanceData();
+    if (instances.empty()) return;
+    const InstanceRange range = UploadInstances(instances);
+
+    // View and projection come from the FrameData block.
+    const IDK::Graphics::Shader* current = nullptr;
+    for (const IDK::Graphics::InstanceBatch& batch : instanceBatcher.getBatches()) {
+        if (batch.shader != current) {
+            current = batch.shader;
+            current->Use();
+            current->setVec3(u_objectColor, glm::vec3(0.2f, 0.2f, 0.2f));
+            current->setInt(u_packedNormals, gBufferLayout == IDK::Graphics::GBufferLayout::Compact);
+        }
+        batch.mesh->DrawInstanced(*current, range.buffer, range.baseInstance + batch.firstInstance,
+                                  static_cast<GLsizei>(batch.instanceCount));
+    }
+}
+
+// Instances normally go into the frame ring, addressed by base instance, so
+// meshes keep their instance attributes pointed at the ring across passes and
+// frames. Workers copy disjoint slices of large uploads in parallel. When the
+// ring is full this frame, instanceVBO is orphaned and refilled instead.
+DeferredRenderer::InstanceRange DeferredRenderer::UploadInstances(const std::vector<glm::mat4>& instances) const {
+    const size_t bytes = instances.size() * sizeof(glm::mat4);
+    if (const IDK::Graphics::RingAllocation allocation = frameRing.allocate(bytes, sizeof(glm::mat4))) {
+        glm::mat4* out = static_cast<glm::mat4*>(allocation.data);
+        if (jobs && instances.size() >= ParallelCopyInstances) {
+            jobs->parallelFor(instances.size(), ParallelCopyInstances / 2, [&](size_t begin, size_t end) {
+                std::memcpy(out + begin, instances.data() + begin, (end - begin) * sizeof(glm::mat4));
+            });
+        } else {
+            std::memcpy(out, instances.data(), bytes);
+        }
+        return {frameRing.getBuffer(), static_cast<GLuint>(allocation.offset / static_cast<GLintptr>(sizeof(glm::mat4)))};
+    }
 
-            shaderProgram->Use();
-            shaderProgram->setMat4("view", viewF);
-            shaderProgram->setMat4("projection", projectF);
-            shaderProgram->setMat4("model", model);
+    if (instanceVBO == 0)
+        glGenBuffers(1, &instanceVBO);
 
-            GLint wireframeLoc = glGetUniformLocation(programID, "wireframe");
-            GLint wireframeColorLoc = glGetUniformLocation(programID, "wireframeColor");
+    if (bytes > instanceVBOCapacity)
+        instanceVBOCapacity = std::max(bytes, instanceVBOCapacity * 2);
 
-            if (wireframeLoc == -1 || wireframeColorLoc == -1) {
-                std::cerr << "[ERROR] Uniform 'wireframe' or 'wireframeColor' not found in shader program.\n";
-            } else {
-                glUniform1i(wireframeLoc, GL_TRUE);
-                glUniform3f(wireframeColorLoc, 0.0f, 1.0f, 0.0f);
-            }
-            collider->Draw(*shaderProgram);
-            glUniform1i(wireframeLoc, GL_FALSE);
+    // Orphan the previous storage so the upload does not wait on draws still reading it.
+    glBindBuffer(GL_ARRAY_BUFFER, instanceVBO);
+    glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(instanceVBOCapacity), nullptr, GL_STREAM_DRAW);
+    glBufferSubData(GL_ARRAY_BUFFER, 0, static_cast<GLsizeiptr>(bytes), instances.data());
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    return {instanceVBO, 0};
+}
 
+// Copies the spans back to back into one ring range and binds it; falls back
+// to orphaning the given buffer when the ring is full this frame.
+void DeferredRenderer::StreamRange(GLenum target, GLuint binding, std::initializer_list<StreamSpan> spans,
+                                   GLuint& fallbackBuffer, size_t& fallbackCapacity) const {
+    size_t bytes = 0;
+    for (const StreamSpan& span : spans) bytes += span.bytes;
+
+    const size_t alignment = target == GL_UNIFORM_BUFFER ? frameRing.getUniformAlignment() : frameRing.getStorageAlignment();
+    if (const IDK::Graphics::RingAllocation allocation = frameRing.allocate(std::max<size_t>(bytes, 16), alignment)) {
+        uint8_t* out = static_cast<uint8_t*>(allocation.data);
+        for (const StreamSpan& span : spans) {
+            std::memcpy(out, span.data, span.bytes);
+            out += span.bytes;
         }
+        glBindBufferRange(target, binding, frameRing.getBuffer(), allocation.offset, allocation.size);
+        return;
+    }
+
+    ReserveStorage(target, fallbackBuffer, fallbackCapacity, binding, bytes);
+    GLintptr offset = 0;
+    for (const StreamSpan& span : spans) {
+        glBufferSubData(target, offset, static_cast<GLsizeiptr>(span.bytes), span.data);
+        offset += static_cast<GLintptr>(span.bytes);
+    }
+    glBindBuffer(target, 0);
+}
+
+void DeferredRenderer::RenderWireframes() const {
+    if (wireframeDraws.empty()) return;
+
+    if (!shaderProgram->hasUniform(u_wireframe) || !shaderProgram->hasUniform(u_wireframeColor)) {
+        std::cerr << "[ERROR] Uniform 'wireframe' or 'wireframeColor' not found in shader program.\n";
+    } else {
+        shaderProgram->setInt(u_wireframe, GL_TRUE);
+        shaderProgram->setVec3(u_wireframeColor, glm::vec3(0.0f, 1.0f, 0.0f));
+    }
+
+    for (const WireframeDraw& draw : wireframeDraws) {
+        if (draw.bounds >= 0 && !cullVisibility[draw.bounds]) continue;
+
+        shaderProgram->setMat4(u_model, draw.model);
+        draw.collider->Draw(*shaderProgram);
+    }
+    shaderProgram->setInt(u_wireframe, GL_FALSE);
+}
+
+void DeferredRenderer::CreateShadowMap() const {
+    const GLsizei resolution = static_cast<GLsizei>(shadowCascades.getSettings().resolution);
+
+    glGenTextures(1, &shadowMap);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, shadowMap);
+    glTexStorage3D(GL_TEXTURE_2D_ARRAY, 1, GL_DEPTH_COMPONENT32F, resolution, resolution, MaxShadowCascades);
+    // Linear filtering with compare mode gives 2x2 PCF per lookup.
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_COMPARE_MODE, GL_COMPARE_REF_TO_TEXTURE);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_COMPARE_FUNC, GL_LEQUAL);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_BORDER);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_BORDER);
+    constexpr float border[4] = {1.0f, 1.0f, 1.0f, 1.0f};
+    glTexParameterfv(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_BORDER_COLOR, border);
+
+    glGenFramebuffers(1, &shadowFramebuffer);
+    glBindFramebuffer(GL_FRAMEBUFFER, shadowFramebuffer);
+    glFramebufferTextureLayer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, shadowMap, 0, 0);
+    glDrawBuffer(GL_NONE);
+    glReadBuffer(GL_NONE);
+
+    if (const GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER); status != GL_FRAMEBUFFER_COMPLETE)
+        std::cerr << "[ERROR] Shadow Framebuffer is not complete! Status = 0x" << std::hex << status << std::dec << std::endl;
+
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+}
+
+// Fits the cascades to the camera, culls the geometry pass's candidates
+// against each cascade and draws the survivors' depth, one array layer per
+// cascade. All cascades' instances go up in a single upload.
+void DeferredRenderer::RenderShadowPass() const {
+    shadowCascadeCount = 0;
+    shadowCasterCount = 0;
+
+    const auto& dirLights = lightManager->getDirectionalLights();
+    if (dirLights.empty() || !dirLights.front() || !shadowDepthShader || !camera) {
+        StreamShadowData();
+        return;
+    }
 
-        if (const auto & meshRenderer = obj->getComponent<IDK::Components::MeshRenderer>())
-        {
-            shaderProgram->Use();
-            shaderProgram->setMat4("view", viewF);
-            shaderProgram->setMat4("projection", projectF);
-            shaderProgram->setMat4("model", model);
-            shaderProgram->setVec3("objectColor", glm::vec3(0.2f, 0.2f, 0.2f));
+    const glm::mat4& projection = camera->getProjectionMatrix();
+    shadowCascades.fit(camera->getViewMatrix(), glm::radians(camera->getFOV()), projection[1][1] / projection[0][0],
+                       camera->getNearPlane(), camera->getFarPlane(), dirLights.front()->getDirection());
+    shadowCascades.cullCasters(frustumCuller, casterVisibility);
+
+    const uint32_t cascadeCount = shadowCascades.getCascadeCount();
+    uint32_t cascadeBase[MaxShadowCascades] = {};
+    casterInstances.clear();
+    for (uint32_t c = 0; c < cascadeCount; ++c) {
+        IDK::Graphics::InstanceBatcher& batcher = casterBatchers[c];
+        batcher.clear();
+        for (size_t i = 0; i < cullCandidates.size(); ++i) {
+            if (casterVisibility[c][i])
+                batcher.add(cullCandidates[i].mesh, shadowDepthShader.get(), cullCandidates[i].model);
+        }
+        batcher.build();
 
-            meshRenderer->Render(shaderProgram.get());
+        cascadeBase[c] = static_cast<uint32_t>(casterInstances.size());
+        casterInstances.insert(casterInstances.end(), batcher.getInstanceData().begin(), batcher.getInstanceData().end());
+    }
+    shadowCasterCount = casterInstances.size();
+
+    if (shadowMap == 0)
+        CreateShadowMap();
+    const InstanceRange range = casterInstances.empty() ? InstanceRange{} : UploadInstances(casterInstances);
+
+    auto& glState = IDK::Graphics::GLStateCache::Instance();
+    glState.setDepthTest(true);
+    glState.setDepthMask(true);
+
+    const GLsizei resolution = static_cast<GLsizei>(shadowCascades.getSettings().resolution);
+    glBindFramebuffer(GL_FRAMEBUFFER, shadowFramebuffer);
+    glViewport(0, 0, resolution, resolution);
+
+    // Casters reaching past a cascade's near plane, toward the light, are
+    // flattened onto it rather than clipped; the offset keeps receivers from
+    // shadowing themselves.
+    glEnable(GL_DEPTH_CLAMP);
+    glEnable(GL_POLYGON_OFFSET_FILL);
+    glPolygonOffset(2.0f, 4.0f);
+
+    shadowDepthShader->Use();
+    for (uint32_t c = 0; c < cascadeCount; ++c) {
+        glFramebufferTextureLayer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, shadowMap, 0, static_cast<GLint>(c));
+        glClear(GL_DEPTH_BUFFER_BIT);
+
+        shadowDepthShader->setMat4(u_lightViewProjection, shadowCascades.getCascade(c).viewProjection);
+        for (const IDK::Graphics::InstanceBatch& batch : casterBatchers[c].getBatches()) {
+            batch.mesh->DrawInstanced(*shadowDepthShader, range.buffer, range.baseInstance + cascadeBase[c] + batch.firstInstance,
+                                      static_cast<GLsizei>(batch.instanceCount));
         }
     }
-    scene->DrawGrid(10.0, 1.0f);
 
+    glDisable(GL_POLYGON_OFFSET_FILL);
+    glDisable(GL_DEPTH_CLAMP);
     glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+    shadowCascadeCount = cascadeCount;
+    StreamShadowData();
+}
+
+void DeferredRenderer::StreamShadowData() const {
+    ShadowData shadowData{};
+    for (uint32_t c = 0; c < shadowCascadeCount; ++c)
+        shadowData.cascades[c] = shadowCascades.getCascade(c).viewProjection;
+    shadowData.cascadeCount.x = static_cast<int>(shadowCascadeCount);
+    StreamRange(GL_UNIFORM_BUFFER, ShadowDataBinding, {{&shadowData, sizeof(shadowData)}},
+                shadowDataFallback, shadowDataFallbackCapacity);
 }
 
 void DeferredRenderer::RenderLightingPass() const{
@@ -257,27 +595,21 @@ void DeferredRenderer::RenderLightingPass() const{
     glViewport(0, 0, width, height);
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
-    if (gPosition == 0 || gNormal == 0 || gAlbedoSpec == 0) {
+    if ((gPosition == 0 && gDepth == 0) || gNormal == 0 || gAlbedoSpec == 0) {
         std::cerr << "RenderLightingPass ERROR: One or more G-Buffer textures are invalid!" << std::endl;
         return;
     }
 
-    glActiveTexture(GL_TEXTURE0);
-    glBindTexture(GL_TEXTURE_2D, gPosition);
-    lightingShader->setInt("gPosition", 0);
-    //  std::cout << "[Scene] Bound gPosition texture ID: " << gPosition << " to GL_TEXTURE0.\n";
+    auto& glState = IDK::Graphics::GLStateCache::Instance();
+    BindGBuffer(*lightingShader);
 
-    glActiveTexture(GL_TEXTURE1);
-    glBindTexture(GL_TEXTURE_2D, gNormal);
-    lightingShader->setInt("gNormal", 1);
-    //  std::cout << "[Scene] Bound gNormal texture ID: " << gNormal << " to GL_TEXTURE1.\n";
-
-    glActiveTexture(GL_TEXTURE2);
-    glBindTexture(GL_TEXTURE_2D, gAlbedoSpec);
-    lightingShader->setInt("gAlbedoSpec", 2);
-    //  std::cout << "[Scene] Bound gAlbedoSpec texture ID: " << gAlbedoSpec << " to GL_TEXTURE2.\n";
+    // Camera and shadow cascades come from the FrameData and ShadowData blocks.
+    AssignClusteredLights(camera->getViewMatrix(), camera->getProjectionMatrix());
 
-     lightingShader->setVec3("viewPos", camera->getPosition());
+    // The sampler is pointed at its own unit even without shadows, so it never
+    // shares unit 0 with the sampler2D G-buffer inputs.
+    glState.bindTexture(ShadowMapUnit, GL_TEXTURE_2D_ARRAY, shadowMap);
+    lightingShader->setInt(u_shadowMap, static_cast<int>(ShadowMapUnit));
 
     static bool isMessagePrinted = false;
 
@@ -286,7 +618,7 @@ void DeferredRenderer::RenderLightingPass() const{
 
     for (const auto& dirLight : dirLights) {
         if (dirLight) {
-            dirLight->setUniforms(lightingShader->getProgramID());
+            dirLight->setUniforms(*lightingShader);
             test = true;
         }
     }
@@ -296,16 +628,64 @@ void DeferredRenderer::RenderLightingPass() const{
         isMessagePrinted = true;
     }
 
-    glEnable(GL_BLEND);
+    glState.setBlend(true);
 
-    glBindVertexArray(quadVAO);
+    glState.bindVertexArray(quadVAO);
     glDrawArrays(GL_TRIANGLES, 0, 6);
 
-    glBindVertexArray(0);
-
   //  std::cout << "[DefRenderer] Lighting pass completed.\n";
 }
 
+// Bins this frame's point and spot lights for the view and uploads the
+// result to the three storage buffers lightShader.frag reads.
+void DeferredRenderer::AssignClusteredLights(const glm::mat4& view, const glm::mat4& projection) const {
+    const PassClock::time_point start = PassClock::now();
+
+    const auto& pointLights = lightManager->getPointLights();
+    const auto& spotLights = lightManager->getSpotLights();
+    lightClusterer.clear();
+    lightClusterer.reserve(pointLights.size() + spotLights.size());
+
+    for (const auto& light : pointLights)
+        lightClusterer.addPointLight(light->getPosition(), light->range, light->color, light->intensity);
+    for (const auto& light : spotLights)
+        lightClusterer.addSpotLight(light->getPosition(), light->direction, light->range,
+                                    light->innerAngle, light->outerAngle, light->color, light->intensity);
+    lightClusterer.build(view, projection, jobs);
+
+    passTimings.lightBinning = ElapsedMilliseconds(start, PassClock::now());
+
+    const std::vector<IDK::Graphics::ClusterLight>& lights = lightClusterer.getLights();
+    const std::vector<glm::uvec2>& clusters = lightClusterer.getClusters();
+    const std::vector<uint32_t>& indices = lightClusterer.getLightIndices();
+    const IDK::Graphics::ClusterGridHeader& header = lightClusterer.getHeader();
+
+    StreamRange(GL_SHADER_STORAGE_BUFFER, 0, {{lights.data(), lights.size() * sizeof(IDK::Graphics::ClusterLight)}},
+                clusterLightSSBO, clusterLightCapacity);
+    StreamRange(GL_SHADER_STORAGE_BUFFER, 1, {{&header, sizeof(header)}, {clusters.data(), clusters.size() * sizeof(glm::uvec2)}},
+                clusterGridSSBO, clusterGridCapacity);
+    StreamRange(GL_SHADER_STORAGE_BUFFER, 2, {{indices.data(), indices.size() * sizeof(uint32_t)}},
+                clusterIndexSSBO, clusterIndexCapacity);
+}
+
+// Binds the G-buffer to units 0-2. The compact layout puts depth where
+// position would be; FrameData has the inverse view-projection to rebuild it.
+void DeferredRenderer::BindGBuffer(const IDK::Graphics::Shader& shader) const {
+    auto& glState = IDK::Graphics::GLStateCache::Instance();
+    const bool compact = gBufferLayout == IDK::Graphics::GBufferLayout::Compact;
+
+    glState.bindTexture(0, GL_TEXTURE_2D, compact ? gDepth : gPosition);
+    shader.setInt(compact ? "gDepth" : "gPosition", 0);
+
+    glState.bindTexture(1, GL_TEXTURE_2D, gNormal);
+    shader.setInt("gNormal", 1);
+
+    glState.bindTexture(2, GL_TEXTURE_2D, gAlbedoSpec);
+    shader.setInt("gAlbedoSpec", 2);
+
+    shader.setInt(u_compactGBuffer, compact);
+}
+
 void DeferredRenderer::RenderFinalPass() const {
     glBindFramebuffer(GL_FRAMEBUFFER, 0);
     glViewport(0, 0, width, height);
@@ -313,26 +693,16 @@ void DeferredRenderer::RenderFinalPass() const {
 
     finalPassShader->Use();
 
-    glActiveTexture(GL_TEXTURE0);
-    glBindTexture(GL_TEXTURE_2D, gPosition);
-    finalPassShader->setInt("gPosition", 0);
+    // Units 0-2 still hold the G-buffer from the lighting pass; the state cache skips the rebinds.
+    auto& glState = IDK::Graphics::GLStateCache::Instance();
+    BindGBuffer(*finalPassShader);
 
-    glActiveTexture(GL_TEXTURE1);
-    glBindTexture(GL_TEXTURE_2D, gNormal);
-    finalPassShader->setInt("gNormal", 1);
-
-    glActiveTexture(GL_TEXTURE2);
-    glBindTexture(GL_TEXTURE_2D, gAlbedoSpec);
-    finalPassShader->setInt("gAlbedoSpec", 2);
-
-    glActiveTexture(GL_TEXTURE3);
-    glBindTexture(GL_TEXTURE_2D, lightingTexture);
+    glState.bindTexture(3, GL_TEXTURE_2D, lightingTexture);
     finalPassShader->setInt("lightingTexture", 3);
 
     // Render a full-screen quad to combine the data
-    glBindVertexArray(quadVAO);
+    glState.bindVertexArray(quadVAO);
     glDrawArrays(GL_TRIANGLES, 0, 6);
-    glBindVertexArray(0);
 
     glBindFramebuffer(GL_FRAMEBUFFER, 0);
 }
@@ -382,6 +752,7 @@ void DeferredRenderer::resizeFramebuffer(int newWidth, int newHeight) {
     glDeleteTextures(1, &gPosition);
     glDeleteTextures(1, &gNormal);
     glDeleteTextures(1, &gAlbedoSpec);
+    glDeleteTextures(1, &gDepth);
     glDeleteTextures(1, &lightingTexture);
     glDeleteTextures(1, &finalPassTexture);
     glDeleteRenderbuffers(1, &rboDepth);
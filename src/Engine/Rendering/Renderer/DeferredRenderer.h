@@ -5,6 +5,7 @@
 #ifndef DEFERREDRENDERER_H
 #define DEFERREDRENDERER_H
 
+#include <initializer_list>
 #include <memory>
 #include <vector>
 
@@ -15,13 +16,25 @@
 
 #include "ShaderManager.h"
 #include "IRenderDeferred.h"
+#include "InstanceBatcher.h"
+#include "RenderQueue.h"
+#include "FrustumCulling.h"
+#include "FrameRingBuffer.h"
+#include "LightClusterer.h"
+#include "ShadowCascades.h"
 
 class Shader;
+class Collider;
+
+namespace IDK
+{
+    class JobSystem;
+}
 
 class DeferredRenderer final : public IRenderDeferred {
 public:
     DeferredRenderer(const std::shared_ptr<IDK::Scene>& scene, const std::shared_ptr<IDK::Graphics::Camera>& camera,
-                     GLFWwindow* window, const std::string& rendererType);
+                     GLFWwindow* window, const std::string& rendererType, IDK::JobSystem* jobs = nullptr);
     ~DeferredRenderer() override;
 
     void resizeFramebuffer(int width, int height) override;
@@ -35,6 +48,7 @@ public:
     void initFullscreenQuad();
 
     void RenderGeometryPass() const;
+    void RenderShadowPass() const;
     void RenderLightingPass() const;
     void RenderFinalPass() const;
 
@@ -52,12 +66,57 @@ public:
     GLuint getGAlbedoSpec() override {
         return gAlbedoSpec;
     }
+
+    // Layout used by renderers constructed afterwards.
+    static void SetDefaultGBufferLayout(IDK::Graphics::GBufferLayout layout) { s_defaultGBufferLayout = layout; }
+    IDK::Graphics::GBufferLayout getGBufferLayout() const { return gBufferLayout; }
+    // Bytes allocated for the G-buffer targets, depth included.
+    size_t getGBufferBytes() const { return gBufferBytes; }
+
+    // CPU time spent recording and submitting each pass of the last frame, in
+    // milliseconds. GPU execution is asynchronous and not part of it.
+    struct PassTimings {
+        double geometry = 0.0;
+        double shadow = 0.0;
+        double lighting = 0.0;
+        double lightBinning = 0.0;  // part of lighting
+        double final = 0.0;
+    };
+    const PassTimings& getPassTimings() const { return passTimings; }
+    const IDK::Graphics::LightClusterStats& getLightClusterStats() const { return lightClusterer.getStats(); }
+    // Instances drawn into the shadow cascades last frame, summed over cascades.
+    size_t getShadowCasterCount() const { return shadowCasterCount; }
+    const IDK::Graphics::RingStats& getFrameRingStats() const { return frameRing.getStats(); }
 private:
+    void RecordGeometry(const glm::mat4& view, const glm::mat4& projection) const;
+    void RenderInstanceBatches() const;
+    void RenderWireframes() const;
+    struct InstanceRange {
+        GLuint buffer = 0;
+        GLuint baseInstance = 0;
+    };
+    struct StreamSpan {
+        const void* data;
+        size_t bytes;
+    };
+    InstanceRange UploadInstances(const std::vector<glm::mat4>& instances) const;
+    void StreamRange(GLenum target, GLuint binding, std::initializer_list<StreamSpan> spans,
+                     GLuint& fallbackBuffer, size_t& fallbackCapacity) const;
+    void StreamShadowData() const;
+    void CreateShadowMap() const;
+    void AssignClusteredLights(const glm::mat4& view, const glm::mat4& projection) const;
+    void BindGBuffer(const IDK::Graphics::Shader& shader) const;
+
     GLuint gPosition, gNormal, gAlbedoSpec;
+    GLuint gDepth = 0;  // compact layout only, replaces rboDepth
+    IDK::Graphics::GBufferLayout gBufferLayout = s_defaultGBufferLayout;
+    size_t gBufferBytes = 0;
 
     std::shared_ptr<IDK::Graphics::Shader> shaderProgram = ShaderManager::Instance().getShaderProgram();
+    std::shared_ptr<IDK::Graphics::Shader> instancedShader = ShaderManager::Instance().getInstancedShaderProgram();
     std::shared_ptr<IDK::Graphics::Shader> lightingShader = ShaderManager::Instance().getLightShader();
     std::shared_ptr<IDK::Graphics::Shader> finalPassShader = ShaderManager::Instance().getFinalPassShader();
+    std::shared_ptr<IDK::Graphics::Shader> shadowDepthShader = ShaderManager::Instance().getShadowDepthShader();
 
     GLFWwindow* window;
     std::string rendererType;
@@ -71,9 +130,60 @@ private:
     GLuint quadVAO, quadVBO;
     int width, height;
 
+    // Wireframes are culled with their entity's mesh, as in ForwardRenderer;
+    // bounds is the mesh's cull index, -1 when the entity has no mesh.
+    struct WireframeDraw {
+        Collider* collider;
+        glm::mat4 model;
+        int32_t bounds;
+    };
+
+    struct CullCandidate {
+        const IDK::Graphics::Mesh* mesh;
+        glm::mat4 model;
+    };
+
+    // Geometry pass draws, recorded during traversal and submitted afterwards.
+    mutable IDK::Graphics::RenderQueue renderQueue;
+    mutable std::vector<WireframeDraw> wireframeDraws;
+    mutable std::vector<CullCandidate> cullCandidates;
+    mutable std::vector<uint8_t> cullVisibility;
+    mutable IDK::Graphics::FrustumCuller frustumCuller;
+    mutable IDK::Graphics::InstanceBatcher instanceBatcher;
+    mutable GLuint instanceVBO = 0;
+    mutable size_t instanceVBOCapacity = 0;
+
+    // Per-frame camera, shadow, light and instance data. The buffers below
+    // are only used for a frame whose data does not fit the ring.
+    mutable IDK::Graphics::FrameRingBuffer frameRing;
+    mutable GLuint frameDataFallback = 0, shadowDataFallback = 0;
+    mutable size_t frameDataFallbackCapacity = 0, shadowDataFallbackCapacity = 0;
+
+    // Point and spot lights binned per cluster, read by the lighting shader as
+    // SSBOs; the buffers here are the ring's fallback.
+    mutable IDK::Graphics::LightClusterer lightClusterer;
+    mutable GLuint clusterLightSSBO = 0, clusterGridSSBO = 0, clusterIndexSSBO = 0;
+    mutable size_t clusterLightCapacity = 0, clusterGridCapacity = 0, clusterIndexCapacity = 0;
+    IDK::JobSystem* jobs;
+
+    // Cascaded shadows of the first directional light. Casters come from the
+    // geometry pass's cull candidates, culled again per cascade.
+    static constexpr uint32_t MaxShadowCascades = IDK::Graphics::ShadowCascades::MaxCascades;
+    mutable IDK::Graphics::ShadowCascades shadowCascades;
+    mutable std::vector<uint8_t> casterVisibility[MaxShadowCascades];
+    mutable IDK::Graphics::InstanceBatcher casterBatchers[MaxShadowCascades];
+    mutable std::vector<glm::mat4> casterInstances;
+    mutable GLuint shadowMap = 0, shadowFramebuffer = 0;
+    mutable uint32_t shadowCascadeCount = 0;  // 0 when nothing cast shadows this frame
+    mutable size_t shadowCasterCount = 0;
+
     std::shared_ptr<IDK::Scene> scene;
     std::shared_ptr<IDK::Graphics::Camera> camera;
     std::shared_ptr<LightManager> lightManager;
+
+    mutable PassTimings passTimings;
+
+    static inline IDK::Graphics::GBufferLayout s_defaultGBufferLayout = IDK::Graphics::GBufferLayout::Standard;
 };
 
 
@@ -6,6 +6,17 @@
 
 #include "Collider.h"
 #include "MeshRenderer.h"
+#include "Registry.h"
+
+namespace
+{
+    const IDK::Graphics::UniformHandle u_view("view");
+    const IDK::Graphics::UniformHandle u_projection("projection");
+    const IDK::Graphics::UniformHandle u_model("model");
+    const IDK::Graphics::UniformHandle u_objectColor("objectColor");
+    const IDK::Graphics::UniformHandle u_wireframe("wireframe");
+    const IDK::Graphics::UniformHandle u_wireframeColor("wireframeColor");
+}
 
 ForwardRenderer::ForwardRenderer(const std::shared_ptr<IDK::Scene>& scene, const std::shared_ptr<IDK::Graphics::Camera>& camera,
                                  GLFWwindow* window, const std::string& rendererType)
@@ -38,53 +49,48 @@ void ForwardRenderer::render() {
     const auto& viewF = glm::mat4(camera->getViewMatrix());
     const auto& projectF = glm::mat4(camera->getProjectionMatrix());
 
+    // Collider and mesh draws share the program, so per-pass uniforms are set once.
     shaderProgram->Use();
-    shaderProgram->setMat4("view", viewF);
-    shaderProgram->setMat4("projection", projectF);
-
-    for (const auto& obj : scene->getComponents()) {
-        const auto transform = obj->getComponent<Transform>();
-        if (!transform) {
-            std::cerr << "[ERROR] Missing Transform for object: " << "\n";
-            continue;
-        }
+    shaderProgram->setMat4(u_view, viewF);
+    shaderProgram->setMat4(u_projection, projectF);
+    shaderProgram->setVec3(u_objectColor, glm::vec3(0.2f, 0.2f, 0.2f));
+
+    const bool hasWireframe = shaderProgram->hasUniform(u_wireframe) && shaderProgram->hasUniform(u_wireframeColor);
+
+    const Registry& registry = Registry::instance();
+    const IComponentManager* components = registry.getComponentManager();
 
-        glm::mat4 model = transform->getModelMatrix();
-        shaderProgram->setMat4("model", model);
+    drawItems.clear();
+    frustumCuller.clear();
 
-        auto collider = obj->getComponent<Collider>();
-        if (collider) {
-            const GLuint & programID = shaderProgram->getProgramID();
+    registry.view<Transform, IDK::Components::MeshRenderer>().each(
+        [&](EntityID id, Transform& transform, const IDK::Components::MeshRenderer& meshRenderer) {
 
-            shaderProgram->Use();
-            shaderProgram->setMat4("view", viewF);
-            shaderProgram->setMat4("projection", projectF);
-            shaderProgram->setMat4("model", model);
+        DrawItem item{&meshRenderer, components->getComponent<Collider>(id), transform.getModelMatrix(), -1};
+        if (const IDK::Graphics::Mesh* mesh = meshRenderer.getMesh())
+            item.bounds = static_cast<int32_t>(frustumCuller.add(IDK::AABB::Transform(mesh->getLocalBounds(), item.model)));
+        drawItems.push_back(item);
+    });
 
-            GLint wireframeLoc = glGetUniformLocation(programID, "wireframe");
-            GLint wireframeColorLoc = glGetUniformLocation(programID, "wireframeColor");
+    frustumCuller.cull(IDK::Graphics::Frustum::FromMatrix(projectF * viewF), cullVisibility);
 
-            if (wireframeLoc == -1 || wireframeColorLoc == -1) {
+    for (const DrawItem& item : drawItems) {
+        if (item.bounds >= 0 && !cullVisibility[item.bounds]) continue;
+
+        shaderProgram->setMat4(u_model, item.model);
+
+        if (Collider* collider = item.collider) {
+            if (!hasWireframe) {
                 std::cerr << "[ERROR] Uniform 'wireframe' or 'wireframeColor' not found in shader program.\n";
             } else {
-                glUniform1i(wireframeLoc, GL_TRUE);
-                glUniform3f(wireframeColorLoc, 0.0f, 1.0f, 0.0f);
+                shaderProgram->setInt(u_wireframe, GL_TRUE);
+                shaderProgram->setVec3(u_wireframeColor, glm::vec3(0.0f, 1.0f, 0.0f));
             }
             collider->Draw(*shaderProgram);
-            glUniform1i(wireframeLoc, GL_FALSE);
-
+            shaderProgram->setInt(u_wireframe, GL_FALSE);
         }
 
-        if (const auto & meshRenderer = obj->getComponent<IDK::Components::MeshRenderer>())
-        {
-            shaderProgram->Use();
-            shaderProgram->setMat4("view", viewF);
-            shaderProgram->setMat4("projection", projectF);
-            shaderProgram->setMat4("model", model);
-            shaderProgram->setVec3("objectColor", glm::vec3(0.2f, 0.2f, 0.2f));
-
-            meshRenderer->Render(shaderProgram.get());
-        }
+        item.meshRenderer->Render(shaderProgram.get());
     }
     glBindFramebuffer(GL_FRAMEBUFFER, 0);
 }
@@ -10,6 +10,10 @@
 #include "glad/glad.h"
 #include "GLFW/glfw3.h"
 #include "IRenderForward.h"
+#include "FrustumCulling.h"
+
+namespace IDK::Components { class MeshRenderer; }
+class Collider;
 
 class ForwardRenderer : public IRenderForward {
     std::shared_ptr<IDK::Scene> scene;
@@ -24,6 +28,17 @@ class ForwardRenderer : public IRenderForward {
     int height;
     std::shared_ptr<IDK::Graphics::Shader> shaderProgram = ShaderManager::Instance().getShaderProgram();
 
+    // Entities gathered for culling before any draw is issued.
+    struct DrawItem {
+        const IDK::Components::MeshRenderer* meshRenderer;
+        Collider* collider;
+        glm::mat4 model;
+        int32_t bounds; // index into the culler, -1 for entities without a mesh
+    };
+    std::vector<DrawItem> drawItems;
+    std::vector<uint8_t> cullVisibility;
+    IDK::Graphics::FrustumCuller frustumCuller;
+
 public:
     ForwardRenderer(const std::shared_ptr<IDK::Scene>& scene, const std::shared_ptr<IDK::Graphics::Camera>& camera,
                     GLFWwindow* window, const std::string& rendererType);
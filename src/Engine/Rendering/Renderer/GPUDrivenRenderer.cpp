@@ -0,0 +1,290 @@
+//
+// Created by SIMEON on 10/17/2026.
+//
+
+#include "GPUDrivenRenderer.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+
+#include "FrustumCulling.h"
+#include "GLStateCache.h"
+#include "Mesh.h"
+#include "MeshRenderer.h"
+#include "Registry.h"
+
+namespace
+{
+    const IDK::Graphics::UniformHandle u_objectCount("objectCount");
+    const IDK::Graphics::UniformHandle u_objectColor("objectColor");
+
+    // Blocks shared by gpuCull.comp, gpuDriven.vert and gpuDriven.frag.
+    constexpr GLuint FrameDataBinding = 0;
+    constexpr GLuint ObjectBinding = 0;
+    constexpr GLuint CommandBinding = 1;
+    constexpr GLuint CullStatsBinding = 2;
+
+    // Must match local_size_x in gpuCull.comp.
+    constexpr GLuint CullGroupSize = 64;
+
+    // Vertex buffer binding the per-object model matrix is fetched through.
+    constexpr GLuint ObjectVertexBinding = 2;
+
+    // std140 mirror of FrameData in the GPU-driven shaders.
+    struct FrameData {
+        glm::mat4 view;
+        glm::mat4 projection;
+        glm::vec4 frustumPlanes[6];
+        glm::vec4 lightDirection;  // w is 1 when the scene has a directional light
+        glm::vec4 lightAmbient;
+        glm::vec4 lightDiffuse;
+    };
+
+    // Layout glMultiDrawElementsIndirect reads.
+    struct DrawElementsIndirectCommand {
+        GLuint count;
+        GLuint instanceCount;
+        GLuint firstIndex;
+        GLint baseVertex;
+        GLuint baseInstance;
+    };
+
+    using PassClock = std::chrono::steady_clock;
+
+    double ElapsedMilliseconds(const PassClock::time_point start, const PassClock::time_point end) {
+        return std::chrono::duration<double, std::milli>(end - start).count();
+    }
+}
+
+GPUDrivenRenderer::GPUDrivenRenderer(const std::shared_ptr<IDK::Scene>& scene, const std::shared_ptr<IDK::Graphics::Camera>& camera,
+                                     GLFWwindow* window, const std::string& rendererType)
+    : scene(scene), camera(camera), window(window), rendererType(rendererType)
+{
+    std::cerr << "GPU_DRIVEN_RENDERER()" << std::endl;
+
+    if (!scene || !camera || !window) {
+        throw std::invalid_argument("One or more parameters are null");
+    }
+    scene->createObjects();
+}
+
+GPUDrivenRenderer::~GPUDrivenRenderer() {
+    resizeFramebuffer(0, 0);
+    if (frameDataFallback) glDeleteBuffers(1, &frameDataFallback);
+    if (objectFallback) glDeleteBuffers(1, &objectFallback);
+    if (commandBuffer) glDeleteBuffers(1, &commandBuffer);
+    if (cullStatsBuffer) glDeleteBuffers(1, &cullStatsBuffer);
+}
+
+void GPUDrivenRenderer::render() {
+    if (!drawShader || !cullShader || !camera) return;
+
+    const PassClock::time_point start = PassClock::now();
+    frameRing.beginFrame();
+
+    const glm::mat4 view = camera->getViewMatrix();
+    const glm::mat4& projection = camera->getProjectionMatrix();
+
+    FrameData frameData{view, projection, {}, glm::vec4(0.0f), glm::vec4(0.0f), glm::vec4(0.0f)};
+    const IDK::Graphics::Frustum frustum = IDK::Graphics::Frustum::FromMatrix(projection * view);
+    std::copy(std::begin(frustum.planes), std::end(frustum.planes), frameData.frustumPlanes);
+
+    const auto& dirLights = scene->getLightManager()->getDirectionalLights();
+    if (!dirLights.empty() && dirLights.front()) {
+        frameData.lightDirection = glm::vec4(glm::normalize(dirLights.front()->getDirection()), 1.0f);
+        frameData.lightAmbient = glm::vec4(dirLights.front()->getAmbient(), 0.0f);
+        frameData.lightDiffuse = glm::vec4(dirLights.front()->getDiffuse(), 0.0f);
+    }
+    Stream(GL_UNIFORM_BUFFER, FrameDataBinding, &frameData, sizeof(frameData), frameRing.getUniformAlignment(),
+           frameDataFallback, frameDataFallbackCapacity);
+
+    GatherObjects();
+    objectCount = objects.size();
+
+    const StreamedRange objectRange = Stream(GL_SHADER_STORAGE_BUFFER, ObjectBinding, objects.data(),
+                                             objects.size() * sizeof(GPUObject), frameRing.getStorageAlignment(),
+                                             objectFallback, objectFallbackCapacity);
+    ReserveCommands(objectCount);
+    const PassClock::time_point uploadEnd = PassClock::now();
+
+    // One invocation per object: test its world bounds against the frustum
+    // and write its command, keeping the draw order stable.
+    if (objectCount > 0) {
+        constexpr GLuint zero = 0;
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, cullStatsBuffer);
+        glBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, sizeof(zero), &zero);
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, CullStatsBinding, cullStatsBuffer);
+        glBindBufferRange(GL_SHADER_STORAGE_BUFFER, CommandBinding, commandBuffer, 0,
+                          static_cast<GLsizeiptr>(objectCount * sizeof(DrawElementsIndirectCommand)));
+
+        cullShader->Use();
+        cullShader->setInt(u_objectCount, static_cast<int>(objectCount));
+        glDispatchCompute(static_cast<GLuint>((objectCount + CullGroupSize - 1) / CullGroupSize), 1, 1);
+        glMemoryBarrier(GL_COMMAND_BARRIER_BIT);
+    }
+    const PassClock::time_point cullEnd = PassClock::now();
+
+    glBindFramebuffer(GL_FRAMEBUFFER, FBO);
+    glViewport(0, 0, width, height);
+    glClearColor(0.1f, 0.1f, 0.1f, 1.0f);
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+    if (objectCount > 0) {
+        auto& glState = IDK::Graphics::GLStateCache::Instance();
+        glState.setDepthTest(true);
+        glState.setDepthMask(true);
+
+        drawShader->Use();
+        drawShader->setVec3(u_objectColor, glm::vec3(0.2f, 0.2f, 0.2f));
+
+        glState.bindVertexArray(meshArena.getVertexArray());
+        SetupObjectAttributes();
+        glBindVertexBuffer(ObjectVertexBinding, objectRange.buffer, objectRange.offset, sizeof(GPUObject));
+
+        glBindBuffer(GL_DRAW_INDIRECT_BUFFER, commandBuffer);
+        glMultiDrawElementsIndirect(GL_TRIANGLES, GL_UNSIGNED_INT, nullptr, static_cast<GLsizei>(objectCount), 0);
+        glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+    }
+
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    frameRing.endFrame();
+    const PassClock::time_point drawEnd = PassClock::now();
+
+    passTimings.upload = ElapsedMilliseconds(start, uploadEnd);
+    passTimings.cull = ElapsedMilliseconds(uploadEnd, cullEnd);
+    passTimings.draw = ElapsedMilliseconds(cullEnd, drawEnd);
+}
+
+void GPUDrivenRenderer::GatherObjects() {
+    objects.clear();
+
+    Registry::instance().view<Transform, IDK::Components::MeshRenderer>().each(
+        [&](EntityID, Transform& transform, const IDK::Components::MeshRenderer& meshRenderer) {
+
+        const IDK::Graphics::Mesh* mesh = meshRenderer.getMesh();
+        if (!mesh) return;
+        const IDK::Graphics::MeshRange* range = meshArena.acquire(*mesh);
+        if (!range) return;
+
+        const IDK::AABB& bounds = mesh->getLocalBounds();
+        objects.push_back({transform.getModelMatrix(), glm::vec4(bounds.center(), 1.0f), glm::vec4(bounds.extents(), 0.0f),
+                           range->indexCount, range->firstIndex, range->baseVertex, 0});
+    });
+}
+
+// Copies the data into the frame ring and binds the range. A frame that does
+// not fit the ring falls back to an orphaned buffer of its own.
+GPUDrivenRenderer::StreamedRange GPUDrivenRenderer::Stream(GLenum target, GLuint binding, const void* data, size_t bytes,
+                                                           size_t alignment, GLuint& fallbackBuffer, size_t& fallbackCapacity) {
+    if (bytes == 0) return {};
+
+    if (const IDK::Graphics::RingAllocation allocation = frameRing.allocate(bytes, alignment)) {
+        std::memcpy(allocation.data, data, bytes);
+        glBindBufferRange(target, binding, frameRing.getBuffer(), allocation.offset, allocation.size);
+        return {frameRing.getBuffer(), allocation.offset, allocation.size};
+    }
+
+    if (fallbackBuffer == 0)
+        glGenBuffers(1, &fallbackBuffer);
+    if (bytes > fallbackCapacity)
+        fallbackCapacity = std::max(bytes, fallbackCapacity * 2);
+
+    glBindBuffer(target, fallbackBuffer);
+    glBufferData(target, static_cast<GLsizeiptr>(fallbackCapacity), nullptr, GL_STREAM_DRAW);
+    glBufferSubData(target, 0, static_cast<GLsizeiptr>(bytes), data);
+    glBindBufferRange(target, binding, fallbackBuffer, 0, static_cast<GLsizeiptr>(bytes));
+    return {fallbackBuffer, 0, static_cast<GLsizeiptr>(bytes)};
+}
+
+void GPUDrivenRenderer::ReserveCommands(size_t count) {
+    if (cullStatsBuffer == 0) {
+        glGenBuffers(1, &cullStatsBuffer);
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, cullStatsBuffer);
+        glBufferData(GL_SHADER_STORAGE_BUFFER, sizeof(GLuint), nullptr, GL_DYNAMIC_READ);
+    }
+
+    if (count <= commandCapacity) return;
+
+    commandCapacity = std::max(count, commandCapacity * 2);
+    if (commandBuffer == 0)
+        glGenBuffers(1, &commandBuffer);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, commandBuffer);
+    glBufferData(GL_SHADER_STORAGE_BUFFER, static_cast<GLsizeiptr>(commandCapacity * sizeof(DrawElementsIndirectCommand)),
+                 nullptr, GL_DYNAMIC_COPY);
+}
+
+// The model matrix is four vec4 attributes (locations 3-6, as for
+// Mesh::DrawInstanced) advancing once per instance, so each command's base
+// instance selects its object. The arena VAO keeps this format; only the
+// buffer range is bound per frame.
+void GPUDrivenRenderer::SetupObjectAttributes() {
+    if (objectAttributesReady) return;
+
+    for (GLuint column = 0; column < 4; ++column) {
+        const GLuint location = IDK::Graphics::Mesh::InstanceModelLocation + column;
+        glEnableVertexAttribArray(location);
+        glVertexAttribFormat(location, 4, GL_FLOAT, GL_FALSE,
+                             static_cast<GLuint>(offsetof(GPUObject, model) + column * sizeof(glm::vec4)));
+        glVertexAttribBinding(location, ObjectVertexBinding);
+    }
+    glVertexBindingDivisor(ObjectVertexBinding, 1);
+    objectAttributesReady = true;
+}
+
+size_t GPUDrivenRenderer::readVisibleCount() const {
+    if (cullStatsBuffer == 0 || objectCount == 0) return 0;
+
+    GLuint visible = 0;
+    glMemoryBarrier(GL_BUFFER_UPDATE_BARRIER_BIT);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, cullStatsBuffer);
+    glGetBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, sizeof(visible), &visible);
+    return visible;
+}
+
+void GPUDrivenRenderer::updateFramebuffer(int viewportWidth, int viewportHeight) {
+    if (viewportWidth == this->width && viewportHeight == this->height)
+        return;
+
+    resizeFramebuffer(viewportWidth, viewportHeight);
+    if (viewportWidth <= 0 || viewportHeight <= 0)
+        return;
+
+    this->width = viewportWidth;
+    this->height = viewportHeight;
+
+    glGenFramebuffers(1, &FBO);
+    glBindFramebuffer(GL_FRAMEBUFFER, FBO);
+
+    glGenTextures(1, &colorTexture);
+    glBindTexture(GL_TEXTURE_2D, colorTexture);
+    glTexStorage2D(GL_TEXTURE_2D, 1, GL_RGBA8, width, height);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, colorTexture, 0);
+
+    glGenRenderbuffers(1, &RBO);
+    glBindRenderbuffer(GL_RENDERBUFFER, RBO);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, width, height);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, RBO);
+
+    if (const GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER); status != GL_FRAMEBUFFER_COMPLETE) {
+        std::cerr << "[ERROR] GPU-driven framebuffer is not complete! Status = 0x" << std::hex << status << std::dec << std::endl;
+    }
+
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+    std::cout << "GPUDrivenRenderer::framebuffer updated." << std::endl;
+}
+
+void GPUDrivenRenderer::resizeFramebuffer(int, int) {
+    if (FBO) glDeleteFramebuffers(1, &FBO);
+    if (colorTexture) glDeleteTextures(1, &colorTexture);
+    if (RBO) glDeleteRenderbuffers(1, &RBO);
+    FBO = colorTexture = RBO = 0;
+    width = height = 0;
+}
@@ -0,0 +1,119 @@
+//
+// Created by SIMEON on 10/17/2026.
+//
+
+#ifndef GPUDRIVENRENDERER_H
+#define GPUDRIVENRENDERER_H
+
+#include <memory>
+#include <vector>
+
+#include "Scene.h"
+#include "Camera.h"
+#include "glad/glad.h"
+#include "GLFW/glfw3.h"
+
+#include "ShaderManager.h"
+#include "IRenderForward.h"
+#include "FrameRingBuffer.h"
+#include "MeshArena.h"
+
+// Draws every mesh in the scene with one glMultiDrawElementsIndirect call.
+// Geometry comes from a MeshArena; per-object transforms, local bounds and
+// arena ranges are streamed through the frame ring into an SSBO, from which
+// a compute shader frustum-culls each object and writes its indirect command
+// (instance count 0 when culled). The CPU never sees the visibility results.
+//
+// Only needs GL 4.5 core: commands are written one per object so no
+// indirect count is required, and the vertex shader gets the object's
+// transform as an instanced attribute fetched at the command's base instance
+// instead of relying on gl_DrawID. Colliders and the grid are not drawn.
+class GPUDrivenRenderer final : public IRenderForward {
+public:
+    GPUDrivenRenderer(const std::shared_ptr<IDK::Scene>& scene, const std::shared_ptr<IDK::Graphics::Camera>& camera,
+                      GLFWwindow* window, const std::string& rendererType);
+    ~GPUDrivenRenderer() override;
+
+    void render() override;
+    void resizeFramebuffer(int width, int height) override;
+    GLuint getFramebuffer() const override { return FBO; }
+    GLuint getTexture() const override { return colorTexture; }
+    int getFBOWidth() const override { return width; }
+    int getFBOHeight() const override { return height; }
+
+    void updateFramebuffer(int viewportWidth, int viewportHeight) override;
+
+    // CPU time of the last frame, in milliseconds, like DeferredRenderer's.
+    struct PassTimings {
+        double upload = 0.0;  // scene walk, arena updates and streaming object data
+        double cull = 0.0;    // compute dispatch
+        double draw = 0.0;    // the multi-draw
+    };
+    const PassTimings& getPassTimings() const { return passTimings; }
+
+    // Objects submitted last frame; every one is a command in the multi-draw.
+    size_t getObjectCount() const { return objectCount; }
+    // Objects the compute pass kept last frame. Reads back from the GPU and
+    // waits for it, so it is meant for benchmarks, not the frame loop.
+    size_t readVisibleCount() const;
+
+    const IDK::Graphics::MeshArenaStats& getMeshArenaStats() const { return meshArena.getStats(); }
+    const IDK::Graphics::RingStats& getFrameRingStats() const { return frameRing.getStats(); }
+
+private:
+    struct StreamedRange {
+        GLuint buffer = 0;
+        GLintptr offset = 0;
+        GLsizeiptr size = 0;
+    };
+
+    void GatherObjects();
+    StreamedRange Stream(GLenum target, GLuint binding, const void* data, size_t bytes, size_t alignment,
+                         GLuint& fallbackBuffer, size_t& fallbackCapacity);
+    void ReserveCommands(size_t count);
+    void SetupObjectAttributes();
+
+    std::shared_ptr<IDK::Scene> scene;
+    std::shared_ptr<IDK::Graphics::Camera> camera;
+    GLFWwindow* window;
+    std::string rendererType;
+
+    GLuint FBO = 0;
+    GLuint colorTexture = 0;
+    GLuint RBO = 0;
+    int width = 0;
+    int height = 0;
+
+    std::shared_ptr<IDK::Graphics::Shader> drawShader = ShaderManager::Instance().getGPUDrivenShader();
+    std::shared_ptr<IDK::Graphics::Shader> cullShader = ShaderManager::Instance().getGPUCullShader();
+
+    // std430 mirror of ObjectData in gpuCull.comp; also read as the
+    // instanced model matrix by gpuDriven.vert.
+    struct GPUObject {
+        glm::mat4 model;
+        glm::vec4 boundsCenter;   // object space
+        glm::vec4 boundsExtents;
+        uint32_t indexCount;
+        uint32_t firstIndex;
+        int32_t baseVertex;
+        uint32_t padding;
+    };
+    static_assert(sizeof(GPUObject) == 112, "GPUObject must match the std430 layout");
+
+    IDK::Graphics::MeshArena meshArena;
+    std::vector<GPUObject> objects;
+    size_t objectCount = 0;
+
+    IDK::Graphics::FrameRingBuffer frameRing;
+    GLuint frameDataFallback = 0, objectFallback = 0;
+    size_t frameDataFallbackCapacity = 0, objectFallbackCapacity = 0;
+
+    GLuint commandBuffer = 0;       // written by the compute pass, read by the multi-draw
+    size_t commandCapacity = 0;     // in commands
+    GLuint cullStatsBuffer = 0;     // visible object counter
+    bool objectAttributesReady = false;
+
+    PassTimings passTimings;
+};
+
+#endif //GPUDRIVENRENDERER_H
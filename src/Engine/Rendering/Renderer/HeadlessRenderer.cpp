@@ -0,0 +1,274 @@
+//
+// Created by SIMEON on 10/17/2026.
+//
+
+#include "HeadlessRenderer.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+
+#include "Cube.h"
+#include "DeferredRenderer.h"
+#include "FrameArena.h"
+#include "GLStateCache.h"
+#include "GPUDrivenRenderer.h"
+#include "HeapCounter.h"
+#include "SceneManager.h"
+#include "Shader.h"
+#include "TransformHierarchy.h"
+
+namespace
+{
+    using FrameClock = std::chrono::steady_clock;
+
+    double ElapsedMilliseconds(const FrameClock::time_point start, const FrameClock::time_point end) {
+        return std::chrono::duration<double, std::milli>(end - start).count();
+    }
+
+    std::string JsonEscape(const char* text) {
+        std::string escaped;
+        for (const char* c = text ? text : ""; *c; ++c) {
+            if (*c == '"' || *c == '\\') escaped += '\\';
+            if (static_cast<unsigned char>(*c) >= 0x20) escaped += *c;
+        }
+        return escaped;
+    }
+
+    void WriteSeries(std::ostream& out, const char* name, const std::vector<double>& values, bool last) {
+        std::vector<double> sorted = values;
+        std::sort(sorted.begin(), sorted.end());
+
+        double sum = 0.0;
+        for (const double value : values) sum += value;
+
+        const auto percentile = [&](double p) {
+            const size_t index = static_cast<size_t>(std::ceil(p * static_cast<double>(sorted.size()))) - 1;
+            return sorted[std::min(index, sorted.size() - 1)];
+        };
+
+        out << "    \"" << name << "\": {"
+            << "\"mean\": " << sum / static_cast<double>(values.size())
+            << ", \"median\": " << percentile(0.5)
+            << ", \"p95\": " << percentile(0.95)
+            << ", \"min\": " << sorted.front()
+            << ", \"max\": " << sorted.back()
+            << ", \"samples\": [";
+        for (size_t i = 0; i < values.size(); ++i)
+            out << (i ? ", " : "") << values[i];
+        out << "]}" << (last ? "\n" : ",\n");
+    }
+}
+
+namespace IDK
+{
+    HeadlessRenderer::HeadlessRenderer(const std::shared_ptr<Scene>& scene, const std::shared_ptr<Graphics::Camera>& camera,
+                                       GLFWwindow* window, const EngineSystems::Config& config, JobSystem* jobs)
+        : m_Settings(config.headless),
+        m_Width(config.window.width),
+        m_Height(config.window.height),
+        m_Scene(scene),
+        m_Camera(camera)
+    {
+        if (config.graphics.rendererType == "gpu") {
+            m_GPUDriven = std::make_unique<GPUDrivenRenderer>(scene, camera, window, "GPU");
+            m_GPUDriven->updateFramebuffer(m_Width, m_Height);
+        } else {
+            if (config.graphics.rendererType != "deferred")
+                std::cerr << "[Headless] Renderer type '" << config.graphics.rendererType << "' ignored, benchmarking deferred." << std::endl;
+
+            m_Deferred = std::make_unique<DeferredRenderer>(scene, camera, window, "Deferred", jobs);
+            m_Deferred->updateViewportFramebuffer(m_Width, m_Height);
+        }
+
+        generateScene();
+    }
+
+    HeadlessRenderer::~HeadlessRenderer() {
+        for (const std::shared_ptr<Entity>& entity : m_Generated)
+            SceneManager::getInstance().removeEntity(entity);
+    }
+
+    // A square grid in front of the default camera, with point lights (every
+    // fourth one a downward spot) hovering over it. Positions depend only on
+    // the index so every run sees the same scene.
+    void HeadlessRenderer::generateScene() {
+        const uint32_t count = m_Settings.objectCount;
+        const uint32_t side = std::max(1u, static_cast<uint32_t>(std::ceil(std::sqrt(static_cast<double>(count)))));
+        constexpr float spacing = 2.0f;
+
+        m_Generated.reserve(count);
+        for (uint32_t i = 0; i < count; ++i) {
+            const Cube cube("Benchmark Cube " + std::to_string(i));
+            const std::shared_ptr<Entity> entity = cube.getEntity();
+
+            const float x = (static_cast<float>(i % side) - 0.5f * static_cast<float>(side)) * spacing;
+            const float z = 2.0f + static_cast<float>(i / side) * spacing;
+            entity->getComponent<Transform>()->setPosition(glm::vec3(x, 0.6f + static_cast<float>(i % 3), z));
+
+            SceneManager::getInstance().addEntity(entity);
+            m_Generated.push_back(entity);
+        }
+
+        const std::shared_ptr<LightManager> lightManager = m_Scene->getLightManager();
+        const uint32_t lightCount = m_Settings.lightCount;
+        const uint32_t lightSide = std::max(1u, static_cast<uint32_t>(std::ceil(std::sqrt(static_cast<double>(lightCount)))));
+        const float lightSpacing = spacing * static_cast<float>(side) / static_cast<float>(lightSide);
+
+        for (uint32_t i = 0; i < lightCount; ++i) {
+            const float x = (static_cast<float>(i % lightSide) - 0.5f * static_cast<float>(lightSide)) * lightSpacing;
+            const float z = 2.0f + static_cast<float>(i / lightSide) * lightSpacing;
+            const glm::vec3 position(x, 4.0f, z);
+            const glm::vec3 color(0.4f + 0.6f * static_cast<float>(i % 3 == 0), 0.4f + 0.6f * static_cast<float>(i % 3 == 1),
+                                  0.4f + 0.6f * static_cast<float>(i % 3 == 2));
+            const std::string name = "Benchmark Light " + std::to_string(i);
+
+            if (i % 4 == 3) {
+                lightManager->addSpotLight(std::make_shared<SpotLight>(name, position, glm::vec3(0.0f, -1.0f, 0.0f), color,
+                                                                       8.0f, 10.0f, glm::radians(25.0f), glm::radians(35.0f)));
+            } else {
+                lightManager->addPointLight(std::make_shared<PointLight>(name, position, color, 4.0f, 6.0f));
+            }
+        }
+
+        std::cout << "[Headless] Generated " << count << " cubes in a " << side << "x" << side << " grid and "
+                  << lightCount << " lights." << std::endl;
+    }
+
+    bool HeadlessRenderer::run() {
+        const uint32_t totalFrames = m_Settings.warmupFrames + m_Settings.frameCount;
+        m_Samples.clear();
+        m_Samples.reserve(m_Settings.frameCount);
+
+        for (uint32_t frame = 0; frame < totalFrames; ++frame) {
+            const size_t heapAllocationsBefore = HeapCounter::GetAllocationCount();
+            const FrameClock::time_point start = FrameClock::now();
+
+            TransformHierarchy::Instance().update();
+            m_Scene->updateSpatialIndex();
+            const FrameClock::time_point updateEnd = FrameClock::now();
+
+            if (m_GPUDriven)
+                m_GPUDriven->render();
+            else
+                m_Deferred->render();
+
+            // Without a swap to pace frames, wait for the GPU so one frame's
+            // work does not spill into the next frame's timings.
+            glFinish();
+            const FrameClock::time_point end = FrameClock::now();
+
+            if (frame >= m_Settings.warmupFrames) {
+                FrameSample sample;
+                sample.sceneUpdate = ElapsedMilliseconds(start, updateEnd);
+                sample.frame = ElapsedMilliseconds(start, end);
+                sample.heapAllocations = HeapCounter::GetAllocationCount() - heapAllocationsBefore;
+
+                if (m_GPUDriven) {
+                    const GPUDrivenRenderer::PassTimings& passes = m_GPUDriven->getPassTimings();
+                    sample.upload = passes.upload;
+                    sample.cull = passes.cull;
+                    sample.draw = passes.draw;
+                } else {
+                    const DeferredRenderer::PassTimings& passes = m_Deferred->getPassTimings();
+                    sample.geometry = passes.geometry;
+                    sample.shadow = passes.shadow;
+                    sample.lighting = passes.lighting;
+                    sample.lightBinning = passes.lightBinning;
+                    sample.final = passes.final;
+                }
+                m_Samples.push_back(sample);
+            }
+
+            if (m_GPUDriven) {
+                // Culling happened on the GPU; the CPU culler saw nothing.
+                const size_t visible = m_GPUDriven->readVisibleCount();
+                m_LastCullingStats = {visible, m_GPUDriven->getObjectCount() - visible};
+            } else {
+                m_LastCullingStats = Graphics::FrustumCuller::GetStats();
+                m_LastLightStats = m_Deferred->getLightClusterStats();
+                m_LastShadowCasters = m_Deferred->getShadowCasterCount();
+            }
+            Graphics::FrustumCuller::ResetStats();
+            Graphics::Shader::ResetUniformStats();
+            Graphics::GLStateCache::Instance().resetStats();
+            FrameArena::Instance().endFrame();
+        }
+
+        if (m_Samples.empty()) {
+            std::cerr << "[Headless] No frames measured." << std::endl;
+            return false;
+        }
+        return writeReport();
+    }
+
+    bool HeadlessRenderer::writeReport() const {
+        std::ofstream out(m_Settings.reportPath);
+        if (!out) {
+            std::cerr << "[Headless] Cannot write report to " << m_Settings.reportPath << std::endl;
+            return false;
+        }
+
+        const auto series = [&](double FrameSample::*field) {
+            std::vector<double> values;
+            values.reserve(m_Samples.size());
+            for (const FrameSample& sample : m_Samples) values.push_back(sample.*field);
+            return values;
+        };
+
+        size_t heapAllocations = 0;
+        for (const FrameSample& sample : m_Samples) heapAllocations += sample.heapAllocations;
+
+        const Graphics::RingStats& ringStats = m_GPUDriven ? m_GPUDriven->getFrameRingStats() : m_Deferred->getFrameRingStats();
+
+        out << "{\n"
+            << "  \"renderer\": \"" << (m_GPUDriven ? "gpu" : "deferred") << "\",\n"
+            << "  \"glRenderer\": \"" << JsonEscape(reinterpret_cast<const char*>(glGetString(GL_RENDERER))) << "\",\n"
+            << "  \"glVersion\": \"" << JsonEscape(reinterpret_cast<const char*>(glGetString(GL_VERSION))) << "\",\n"
+            << "  \"width\": " << m_Width << ",\n"
+            << "  \"height\": " << m_Height << ",\n";
+        if (m_GPUDriven) {
+            out << "  \"meshArenaMeshes\": " << m_GPUDriven->getMeshArenaStats().meshes << ",\n"
+                << "  \"meshArenaBytes\": " << m_GPUDriven->getMeshArenaStats().capacityBytes << ",\n";
+        } else {
+            out << "  \"gBufferLayout\": \""
+                << (m_Deferred->getGBufferLayout() == Graphics::GBufferLayout::Compact ? "compact" : "standard") << "\",\n"
+                << "  \"gBufferBytes\": " << m_Deferred->getGBufferBytes() << ",\n";
+        }
+        out << "  \"objects\": " << m_Settings.objectCount << ",\n"
+            << "  \"warmupFrames\": " << m_Settings.warmupFrames << ",\n"
+            << "  \"frames\": " << m_Samples.size() << ",\n"
+            << "  \"visible\": " << m_LastCullingStats.visible << ",\n"
+            << "  \"culled\": " << m_LastCullingStats.culled << ",\n";
+        if (!m_GPUDriven) {
+            out << "  \"lights\": " << m_LastLightStats.lights << ",\n"
+                << "  \"lightReferences\": " << m_LastLightStats.references << ",\n"
+                << "  \"lightOverflow\": " << m_LastLightStats.overflowed << ",\n"
+                << "  \"shadowCasters\": " << m_LastShadowCasters << ",\n";
+        }
+        out << "  \"frameRingBytes\": " << ringStats.bytesUsed << ",\n"
+            << "  \"frameRingCapacity\": " << ringStats.capacity << ",\n"
+            << "  \"frameRingFenceWaits\": " << ringStats.fenceWaits << ",\n"
+            << "  \"heapAllocationsPerFrame\": " << heapAllocations / m_Samples.size() << ",\n"
+            << "  \"timingsMs\": {\n";
+        WriteSeries(out, "sceneUpdate", series(&FrameSample::sceneUpdate), false);
+        if (m_GPUDriven) {
+            WriteSeries(out, "upload", series(&FrameSample::upload), false);
+            WriteSeries(out, "cull", series(&FrameSample::cull), false);
+            WriteSeries(out, "draw", series(&FrameSample::draw), false);
+        } else {
+            WriteSeries(out, "geometry", series(&FrameSample::geometry), false);
+            WriteSeries(out, "shadow", series(&FrameSample::shadow), false);
+            WriteSeries(out, "lighting", series(&FrameSample::lighting), false);
+            WriteSeries(out, "lightBinning", series(&FrameSample::lightBinning), false);
+            WriteSeries(out, "final", series(&FrameSample::final), false);
+        }
+        WriteSeries(out, "frame", series(&FrameSample::frame), true);
+        out << "  }\n}\n";
+
+        std::cout << "[Headless] Wrote " << m_Samples.size() << " frames to " << m_Settings.reportPath << std::endl;
+        return static_cast<bool>(out);
+    }
+}
@@ -0,0 +1,73 @@
+//
+// Created by SIMEON on 10/17/2026.
+//
+
+#ifndef HEADLESSRENDERER_H
+#define HEADLESSRENDERER_H
+
+#include <memory>
+#include <vector>
+
+#include "Camera.h"
+#include "EngineSystems.h"
+#include "FrustumCulling.h"
+#include "LightClusterer.h"
+#include "Scene.h"
+
+class DeferredRenderer;
+class GPUDrivenRenderer;
+class Entity;
+
+namespace IDK
+{
+    // Editor-less frame loop for benchmarking. Renders a generated grid of
+    // cubes through DeferredRenderer (or GPUDrivenRenderer for renderer type
+    // "gpu") for a fixed number of frames, then writes per-pass CPU timings
+    // as JSON so runs can be compared across commits.
+    class HeadlessRenderer final
+    {
+    public:
+        HeadlessRenderer(const std::shared_ptr<Scene>& scene, const std::shared_ptr<Graphics::Camera>& camera,
+                         GLFWwindow* window, const EngineSystems::Config& config, JobSystem* jobs = nullptr);
+        ~HeadlessRenderer();
+
+        // Renders every frame and writes the report; false if it could not be written.
+        bool run();
+
+    private:
+        // Milliseconds. frame runs until glFinish returns, so it includes the GPU.
+        // Passes the benchmarked renderer does not have stay 0.
+        struct FrameSample {
+            double sceneUpdate = 0.0;
+            double geometry = 0.0;
+            double shadow = 0.0;
+            double lighting = 0.0;
+            double lightBinning = 0.0;
+            double final = 0.0;
+            double upload = 0.0;
+            double cull = 0.0;
+            double draw = 0.0;
+            double frame = 0.0;
+            size_t heapAllocations = 0;
+        };
+
+        void generateScene();
+        bool writeReport() const;
+
+        EngineSystems::Config::HeadlessConfig m_Settings;
+        int m_Width, m_Height;
+
+        std::shared_ptr<Scene> m_Scene;
+        std::shared_ptr<Graphics::Camera> m_Camera;
+        std::unique_ptr<DeferredRenderer> m_Deferred;     // exactly one of these is set
+        std::unique_ptr<GPUDrivenRenderer> m_GPUDriven;
+        std::vector<std::shared_ptr<Entity>> m_Generated;
+
+        std::vector<FrameSample> m_Samples;
+        Graphics::CullingStats m_LastCullingStats;
+        Graphics::LightClusterStats m_LastLightStats;
+        size_t m_LastShadowCasters = 0;
+    };
+}
+
+#endif //HEADLESSRENDERER_H
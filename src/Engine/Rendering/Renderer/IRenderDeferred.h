@@ -5,8 +5,17 @@
 #ifndef IRENDERDEFERRED_H
 #define IRENDERDEFERRED_H
 
+#include <cstdint>
 #include "glad/glad.h"
 
+namespace IDK::Graphics
+{
+    enum class GBufferLayout : uint8_t {
+        Standard,  // RGB16F position, RGB16F normal, RGBA8 albedo, depth renderbuffer
+        Compact    // RG16 octahedral normal, RGBA8 albedo, sampled depth; position rebuilt from depth
+    };
+}
+
 class IRenderDeferred {
 public:
     virtual ~IRenderDeferred() = default;
@@ -6,18 +6,27 @@
 
 #include <IconsFontAwesome6Brands.h>
 #include <imgui_internal.h>
+#include <charconv>
+#include <cstdio>
 #include <iostream>
 
 #include "DeferredRenderer.h"
 #include "Entity.h"
 #include "ForwardRenderer.h"
+#include "FrameArena.h"
+#include "FrustumCulling.h"
+#include "GLStateCache.h"
+#include "GPUDrivenRenderer.h"
+#include "HeapCounter.h"
 #include "imgui.h"
 #include "libData.h"
 #include "MainAllocator.h"
 #include "MeshRegistry.h"
+#include "Registry.h"
 #include "Scene.h"
 #include "SelectionManager.h"
 #include "ShaderManager.h"
+#include "TransformHierarchy.h"
 #include "backends/imgui_impl_glfw.h"
 #include "backends/imgui_impl_opengl3.h"
 
@@ -27,7 +36,7 @@ extern "C" LIBDATA_API void hierarchyeffects();
 namespace IDK
 {
     Renderer::Renderer(const std::shared_ptr<IDK::Scene>& scene, const std::shared_ptr<IDK::Graphics::Camera>
-        & camera, GLFWwindow* window, const std::string& rendererType)
+        & camera, GLFWwindow* window, const std::string& rendererType, JobSystem* jobs)
         :  showAssetManager(true),
         m_Window(window),
         scene(scene),
@@ -39,10 +48,14 @@ namespace IDK
 
         if (rendererType == "deferred") {
             isDeferred = true;
-            currentDeferred = std::make_shared<DeferredRenderer>(scene, camera, window, "Deferred");
+            currentDeferred = std::make_shared<DeferredRenderer>(scene, camera, window, "Deferred", jobs);
         } else if (rendererType == "forward") {
             isForward = true;
             currentForward = std::make_shared<ForwardRenderer>(scene, camera, window, "Forward");
+        } else if (rendererType == "gpu") {
+            // Same output contract as the forward renderer: one color texture.
+            isForward = true;
+            currentForward = std::make_shared<GPUDrivenRenderer>(scene, camera, window, "GPU");
         } else {
             throw std::invalid_argument("Invalid renderer type specified");
         }
@@ -75,6 +88,8 @@ namespace IDK
         if (!ImGui::GetCurrentContext())
             IDK_ASSERT(false, "CONTEXT NOT ACTIVE OR INITIALIZED!");
 
+        const size_t heapAllocationsBefore = HeapCounter::GetAllocationCount();
+
         glfwPollEvents();
 
         ImGui_ImplOpenGL3_NewFrame();
@@ -101,6 +116,15 @@ namespace IDK
         if (glfwGetKey(m_Window, GLFW_KEY_ESCAPE) == GLFW_PRESS) {
             glfwSetWindowShouldClose(m_Window, true);
         }
+
+        m_LastFrameHeapAllocations = HeapCounter::GetAllocationCount() - heapAllocationsBefore;
+        m_LastFrameUniformStats = Graphics::Shader::GetUniformStats();
+        Graphics::Shader::ResetUniformStats();
+        m_LastFrameGLStateStats = Graphics::GLStateCache::Instance().getStats();
+        Graphics::GLStateCache::Instance().resetStats();
+        m_LastFrameCullingStats = Graphics::FrustumCuller::GetStats();
+        Graphics::FrustumCuller::ResetStats();
+        FrameArena::Instance().endFrame();
     }
 
     void Renderer::renderImGuiLayout() {
@@ -154,12 +178,14 @@ namespace IDK
         ImGui::Begin("Console Debug");
 
         auto glfwAllocs = IDK::GLFWMemoryTracker::GetAllocations();
+        IDK::MemoryTracker::GetSnapshot(m_MemorySnapshot);
+        const IDK::MemoryTracker::Snapshot& memory = m_MemorySnapshot;
+        const float cpuBytes = static_cast<float>(memory.totalBytes);
 
 
         ImGui::TextColored(ImVec4(0.8f, 0.2f, 0.2f, 1.0f), "CPU Memory");
         ImGui::SameLine();
-        ImGui::Text("Total Allocated: %.2f KB",
-                   IDK::MemoryTracker::GetTotalUsage() / 1024.0f);
+        ImGui::Text("Total Allocated: %.2f KB", cpuBytes / 1024.0f);
 
         // GLFW/VRAM estimates
         ImGui::TextColored(ImVec4(0.2f, 0.8f, 0.2f, 1.0f), "Estimated VRAM");
@@ -169,38 +195,83 @@ namespace IDK
 
         // Combined total
         ImGui::Separator();
-        const float total = IDK::MemoryTracker::GetTotalUsage() +
+        const float total = cpuBytes +
                           IDK::GLFWMemoryTracker::GetTotalUsage();
 
         ImGui::TextColored(ImVec4(0.2f, 0.5f, 1.0f, 1.0f), "Combined Total");
         ImGui::SameLine();
         ImGui::Text("%.2f MB (CPU: %.2f KB + VRAM: %.2f MB)",
                    total / (1024.0f * 1024.0f),
-                   IDK::MemoryTracker::GetTotalUsage() / 1024.0f,
+                   cpuBytes / 1024.0f,
                    IDK::GLFWMemoryTracker::GetTotalUsage() / (1024.0f * 1024.0f));
 
+        const FrameArena::Stats arenaStats = FrameArena::Instance().getLastFrameStats();
+        ImGui::Text("Frame heap allocations: %zu", m_LastFrameHeapAllocations);
+        ImGui::Text("Uniform lookups avoided: %zu (%zu inactive uploads skipped)",
+                   m_LastFrameUniformStats.lookupsAvoided, m_LastFrameUniformStats.uploadsSkipped);
+        ImGui::Text("GL state changes: %zu issued, %zu skipped",
+                   m_LastFrameGLStateStats.issued, m_LastFrameGLStateStats.skipped);
+        ImGui::Text("Frustum culling: %zu visible, %zu culled",
+                   m_LastFrameCullingStats.visible, m_LastFrameCullingStats.culled);
+        ImGui::Text("Transforms: %zu, %zu world matrices updated",
+                   TransformHierarchy::Instance().size(), TransformHierarchy::Instance().getLastUpdateCount());
+        const DynamicAABBTree& spatialIndex = scene->getSpatialIndex();
+        ImGui::Text("Spatial index: %zu proxies, height %d, area ratio %.1f",
+                   spatialIndex.getProxyCount(), spatialIndex.getHeight(), spatialIndex.getAreaRatio());
+        ImGui::Text("Frame arena: %.1f / %.1f KB (%zu allocations, %zu B overflow)",
+                   arenaStats.bytesUsed / 1024.0f, arenaStats.capacity / 1024.0f,
+                   arenaStats.allocations, arenaStats.overflowBytes);
+
         ImGui::Separator();
 
         if (ImGui::CollapsingHeader("General Allocations", ImGuiTreeNodeFlags_DefaultOpen)) {
-            std::unordered_map<void*, IDK::MemoryTracker::AllocationInfo> memAllocs = IDK::MemoryTracker::GetAllocations();
+            ImGui::Text("Total Allocated: %.2f KB", cpuBytes / 1024.0f);
+            ImGui::Text("Allocation Count: %lld", static_cast<long long>(memory.liveCount));
 
-            ImGui::Text("Total Allocated: %.2f KB", IDK::MemoryTracker::GetTotalUsage() / 1024.0f);
-            ImGui::Text("Allocation Count: %zu", memAllocs.size());
-
-            if (ImGui::BeginTable("GeneralAllocations", 3, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg)) {
-                ImGui::TableSetupColumn("Type");
-                ImGui::TableSetupColumn("Address");
+            if (ImGui::BeginTable("GeneralAllocations", 4, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg)) {
+                ImGui::TableSetupColumn("Category");
+                ImGui::TableSetupColumn("Live");
                 ImGui::TableSetupColumn("Size");
+                ImGui::TableSetupColumn("Total Allocs");
                 ImGui::TableHeadersRow();
 
-                for (const auto& [ptr, info] : memAllocs) {
+                for (size_t i = 0; i < memory.categoryCount; ++i) {
+                    const auto& category = memory.categories[i];
                     ImGui::TableNextRow();
                     ImGui::TableNextColumn();
-                    ImGui::Text("%s", info.type.c_str());
+                    ImGui::Text("%s", category.name);
+                    ImGui::TableNextColumn();
+                    ImGui::Text("%lld", static_cast<long long>(category.liveCount));
                     ImGui::TableNextColumn();
-                    ImGui::Text("%p", ptr);
+                    ImGui::Text("%lld bytes", static_cast<long long>(category.bytes));
                     ImGui::TableNextColumn();
-                    ImGui::Text("%zu bytes", info.size);
+                    ImGui::Text("%llu", static_cast<unsigned long long>(category.totalAllocations));
+                }
+                ImGui::EndTable();
+            }
+
+            int samplingInterval = static_cast<int>(memory.samplingInterval);
+            if (ImGui::SliderInt("Sample every N allocs", &samplingInterval, 0, 64))
+                IDK::MemoryTracker::SetSamplingInterval(static_cast<uint32_t>(samplingInterval));
+
+            if (memory.callSiteCount > 0 && ImGui::BeginTable("SampledCallSites", 4, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg)) {
+                ImGui::TableSetupColumn("Call Site");
+                ImGui::TableSetupColumn("Category");
+                ImGui::TableSetupColumn("Samples");
+                ImGui::TableSetupColumn("Sampled Bytes");
+                ImGui::TableHeadersRow();
+
+                for (size_t i = 0; i < memory.callSiteCount; ++i) {
+                    const auto& site = memory.callSites[i];
+                    ImGui::TableNextRow();
+                    ImGui::TableNextColumn();
+                    ImGui::Text("%s:%u", site.file, site.line);
+                    ImGui::TableNextColumn();
+                    ImGui::Text("%s", site.category < memory.categoryCount ? memory.categories[site.category].name : "?");
+                    ImGui::TableNextColumn();
+                    ImGui::Text("%llu", static_cast<unsigned long long>(site.hits));
+                    ImGui::TableNextColumn();
+                    ImGui::Text("%llu", static_cast<unsigned long long>(site.bytes));
                 }
                 ImGui::EndTable();
             }
@@ -240,15 +311,75 @@ namespace IDK
             }
         }
 
+        if (ImGui::CollapsingHeader("Block Pools"))
+        {
+            if (ImGui::BeginTable("BlockPools", 3, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg))
+            {
+                ImGui::TableSetupColumn("Block (bytes)");
+                ImGui::TableSetupColumn("Reserved (KB)");
+                ImGui::TableSetupColumn("Blocks Out");
+                ImGui::TableHeadersRow();
+
+                for (const auto& stats : IDK::BlockPool::GetStats())
+                {
+                    if (stats.reservedBytes == 0) continue;
+
+                    ImGui::TableNextRow();
+                    ImGui::TableNextColumn();
+                    ImGui::Text("%zu", stats.blockSize);
+                    ImGui::TableNextColumn();
+                    ImGui::Text("%.1f", stats.reservedBytes / 1024.0f);
+                    ImGui::TableNextColumn();
+                    ImGui::Text("%zu", stats.blocksOutstanding);
+                }
+                ImGui::EndTable();
+            }
+        }
+
+        if (ImGui::CollapsingHeader("Shared Procedural Meshes", ImGuiTreeNodeFlags_DefaultOpen))
+        {
+            const auto sharedMeshes = IDK::MeshRegistry::Instance().getSharedMeshes();
+            if (ImGui::BeginTable("SharedMeshes", 5, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg))
+            {
+                ImGui::TableSetupColumn("Mesh");
+                ImGui::TableSetupColumn("Params (r / h / stacks / sectors)");
+                ImGui::TableSetupColumn("Entities");
+                ImGui::TableSetupColumn("GPU (bytes)");
+                ImGui::TableSetupColumn("Saved (bytes)");
+                ImGui::TableHeadersRow();
+
+                for (const auto& shared : sharedMeshes)
+                {
+                    const size_t gpuBytes = shared.mesh->getGpuMemoryUsage();
+                    const long users = shared.users;
+
+                    ImGui::TableNextRow();
+                    ImGui::TableNextColumn();
+                    ImGui::Text("%s", shared.mesh->getName().c_str());
+                    ImGui::TableNextColumn();
+                    ImGui::Text("%.2f / %.2f / %d / %d", shared.key.radius, shared.key.height, shared.key.stacks, shared.key.sectors);
+                    ImGui::TableNextColumn();
+                    ImGui::Text("%ld", users);
+                    ImGui::TableNextColumn();
+                    ImGui::Text("%zu", gpuBytes);
+                    ImGui::TableNextColumn();
+                    ImGui::Text("%zu", users > 1 ? gpuBytes * static_cast<size_t>(users - 1) : 0);
+                }
+                ImGui::EndTable();
+            }
+        }
+
         if (ImGui::CollapsingHeader("Mesh Allocations", ImGuiTreeNodeFlags_DefaultOpen))
         {
             auto meshes = IDK::MeshRegistry::Instance().getMeshes();
-            if (ImGui::BeginTable("MeshAllocations", 4, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg))
+            if (ImGui::BeginTable("MeshAllocations", 6, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg))
             {
                 ImGui::TableSetupColumn("Mesh Name");
                 ImGui::TableSetupColumn("Vertices (bytes)");
                 ImGui::TableSetupColumn("Indices (bytes)");
                 ImGui::TableSetupColumn("Total (bytes)");
+                ImGui::TableSetupColumn("GPU (bytes)");
+                ImGui::TableSetupColumn("ACMR");
                 ImGui::TableHeadersRow();
 
                 for (const auto& weakMesh : meshes)
@@ -268,6 +399,11 @@ namespace IDK
                         ImGui::Text("%zu", indexMemory);
                         ImGui::TableNextColumn();
                         ImGui::Text("%zu", totalMemory);
+                        ImGui::TableNextColumn();
+                        ImGui::Text("%zu", mesh->getGpuMemoryUsage());
+                        ImGui::TableNextColumn();
+                        const auto& report = mesh->getOptimizationReport();
+                        ImGui::Text("%.2f -> %.2f", report.before.acmr, report.after.acmr);
                     }
                 }
                 ImGui::EndTable();
@@ -396,8 +532,11 @@ namespace IDK
         const int & currentWidth = static_cast<int>(viewportSize.x);
         const int & currentHeight = static_cast<int>(viewportSize.y);
 
-        if (framebufferResized || currentDeferred->getFBOWidth() != currentWidth || currentDeferred->getFBOWidth() != currentHeight
-                        || currentForward->getFBOWidth() != currentWidth || currentForward->getFBOHeight() != currentHeight) {
+        const bool sizeChanged = isDeferred
+            ? currentDeferred->getFBOWidth() != currentWidth || currentDeferred->getFBOHeight() != currentHeight
+            : currentForward->getFBOWidth() != currentWidth || currentForward->getFBOHeight() != currentHeight;
+
+        if (framebufferResized || sizeChanged) {
             if (isDeferred) {
                 currentDeferred->updateViewportFramebuffer(currentWidth, currentHeight);
                 //currentDeferred->resizeFramebuffer(currentWidth, currentHeight);
@@ -408,6 +547,12 @@ namespace IDK
             framebufferResized = false;
                         }
 
+        // ImGui and the framebuffer rebuild above bind behind the cache's back.
+        Graphics::GLStateCache::Instance().invalidate();
+
+        TransformHierarchy::Instance().update();
+        scene->updateSpatialIndex();
+
         if (isDeferred) {
             currentDeferred->render();
         }else if (isForward) {
@@ -416,10 +561,29 @@ namespace IDK
         GLuint textureID = isDeferred ? currentDeferred->getTexture() : currentForward->getTexture();
         ImGui::Image(reinterpret_cast<void*>(static_cast<intptr_t>(textureID)), ImVec2(currentWidth, currentHeight));
 
+        if (ImGui::IsItemClicked(ImGuiMouseButton_Left) && currentWidth > 0 && currentHeight > 0) {
+            const ImVec2 imageMin = ImGui::GetItemRectMin();
+            const ImVec2 mouse = ImGui::GetMousePos();
+            const glm::vec2 ndc(2.0f * (mouse.x - imageMin.x) / currentWidth - 1.0f,
+                                1.0f - 2.0f * (mouse.y - imageMin.y) / currentHeight);
+
+            // A few pixels of slack around the cursor for thin colliders.
+            constexpr float pickRadius = 6.0f;
+            const glm::vec2 radius(2.0f * pickRadius / currentWidth, 2.0f * pickRadius / currentHeight);
+
+            if (const auto hit = scene->getPicking().pickScreenArea(ndc, radius, m_Camera)) {
+                HierarchyManager::getInstance().selectEntity(Registry::instance().getEntity(hit->entity));
+            } else {
+                HierarchyManager::getInstance().clearSelection();
+            }
+        }
+
         ImDrawList* drawList = ImGui::GetWindowDrawList();
         const ImVec2 imagePos = ImGui::GetItemRectMin();
         const auto textPos = ImVec2(imagePos.x + 150, imagePos.y + 25);
-        drawList->AddText(textPos, IM_COL32(255, 255, 255, 255), ("FPS: " + std::to_string(fpsCounter.getFPS())).c_str());
+        char fpsText[32];
+        std::snprintf(fpsText, sizeof(fpsText), "FPS: %f", fpsCounter.getFPS());
+        drawList->AddText(textPos, IM_COL32(255, 255, 255, 255), fpsText);
 
         /*
         float smallSize = 450.0f;
@@ -538,9 +702,12 @@ namespace IDK
     void Renderer::renderEntityRow(const std::shared_ptr<Entity>& entity, size_t index) const {
         if (!entity) return;
 
-        std::string entityName = entity->getName();
+        const std::string& name = entity->getNameRef();
+        FrameString entityName(name.data(), name.size(), FrameAllocator<char>());
         if (entityName.empty()) {
-            entityName = "Entity " + std::to_string(index);
+            char digits[24];
+            const auto [end, ec] = std::to_chars(digits, digits + sizeof(digits), index);
+            entityName.append("Entity ").append(digits, end);
         }
 
         /*
@@ -16,21 +16,25 @@
 #include "InspectorManager.h"
 #include "ProjectExplorer.h"
 #include "FPSCounter.h"
+#include "GLStateCache.h"
+#include "FrustumCulling.h"
 #include "HierarchyManager.h"
 #include "ImGuizmo.h"
 #include "IRenderDeferred.h"
 #include "IRenderForward.h"
+#include "MainAllocator.h"
 
 namespace IDK
 {
     class Renderer;
     class InspectorManager;
+    class JobSystem;
 
     class Renderer final
     {
     public:
         explicit Renderer(const std::shared_ptr<IDK::Scene>& scene, const std::shared_ptr<IDK::Graphics::Camera>& camera
-            , GLFWwindow* window, const std::string& rendererType);
+            , GLFWwindow* window, const std::string& rendererType, JobSystem* jobs = nullptr);
         virtual ~Renderer();
 
         void render();
@@ -104,6 +108,11 @@ namespace IDK
         float lastX = 400, lastY = 300;
 
         FPSCounter fpsCounter;
+        size_t m_LastFrameHeapAllocations = 0;
+        Graphics::UniformStats m_LastFrameUniformStats;
+        Graphics::GLStateCache::Stats m_LastFrameGLStateStats;
+        Graphics::CullingStats m_LastFrameCullingStats;
+        mutable IDK::MemoryTracker::Snapshot m_MemorySnapshot;
         // HierarchyManager hierarchyManager;
         IDK::Editor::InspectorManager inspectorManager;
         ProjectExplorer projectExplorer;
@@ -6,7 +6,9 @@
 #include <sstream>
 #include <iostream>
 #include "Shader.h"
+#include "GLStateCache.h"
 
+#include <algorithm>
 #include <filesystem>
 #include <chrono>
 #include <ctime>
@@ -38,6 +40,16 @@ namespace IDK::Graphics
 
         currentPaths = {vertexPath, fragmentPath};
     }
+
+    Shader::Shader(const char* computePath, ComputeTag) : isCombined(false), isCompute(true) {
+        if (!std::filesystem::exists(computePath)) {
+            throw std::runtime_error("Compute shader file does not exist: " + std::string(computePath));
+        }
+
+        compileAndLinkCompute(readFile(computePath));
+
+        currentPaths = {computePath, computePath};
+    }
     Shader::~Shader() {
         if(shaderProgram != 0) {
             glDeleteProgram(shaderProgram);
@@ -95,7 +107,9 @@ namespace IDK::Graphics
 
 
     void Shader::reload() {
-        if(isCombined) {
+        if(isCompute) {
+            compileAndLinkCompute(readFile(currentPaths.vertex));
+        } else if(isCombined) {
             loadCombinedShader(currentPaths.vertex.c_str());
         } else {
             loadSeparateShaders(currentPaths.vertex.c_str(), currentPaths.fragment.c_str());
@@ -111,36 +125,114 @@ namespace IDK::Graphics
         } else if(path.ends_with(".frag")) {
             currentPaths.fragment = path;
             reload();
+        } else if(path.ends_with(".comp")) {
+            currentPaths = {path, path};
+            reload();
         }
     }
 
     void Shader::compileAndLink(const std::string& vertexCode, const std::string& fragmentCode) {
         GLuint vertexShader = compileShader(vertexCode, GL_VERTEX_SHADER);
         GLuint fragmentShader = compileShader(fragmentCode, GL_FRAGMENT_SHADER);
+        linkProgram({vertexShader, fragmentShader});
+    }
+
+    void Shader::compileAndLinkCompute(const std::string& computeCode) {
+        linkProgram({compileShader(computeCode, GL_COMPUTE_SHADER)});
+    }
 
-        shaderProgram = glCreateProgram();
-        glAttachShader(shaderProgram, vertexShader);
-        glAttachShader(shaderProgram, fragmentShader);
-        glLinkProgram(shaderProgram);
+    // Takes ownership of the compiled stages.
+    void Shader::linkProgram(std::initializer_list<GLuint> stages) {
+        // Link into a new program so a failed hot reload keeps the old one.
+        const GLuint program = glCreateProgram();
+        for (const GLuint stage : stages)
+            glAttachShader(program, stage);
+        glLinkProgram(program);
+
+        for (const GLuint stage : stages)
+            glDeleteShader(stage);
 
         GLint success;
-        glGetProgramiv(shaderProgram, GL_LINK_STATUS, &success);
+        glGetProgramiv(program, GL_LINK_STATUS, &success);
 
         if (!success) {
             GLchar infoLog[512];
-            glGetProgramInfoLog(shaderProgram, 512, nullptr, infoLog);
+            glGetProgramInfoLog(program, 512, nullptr, infoLog);
 
             std::cerr << "ERROR::PROGRAM_LINKING_ERROR\n" << infoLog << "\n";
 
-            glDeleteProgram(shaderProgram);
-            shaderProgram = 0;
+            glDeleteProgram(program);
             throw std::runtime_error("Shader program linking failed.");
         } else {
             // std::cout << "Successfully linked shader program.\n";
         }
 
-        glDeleteShader(vertexShader);
-        glDeleteShader(fragmentShader);
+        if (shaderProgram != 0)
+            glDeleteProgram(shaderProgram);
+        shaderProgram = program;
+
+        reflectUniforms();
+    }
+
+    void Shader::reflectUniforms() {
+        uniforms.clear();
+
+        GLint count = 0, maxNameLength = 0;
+        glGetProgramiv(shaderProgram, GL_ACTIVE_UNIFORMS, &count);
+        glGetProgramiv(shaderProgram, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxNameLength);
+
+        std::string name(static_cast<size_t>(maxNameLength) + 16, '\0');
+        for (GLint i = 0; i < count; ++i) {
+            GLsizei length = 0;
+            GLint size = 0;
+            GLenum type = 0;
+            glGetActiveUniform(shaderProgram, static_cast<GLuint>(i), maxNameLength, &length, &size, &type, name.data());
+
+            std::string_view reported(name.data(), length);
+            const GLint location = glGetUniformLocation(shaderProgram, name.c_str());
+            if (location == -1) continue; // uniform block member
+
+            uniforms.push_back({HashUniformName(reported), location});
+
+            // Arrays report "name[0]": also register "name" and every element.
+            if (reported.ends_with("[0]")) {
+                const std::string base(reported.substr(0, reported.size() - 3));
+                uniforms.push_back({HashUniformName(base), location});
+
+                for (GLint element = 1; element < size; ++element) {
+                    const std::string elementName = base + "[" + std::to_string(element) + "]";
+                    const GLint elementLocation = glGetUniformLocation(shaderProgram, elementName.c_str());
+                    if (elementLocation != -1)
+                        uniforms.push_back({HashUniformName(elementName), elementLocation});
+                }
+            }
+        }
+
+        std::sort(uniforms.begin(), uniforms.end(), [](const UniformInfo& a, const UniformInfo& b) { return a.hash < b.hash; });
+        for (size_t i = 1; i < uniforms.size(); ++i) {
+            if (uniforms[i].hash == uniforms[i - 1].hash && uniforms[i].location != uniforms[i - 1].location)
+                std::cerr << "[Shader] Uniform name hash collision in " << currentPaths.vertex << "\n";
+        }
+
+        generation = ++s_nextGeneration;
+    }
+
+    GLint Shader::findUniform(uint32_t hash) const {
+        ++s_uniformStats.lookupsAvoided;
+
+        const auto it = std::lower_bound(uniforms.begin(), uniforms.end(), hash,
+                                         [](const UniformInfo& info, uint32_t value) { return info.hash < value; });
+        return it != uniforms.end() && it->hash == hash ? it->location : -1;
+    }
+
+    GLint Shader::resolve(const UniformHandle& uniform) const {
+        if (uniform.generation != generation) {
+            uniform.location = findUniform(uniform.hash);
+            uniform.generation = generation;
+        } else {
+            ++s_uniformStats.lookupsAvoided;
+        }
+        return uniform.location;
     }
 
     GLuint Shader::compileShader(const std::string& source, GLenum type) {
@@ -162,7 +254,7 @@ namespace IDK::Graphics
 
             // Log detailed error message
             std::cerr << "ERROR::SHADER_COMPILATION_ERROR of type: "
-                      << (type == GL_VERTEX_SHADER ? "VERTEX" : "FRAGMENT")
+                      << (type == GL_VERTEX_SHADER ? "VERTEX" : type == GL_COMPUTE_SHADER ? "COMPUTE" : "FRAGMENT")
                       << "\n" << infoLog << "\n";
 
             glDeleteShader(shader);
@@ -263,18 +355,42 @@ namespace IDK::Graphics
 
 
     void Shader::Use() const {
-        glUseProgram(shaderProgram);
+        GLStateCache::Instance().useProgram(shaderProgram);
+    }
+
+    void Shader::setMat4(std::string_view name, const glm::mat4& matrix) const {
+        const GLint location = findUniform(HashUniformName(name));
+        if (location == -1) { ++s_uniformStats.uploadsSkipped; return; }
+        glUniformMatrix4fv(location, 1, GL_FALSE, glm::value_ptr(matrix));
+    }
+
+    void Shader::setInt(std::string_view name, int value) const {
+        const GLint location = findUniform(HashUniformName(name));
+        if (location == -1) { ++s_uniformStats.uploadsSkipped; return; }
+        glUniform1i(location, value);
+    }
+
+    void Shader::setVec3(std::string_view name, const glm::vec3& value) const {
+        const GLint location = findUniform(HashUniformName(name));
+        if (location == -1) { ++s_uniformStats.uploadsSkipped; return; }
+        glUniform3fv(location, 1, glm::value_ptr(value));
     }
 
-    void Shader::setMat4(const std::string& name, const glm::mat4& matrix) const {
-        glUniformMatrix4fv(glGetUniformLocation(shaderProgram, name.c_str()), 1, GL_FALSE, glm::value_ptr(matrix));
+    void Shader::setMat4(const UniformHandle& uniform, const glm::mat4& matrix) const {
+        const GLint location = resolve(uniform);
+        if (location == -1) { ++s_uniformStats.uploadsSkipped; return; }
+        glUniformMatrix4fv(location, 1, GL_FALSE, glm::value_ptr(matrix));
     }
 
-    void Shader::setInt(const std::string& name, int value) const {
-        glUniform1i(glGetUniformLocation(shaderProgram, name.c_str()), value);
+    void Shader::setInt(const UniformHandle& uniform, int value) const {
+        const GLint location = resolve(uniform);
+        if (location == -1) { ++s_uniformStats.uploadsSkipped; return; }
+        glUniform1i(location, value);
     }
 
-    void Shader::setVec3(const std::string& name, const glm::vec3& value) const {
-        glUniform3fv(glGetUniformLocation(shaderProgram, name.c_str()), 1, glm::value_ptr(value));
+    void Shader::setVec3(const UniformHandle& uniform, const glm::vec3& value) const {
+        const GLint location = resolve(uniform);
+        if (location == -1) { ++s_uniformStats.uploadsSkipped; return; }
+        glUniform3fv(location, 1, glm::value_ptr(value));
     }
 }
\ No newline at end of file
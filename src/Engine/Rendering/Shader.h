@@ -9,12 +9,47 @@
 #include "glm.hpp"
 #include "gtc/type_ptr.hpp"
 
+#include <cstdint>
+#include <initializer_list>
 #include <iostream>
 #include <memory>
-#include <unordered_map>
-#include <mutex>
+#include <string_view>
+#include <vector>
 namespace IDK::Graphics
 {
+    // FNV-1a; uniform names are hashed once, at link time and when a handle is made.
+    constexpr uint32_t HashUniformName(std::string_view name) {
+        uint32_t hash = 2166136261u;
+        for (const char c : name) {
+            hash ^= static_cast<uint8_t>(c);
+            hash *= 16777619u;
+        }
+        return hash;
+    }
+
+    // A uniform name resolved against a shader on first use and cached. Every
+    // link gets a new generation, so handles re-resolve by themselves after a
+    // hot reload or when used with a different shader.
+    class UniformHandle {
+    public:
+        constexpr UniformHandle() = default;
+        constexpr explicit UniformHandle(std::string_view name) : hash(HashUniformName(name)) {}
+
+    private:
+        friend class Shader;
+
+        uint32_t hash = 0;
+        mutable GLint location = -1;
+        mutable uint32_t generation = 0;
+    };
+
+    // glGetUniformLocation calls replaced by table lookups, and uploads
+    // dropped because the uniform is not active.
+    struct UniformStats {
+        size_t lookupsAvoided = 0;
+        size_t uploadsSkipped = 0;
+    };
+
     class Shader {
     public:
         struct Paths {
@@ -22,8 +57,13 @@ namespace IDK::Graphics
             std::string fragment;
         };
 
+        // Selects the compute-only constructor.
+        struct ComputeTag {};
+        static constexpr ComputeTag Compute{};
+
         Shader(const char* path, bool isCombined = true);
         Shader(const char* vertexPath, const char* fragmentPath);
+        Shader(const char* computePath, ComputeTag);
         ~Shader();
 
         GLuint getProgramID() const { return shaderProgram; }
@@ -33,9 +73,19 @@ namespace IDK::Graphics
         void reloadFromPath(const std::string& path);
 
         // Uniform setters
-        void setMat4(const std::string& name, const glm::mat4& matrix) const;
-        void setInt(const std::string& name, int value) const;
-        void setVec3(const std::string& name, const glm::vec3& value) const;
+        void setMat4(std::string_view name, const glm::mat4& matrix) const;
+        void setInt(std::string_view name, int value) const;
+        void setVec3(std::string_view name, const glm::vec3& value) const;
+
+        void setMat4(const UniformHandle& uniform, const glm::mat4& matrix) const;
+        void setInt(const UniformHandle& uniform, int value) const;
+        void setVec3(const UniformHandle& uniform, const glm::vec3& value) const;
+
+        bool hasUniform(const UniformHandle& uniform) const { return resolve(uniform) != -1; }
+
+        // Reset once per frame.
+        static UniformStats GetUniformStats() { return s_uniformStats; }
+        static void ResetUniformStats() { s_uniformStats = {}; }
 
         // State management
         bool isValid() const { return shaderProgram != 0; }
@@ -45,11 +95,26 @@ namespace IDK::Graphics
     private:
         GLuint shaderProgram = 0;
         bool isCombined;
+        bool isCompute = false;  // both paths name the compute source
         Paths currentPaths;
-        mutable std::unordered_map<std::string, GLint> uniformCache;
-        mutable std::mutex uniformMutex;
+
+        struct UniformInfo {
+            uint32_t hash;
+            GLint location;
+        };
+        std::vector<UniformInfo> uniforms; // sorted by hash
+        uint32_t generation = 0;
+
+        static inline uint32_t s_nextGeneration = 0;
+        static inline UniformStats s_uniformStats;
+
+        void reflectUniforms();
+        GLint findUniform(uint32_t hash) const;
+        GLint resolve(const UniformHandle& uniform) const;
 
         void compileAndLink(const std::string& vertexCode, const std::string& fragmentCode);
+        void compileAndLinkCompute(const std::string& computeCode);
+        void linkProgram(std::initializer_list<GLuint> stages);
         GLuint compileShader(const std::string& source, GLenum type);
         std::pair<std::string, std::string> parseCombinedShader(const std::string& path);
         std::string readFile(const std::string& path);
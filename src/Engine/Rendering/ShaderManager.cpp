@@ -19,6 +19,11 @@ ShaderManager::ShaderManager() {
                SOURCE_DIR "/src/shaders/basic.frag"
            );
 
+    instancedShaderProgram = std::make_shared<IDK::Graphics::Shader>(
+               SOURCE_DIR "/src/shaders/basicInstanced.vert",
+               SOURCE_DIR "/src/shaders/basic.frag"
+           );
+
     lightShader = std::make_shared<IDK::Graphics::Shader>(
        SOURCE_DIR "/src/shaders/lightShader.vert",
        SOURCE_DIR "/src/shaders/lightShader.frag"
@@ -34,7 +39,22 @@ ShaderManager::ShaderManager() {
     SOURCE_DIR "/src/shaders/sky.frag"
     );
 
-    std::cout << "ShaderManager initialized with 4 shaders." << std::endl;
+    shadowDepthShader = std::make_shared<IDK::Graphics::Shader>(
+        SOURCE_DIR "/src/shaders/shadowDepth.vert",
+        SOURCE_DIR "/src/shaders/shadowDepth.frag"
+    );
+
+    gpuDrivenShader = std::make_shared<IDK::Graphics::Shader>(
+        SOURCE_DIR "/src/shaders/gpuDriven.vert",
+        SOURCE_DIR "/src/shaders/gpuDriven.frag"
+    );
+
+    gpuCullShader = std::make_shared<IDK::Graphics::Shader>(
+        SOURCE_DIR "/src/shaders/gpuCull.comp",
+        IDK::Graphics::Shader::Compute
+    );
+
+    std::cout << "ShaderManager initialized with 8 shaders." << std::endl;
 
     std::filesystem::path resourceShadersPath = SOURCE_DIR "/src/shaders/";
     std::filesystem::path shadersPath = SOURCE_DIR "/ROOT/shaders/";
@@ -34,18 +34,26 @@ public:
     ShaderManager& operator=(const ShaderManager&) = delete;
 
     std::shared_ptr<IDK::Graphics::Shader> getShaderProgram() const { return shaderProgram; }
+    std::shared_ptr<IDK::Graphics::Shader> getInstancedShaderProgram() const { return instancedShaderProgram; }
     std::shared_ptr<IDK::Graphics::Shader> getLightShader() const { return lightShader; }
     std::shared_ptr<IDK::Graphics::Shader> getFinalPassShader() const { return finalPassShader; }
     std::shared_ptr<IDK::Graphics::Shader> getSkyShader() const { return skyShader; }
+    std::shared_ptr<IDK::Graphics::Shader> getShadowDepthShader() const { return shadowDepthShader; }
+    std::shared_ptr<IDK::Graphics::Shader> getGPUDrivenShader() const { return gpuDrivenShader; }
+    std::shared_ptr<IDK::Graphics::Shader> getGPUCullShader() const { return gpuCullShader; }
 
 private:
     ShaderManager();
     ~ShaderManager();
 
     std::shared_ptr<IDK::Graphics::Shader> shaderProgram;
+    std::shared_ptr<IDK::Graphics::Shader> instancedShaderProgram;
     std::shared_ptr<IDK::Graphics::Shader> lightShader;
     std::shared_ptr<IDK::Graphics::Shader> finalPassShader;
     std::shared_ptr<IDK::Graphics::Shader> skyShader;
+    std::shared_ptr<IDK::Graphics::Shader> shadowDepthShader;
+    std::shared_ptr<IDK::Graphics::Shader> gpuDrivenShader;
+    std::shared_ptr<IDK::Graphics::Shader> gpuCullShader;
 
 
     std::unordered_map<std::string, std::shared_ptr<IDK::Graphics::Shader>> shaders;
@@ -0,0 +1,124 @@
+//
+// Created by SIMEON on 10/17/2026.
+//
+
+#ifndef VERTEXCOMPRESSION_H
+#define VERTEXCOMPRESSION_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include "glm.hpp"
+#include "gtc/packing.hpp"
+
+namespace IDK::Graphics
+{
+    enum class VertexFormat : uint8_t {
+        Standard,       // float3 position, float3 normal (24 bytes)
+        CompactHalf,    // half4 position, octahedral snorm16x2 normal (12 bytes)
+        CompactSnorm16  // snorm16x4 position, octahedral snorm16x2 normal (12 bytes)
+    };
+
+    // Positions are stored relative to the mesh bounds, in [-1, 1]:
+    // decoded = offset + scale * stored.
+    struct PositionQuantization {
+        glm::vec3 offset{0.0f};
+        glm::vec3 scale{1.0f};
+    };
+
+    struct CompactVertex {
+        uint16_t position[4]; // xyz + padding; half or snorm16 bits depending on the format
+        uint16_t normal[2];   // octahedral, snorm16
+    };
+    static_assert(sizeof(CompactVertex) == 12, "CompactVertex must stay tightly packed");
+
+    namespace VertexCompression
+    {
+        inline bool IsCompact(VertexFormat format) {
+            return format != VertexFormat::Standard;
+        }
+
+        inline size_t VertexStride(VertexFormat format) {
+            return IsCompact(format) ? sizeof(CompactVertex) : sizeof(glm::vec3) * 2;
+        }
+
+        // 16-bit indices are enough while every vertex is addressable with them.
+        inline bool FitsUInt16Indices(size_t vertexCount) {
+            return vertexCount <= 0x10000;
+        }
+
+        // Zero, denormal and NaN normals have no direction; they get (0, 0),
+        // which decodes to +Z, rather than a NaN that packSnorm1x16 cannot take.
+        inline glm::vec2 OctEncode(const glm::vec3& n) {
+            const float l1 = std::abs(n.x) + std::abs(n.y) + std::abs(n.z);
+            if (!(l1 >= std::numeric_limits<float>::min()))
+                return {0.0f, 0.0f};
+
+            const glm::vec3 v = n / l1;
+            if (v.z >= 0.0f)
+                return {v.x, v.y};
+
+            return {
+                (1.0f - std::abs(v.y)) * (v.x >= 0.0f ? 1.0f : -1.0f),
+                (1.0f - std::abs(v.x)) * (v.y >= 0.0f ? 1.0f : -1.0f)
+            };
+        }
+
+        // Mirrors octDecode() in basic.vert.
+        inline glm::vec3 OctDecode(const glm::vec2& e) {
+            glm::vec3 n(e.x, e.y, 1.0f - std::abs(e.x) - std::abs(e.y));
+            const float t = std::max(-n.z, 0.0f);
+            n.x += n.x >= 0.0f ? -t : t;
+            n.y += n.y >= 0.0f ? -t : t;
+            return glm::normalize(n);
+        }
+
+        inline PositionQuantization ComputeQuantization(const glm::vec3& boundsMin, const glm::vec3& boundsMax) {
+            PositionQuantization quantization;
+            quantization.offset = (boundsMin + boundsMax) * 0.5f;
+            quantization.scale = (boundsMax - boundsMin) * 0.5f;
+
+            // Flat axes still need a non-zero scale to divide by.
+            for (int axis = 0; axis < 3; ++axis) {
+                if (quantization.scale[axis] <= 0.0f)
+                    quantization.scale[axis] = 1.0f;
+            }
+            return quantization;
+        }
+
+        inline CompactVertex Encode(const glm::vec3& position, const glm::vec3& normal,
+                                    const PositionQuantization& quantization, VertexFormat format) {
+            CompactVertex out{};
+
+            const glm::vec3 local = glm::clamp((position - quantization.offset) / quantization.scale, -1.0f, 1.0f);
+            for (int axis = 0; axis < 3; ++axis) {
+                out.position[axis] = format == VertexFormat::CompactHalf
+                    ? glm::packHalf1x16(local[axis])
+                    : glm::packSnorm1x16(local[axis]);
+            }
+
+            const glm::vec2 oct = OctEncode(normal);
+            out.normal[0] = glm::packSnorm1x16(oct.x);
+            out.normal[1] = glm::packSnorm1x16(oct.y);
+            return out;
+        }
+
+        inline glm::vec3 DecodePosition(const CompactVertex& vertex, const PositionQuantization& quantization, VertexFormat format) {
+            glm::vec3 local;
+            for (int axis = 0; axis < 3; ++axis) {
+                local[axis] = format == VertexFormat::CompactHalf
+                    ? glm::unpackHalf1x16(vertex.position[axis])
+                    : glm::unpackSnorm1x16(vertex.position[axis]);
+            }
+            return quantization.offset + quantization.scale * local;
+        }
+
+        inline glm::vec3 DecodeNormal(const CompactVertex& vertex) {
+            return OctDecode({glm::unpackSnorm1x16(vertex.normal[0]), glm::unpackSnorm1x16(vertex.normal[1])});
+        }
+    }
+}
+
+#endif //VERTEXCOMPRESSION_H
@@ -0,0 +1,307 @@
+//
+// Created by SIMEON on 10/17/2026.
+//
+
+#include "DynamicAABBTree.h"
+
+#include <cmath>
+#include <functional>
+#include <utility>
+
+namespace IDK
+{
+    int32_t DynamicAABBTree::createProxy(const AABB& bounds, uint32_t userData) {
+        const int32_t proxy = allocateNode();
+        Node& node = m_nodes[proxy];
+        node.bounds = {bounds.min - m_margin, bounds.max + m_margin};
+        node.userData = userData;
+        node.height = 0;
+
+        insertLeaf(proxy);
+        ++m_proxyCount;
+        return proxy;
+    }
+
+    void DynamicAABBTree::destroyProxy(int32_t proxy) {
+        removeLeaf(proxy);
+        freeNode(proxy);
+        --m_proxyCount;
+    }
+
+    bool DynamicAABBTree::moveProxy(int32_t proxy, const AABB& bounds) {
+        const AABB fat{bounds.min - m_margin, bounds.max + m_margin};
+        const AABB& current = m_nodes[proxy].bounds;
+
+        // Still inside its fat box, and that box has not gone stale from shrinking.
+        if (Contains(current, bounds) && Area(current) <= 4.0f * Area(fat))
+            return false;
+
+        removeLeaf(proxy);
+        m_nodes[proxy].bounds = fat;
+        insertLeaf(proxy);
+        return true;
+    }
+
+    float DynamicAABBTree::getAreaRatio() const {
+        if (m_root == NullNode) return 0.0f;
+
+        const float rootArea = Area(m_nodes[m_root].bounds);
+        if (rootArea <= 0.0f) return 0.0f;
+
+        float total = 0.0f;
+        for (const Node& node : m_nodes) {
+            if (node.height > 0)
+                total += Area(node.bounds);
+        }
+        return total / rootArea;
+    }
+
+    bool DynamicAABBTree::validate() const {
+        if (m_root == NullNode) return m_proxyCount == 0;
+        if (m_nodes[m_root].parent != NullNode) return false;
+
+        size_t leaves = 0;
+        const std::function<bool(int32_t)> check = [&](int32_t index) {
+            const Node& node = m_nodes[index];
+            if (node.isLeaf()) {
+                ++leaves;
+                return node.height == 0 && node.child2 == NullNode;
+            }
+
+            const Node& child1 = m_nodes[node.child1];
+            const Node& child2 = m_nodes[node.child2];
+            if (child1.parent != index || child2.parent != index) return false;
+            if (node.height != 1 + std::max(child1.height, child2.height)) return false;
+            if (!Contains(node.bounds, child1.bounds) || !Contains(node.bounds, child2.bounds)) return false;
+            return check(node.child1) && check(node.child2);
+        };
+        return check(m_root) && leaves == m_proxyCount;
+    }
+
+    void DynamicAABBTree::queryNearest(const glm::vec3& point, size_t k, std::vector<uint32_t>& result) const {
+        result.clear();
+        if (m_root == NullNode || k == 0) return;
+
+        // Best-first: the heap holds nodes by their lower-bound distance, so
+        // leaves come off it in exact order.
+        using Entry = std::pair<float, int32_t>;
+        std::priority_queue<Entry, std::vector<Entry>, std::greater<>> open;
+        open.emplace(DistanceSquared(m_nodes[m_root].bounds, point), m_root);
+
+        while (!open.empty() && result.size() < k) {
+            const int32_t index = open.top().second;
+            open.pop();
+
+            const Node& node = m_nodes[index];
+            if (node.isLeaf()) {
+                result.push_back(node.userData);
+            } else {
+                open.emplace(DistanceSquared(m_nodes[node.child1].bounds, point), node.child1);
+                open.emplace(DistanceSquared(m_nodes[node.child2].bounds, point), node.child2);
+            }
+        }
+    }
+
+    DynamicAABBTree::Containment DynamicAABBTree::Classify(const Graphics::Frustum& frustum, const AABB& box) {
+        const glm::vec3 center = box.center();
+        const glm::vec3 extents = box.extents();
+
+        bool intersecting = false;
+        for (const glm::vec4& plane : frustum.planes) {
+            const glm::vec3 normal(plane);
+            const float distance = glm::dot(normal, center) + plane.w;
+            const float radius = glm::dot(glm::abs(normal), extents);
+            if (distance + radius < 0.0f) return Containment::Outside;
+            if (distance - radius < 0.0f) intersecting = true;
+        }
+        return intersecting ? Containment::Intersecting : Containment::Inside;
+    }
+
+    int32_t DynamicAABBTree::allocateNode() {
+        if (m_freeList == NullNode) {
+            m_nodes.emplace_back();
+            return static_cast<int32_t>(m_nodes.size() - 1);
+        }
+
+        const int32_t index = m_freeList;
+        m_freeList = m_nodes[index].parent;
+        m_nodes[index] = Node{};
+        return index;
+    }
+
+    void DynamicAABBTree::freeNode(int32_t index) {
+        Node& node = m_nodes[index];
+        node.parent = m_freeList;
+        node.child1 = node.child2 = NullNode;
+        node.height = -1;
+        m_freeList = index;
+    }
+
+    // Greedy descent with a lower bound on the cost of going deeper
+    // (Catto, "Dynamic Bounding Volume Hierarchies", GDC 2019).
+    int32_t DynamicAABBTree::findBestSibling(const AABB& bounds) const {
+        const float boundsArea = Area(bounds);
+
+        int32_t index = m_root;
+        float area = Area(m_nodes[index].bounds);
+        float directCost = Area(Union(m_nodes[index].bounds, bounds));
+        float inheritedCost = 0.0f;
+
+        int32_t bestSibling = index;
+        float bestCost = directCost;
+
+        while (!m_nodes[index].isLeaf()) {
+            const Node& node = m_nodes[index];
+
+            // Cost of making this node the sibling.
+            const float cost = directCost + inheritedCost;
+            if (cost < bestCost) {
+                bestSibling = index;
+                bestCost = cost;
+            }
+
+            // Going deeper grows this node by the same amount either way.
+            inheritedCost += directCost - area;
+
+            float childArea[2], childDirect[2], lowerBound[2];
+            const int32_t children[2] = {node.child1, node.child2};
+            for (int c = 0; c < 2; ++c) {
+                const Node& child = m_nodes[children[c]];
+                childArea[c] = Area(child.bounds);
+                childDirect[c] = Area(Union(child.bounds, bounds));
+
+                if (child.isLeaf()) {
+                    const float childCost = childDirect[c] + inheritedCost;
+                    if (childCost < bestCost) {
+                        bestSibling = children[c];
+                        bestCost = childCost;
+                    }
+                    lowerBound[c] = std::numeric_limits<float>::max();
+                } else {
+                    lowerBound[c] = inheritedCost + childDirect[c] + std::min(boundsArea - childArea[c], 0.0f);
+                }
+            }
+
+            if (bestCost <= lowerBound[0] && bestCost <= lowerBound[1])
+                break;
+
+            const int c = lowerBound[0] <= lowerBound[1] ? 0 : 1;
+            index = children[c];
+            area = childArea[c];
+            directCost = childDirect[c];
+        }
+
+        return bestSibling;
+    }
+
+    void DynamicAABBTree::insertLeaf(int32_t leaf) {
+        if (m_root == NullNode) {
+            m_root = leaf;
+            m_nodes[leaf].parent = NullNode;
+            return;
+        }
+
+        const int32_t sibling = findBestSibling(m_nodes[leaf].bounds);
+        const int32_t newParent = allocateNode();
+
+        Node& parent = m_nodes[newParent];
+        const int32_t oldParent = m_nodes[sibling].parent;
+        parent.parent = oldParent;
+        parent.child1 = sibling;
+        parent.child2 = leaf;
+
+        if (oldParent == NullNode) {
+            m_root = newParent;
+        } else {
+            Node& grand = m_nodes[oldParent];
+            (grand.child1 == sibling ? grand.child1 : grand.child2) = newParent;
+        }
+
+        m_nodes[sibling].parent = newParent;
+        m_nodes[leaf].parent = newParent;
+        refitAncestors(newParent);
+    }
+
+    void DynamicAABBTree::removeLeaf(int32_t leaf) {
+        if (leaf == m_root) {
+            m_root = NullNode;
+            return;
+        }
+
+        const int32_t parent = m_nodes[leaf].parent;
+        const int32_t grand = m_nodes[parent].parent;
+        const int32_t sibling = m_nodes[parent].child1 == leaf ? m_nodes[parent].child2 : m_nodes[parent].child1;
+
+        m_nodes[sibling].parent = grand;
+        if (grand == NullNode) {
+            m_root = sibling;
+        } else {
+            Node& node = m_nodes[grand];
+            (node.child1 == parent ? node.child1 : node.child2) = sibling;
+        }
+        freeNode(parent);
+        m_nodes[leaf].parent = NullNode;
+
+        if (grand != NullNode)
+            refitAncestors(grand);
+    }
+
+    void DynamicAABBTree::refitAncestors(int32_t index) {
+        while (index != NullNode) {
+            Node& node = m_nodes[index];
+            const Node& child1 = m_nodes[node.child1];
+            const Node& child2 = m_nodes[node.child2];
+            node.bounds = Union(child1.bounds, child2.bounds);
+            node.height = 1 + std::max(child1.height, child2.height);
+
+            rotate(index);
+            index = node.parent;
+        }
+    }
+
+    // Swaps a child of the node with a grandchild on the other side when that
+    // shrinks the surface area of the subtree that changes. The node's own
+    // bounds cover the same leaves either way.
+    void DynamicAABBTree::rotate(int32_t index) {
+        Node& node = m_nodes[index];
+        if (node.height < 2) return;
+
+        struct Rotation {
+            int32_t child;       // moves down, under other
+            int32_t other;       // the node's other child
+            int32_t grandchild;  // moves up, replacing child
+            float gain;
+        } best{NullNode, NullNode, NullNode, 0.0f};
+
+        const auto consider = [&](int32_t child, int32_t other) {
+            const Node& otherNode = m_nodes[other];
+            if (otherNode.isLeaf()) return;
+
+            const float otherArea = Area(otherNode.bounds);
+            const AABB& childBounds = m_nodes[child].bounds;
+            const int32_t grandchildren[2] = {otherNode.child1, otherNode.child2};
+            for (int g = 0; g < 2; ++g) {
+                const AABB& kept = m_nodes[grandchildren[1 - g]].bounds;
+                const float gain = otherArea - Area(Union(childBounds, kept));
+                if (gain > best.gain)
+                    best = {child, other, grandchildren[g], gain};
+            }
+        };
+
+        consider(node.child1, node.child2);
+        consider(node.child2, node.child1);
+        if (best.child == NullNode) return;
+
+        Node& other = m_nodes[best.other];
+        (node.child1 == best.child ? node.child1 : node.child2) = best.grandchild;
+        (other.child1 == best.grandchild ? other.child1 : other.child2) = best.child;
+        m_nodes[best.grandchild].parent = index;
+        m_nodes[best.child].parent = best.other;
+
+        const Node& otherChild1 = m_nodes[other.child1];
+        const Node& otherChild2 = m_nodes[other.child2];
+        other.bounds = Union(otherChild1.bounds, otherChild2.bounds);
+        other.height = 1 + std::max(otherChild1.height, otherChild2.height);
+        node.height = 1 + std::max(m_nodes[node.child1].height, m_nodes[node.child2].height);
+    }
+}
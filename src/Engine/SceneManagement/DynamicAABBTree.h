@@ -0,0 +1,231 @@
+//
+// Created by SIMEON on 10/17/2026.
+//
+
+#ifndef DYNAMICAABBTREE_H
+#define DYNAMICAABBTREE_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <queue>
+#include <vector>
+#include "glm.hpp"
+#include "Bounds.h"
+#include "FrustumCulling.h"
+
+namespace IDK
+{
+    // Incremental bounding volume hierarchy over proxies (one per object).
+    // Leaves store "fat" boxes grown by a margin so small moves cost nothing;
+    // inserts pick the sibling by surface area heuristic and every refit walk
+    // applies tree rotations to keep the hierarchy tight without rebuilds.
+    class DynamicAABBTree
+    {
+    public:
+        static constexpr int32_t NullNode = -1;
+
+        explicit DynamicAABBTree(float margin = 0.1f) : m_margin(margin) {}
+
+        int32_t createProxy(const AABB& bounds, uint32_t userData);
+        void destroyProxy(int32_t proxy);
+
+        // Returns true when the proxy left its fat box and was reinserted.
+        bool moveProxy(int32_t proxy, const AABB& bounds);
+
+        uint32_t getUserData(int32_t proxy) const { return m_nodes[proxy].userData; }
+        const AABB& getFatBounds(int32_t proxy) const { return m_nodes[proxy].bounds; }
+
+        size_t getProxyCount() const { return m_proxyCount; }
+        int32_t getHeight() const { return m_root == NullNode ? 0 : m_nodes[m_root].height; }
+
+        // Sum of internal node areas over the root area; lower is a tighter tree.
+        float getAreaRatio() const;
+
+        // Walks the whole tree checking links, heights and bounds. Debug aid.
+        bool validate() const;
+
+        // callback(userData) -> bool, return false to stop early.
+        template<typename Callback>
+        void queryOverlap(const AABB& bounds, Callback&& callback) const;
+
+        // Subtrees fully inside the frustum are reported without further tests.
+        template<typename Callback>
+        void queryFrustum(const Graphics::Frustum& frustum, Callback&& callback) const;
+
+        // callback(userData, maxDistance) -> float. Return the hit distance to
+        // clip the ray, maxDistance to ignore the proxy, or 0 to stop. Nearer
+        // children are visited first so clipping prunes early.
+        template<typename Callback>
+        void rayCast(const glm::vec3& origin, const glm::vec3& direction, float maxDistance, Callback&& callback) const;
+
+        // The k proxies whose fat boxes are closest to point, nearest first.
+        void queryNearest(const glm::vec3& point, size_t k, std::vector<uint32_t>& result) const;
+
+    private:
+        struct Node {
+            AABB bounds;
+            int32_t parent = NullNode;  // next free node while on the free list
+            int32_t child1 = NullNode;
+            int32_t child2 = NullNode;
+            int32_t height = 0;         // leaves are 0, free nodes -1
+            uint32_t userData = 0;
+
+            bool isLeaf() const { return child1 == NullNode; }
+        };
+
+        static float Area(const AABB& box) {
+            const glm::vec3 d = box.max - box.min;
+            return 2.0f * (d.x * d.y + d.y * d.z + d.z * d.x);
+        }
+
+        static AABB Union(const AABB& a, const AABB& b) {
+            return {glm::min(a.min, b.min), glm::max(a.max, b.max)};
+        }
+
+        static bool Contains(const AABB& outer, const AABB& inner) {
+            return glm::all(glm::lessThanEqual(outer.min, inner.min)) && glm::all(glm::lessThanEqual(inner.max, outer.max));
+        }
+
+        static bool Overlaps(const AABB& a, const AABB& b) {
+            return glm::all(glm::lessThanEqual(a.min, b.max)) && glm::all(glm::lessThanEqual(b.min, a.max));
+        }
+
+        static float DistanceSquared(const AABB& box, const glm::vec3& point) {
+            const glm::vec3 d = glm::max(glm::max(box.min - point, point - box.max), glm::vec3(0.0f));
+            return glm::dot(d, d);
+        }
+
+        // Entry distance of the ray into the box, or infinity on a miss.
+        static float RayEntry(const AABB& box, const glm::vec3& origin, const glm::vec3& inverseDirection, float maxDistance) {
+            const glm::vec3 t0 = (box.min - origin) * inverseDirection;
+            const glm::vec3 t1 = (box.max - origin) * inverseDirection;
+            const glm::vec3 near = glm::min(t0, t1);
+            const glm::vec3 far = glm::max(t0, t1);
+            const float entry = std::max(std::max(near.x, near.y), std::max(near.z, 0.0f));
+            const float exit = std::min(std::min(far.x, far.y), std::min(far.z, maxDistance));
+            return entry <= exit ? entry : std::numeric_limits<float>::infinity();
+        }
+
+        enum class Containment { Outside, Intersecting, Inside };
+        static Containment Classify(const Graphics::Frustum& frustum, const AABB& box);
+
+        int32_t allocateNode();
+        void freeNode(int32_t node);
+        void insertLeaf(int32_t leaf);
+        void removeLeaf(int32_t leaf);
+        int32_t findBestSibling(const AABB& bounds) const;
+        void refitAncestors(int32_t node);
+        void rotate(int32_t node);
+
+        template<typename Callback>
+        bool reportSubtree(int32_t node, Callback& callback) const;
+
+        std::vector<Node> m_nodes;
+        int32_t m_root = NullNode;
+        int32_t m_freeList = NullNode;
+        size_t m_proxyCount = 0;
+        float m_margin;
+
+        mutable std::vector<int32_t> m_stack; // traversal scratch, reused between queries
+    };
+
+    template<typename Callback>
+    void DynamicAABBTree::queryOverlap(const AABB& bounds, Callback&& callback) const {
+        if (m_root == NullNode) return;
+
+        m_stack.clear();
+        m_stack.push_back(m_root);
+        while (!m_stack.empty()) {
+            const Node& node = m_nodes[m_stack.back()];
+            m_stack.pop_back();
+            if (!Overlaps(node.bounds, bounds)) continue;
+
+            if (node.isLeaf()) {
+                if (!callback(node.userData)) return;
+            } else {
+                m_stack.push_back(node.child1);
+                m_stack.push_back(node.child2);
+            }
+        }
+    }
+
+    template<typename Callback>
+    bool DynamicAABBTree::reportSubtree(int32_t root, Callback& callback) const {
+        // Runs below the current position of m_stack and leaves it as it was.
+        const size_t base = m_stack.size();
+        m_stack.push_back(root);
+        while (m_stack.size() > base) {
+            const Node& node = m_nodes[m_stack.back()];
+            m_stack.pop_back();
+            if (node.isLeaf()) {
+                if (!callback(node.userData)) {
+                    m_stack.resize(base);
+                    return false;
+                }
+            } else {
+                m_stack.push_back(node.child1);
+                m_stack.push_back(node.child2);
+            }
+        }
+        return true;
+    }
+
+    template<typename Callback>
+    void DynamicAABBTree::queryFrustum(const Graphics::Frustum& frustum, Callback&& callback) const {
+        if (m_root == NullNode) return;
+
+        m_stack.clear();
+        m_stack.push_back(m_root);
+        while (!m_stack.empty()) {
+            const int32_t index = m_stack.back();
+            m_stack.pop_back();
+
+            const Node& node = m_nodes[index];
+            const Containment containment = Classify(frustum, node.bounds);
+            if (containment == Containment::Outside) continue;
+
+            if (containment == Containment::Inside || node.isLeaf()) {
+                if (!reportSubtree(index, callback)) return;
+            } else {
+                m_stack.push_back(node.child1);
+                m_stack.push_back(node.child2);
+            }
+        }
+    }
+
+    template<typename Callback>
+    void DynamicAABBTree::rayCast(const glm::vec3& origin, const glm::vec3& direction, float maxDistance, Callback&& callback) const {
+        if (m_root == NullNode) return;
+
+        const glm::vec3 inverseDirection = 1.0f / direction;
+
+        m_stack.clear();
+        m_stack.push_back(m_root);
+        while (!m_stack.empty()) {
+            const Node& node = m_nodes[m_stack.back()];
+            m_stack.pop_back();
+            if (RayEntry(node.bounds, origin, inverseDirection, maxDistance) > maxDistance) continue;
+
+            if (node.isLeaf()) {
+                const float distance = callback(node.userData, maxDistance);
+                if (distance <= 0.0f) return;
+                maxDistance = std::min(maxDistance, distance);
+                continue;
+            }
+
+            const float entry1 = RayEntry(m_nodes[node.child1].bounds, origin, inverseDirection, maxDistance);
+            const float entry2 = RayEntry(m_nodes[node.child2].bounds, origin, inverseDirection, maxDistance);
+            const bool firstIsNearer = entry1 <= entry2;
+            const int32_t nearChild = firstIsNearer ? node.child1 : node.child2;
+            const int32_t farChild = firstIsNearer ? node.child2 : node.child1;
+            const float farEntry = firstIsNearer ? entry2 : entry1;
+
+            if (farEntry <= maxDistance) m_stack.push_back(farChild);
+            if (std::min(entry1, entry2) <= maxDistance) m_stack.push_back(nearChild);
+        }
+    }
+}
+
+#endif //DYNAMICAABBTREE_H
@@ -10,12 +10,49 @@
 #include "Sphere.h"
 #include "Cylinder.h"
 #include "Entity.h"
+#include "FrameArena.h"
+#include "GLStateCache.h"
+#include "Collider.h"
+#include "MeshRenderer.h"
 #include "Registry.h"
 #include "SceneManager.h"
 #include "ShaderManager.h"
 
 namespace IDK
 {
+    namespace
+    {
+        // World box around the entity's mesh and collider, or a point at its
+        // position while it has neither. Entities without a transform stay out
+        // of the spatial index.
+        bool worldBounds(const Entity& entity, AABB& bounds) {
+            const Transform* transform = entity.getComponent<Transform>();
+            if (!transform) return false;
+
+            AABB local;
+            const auto* meshRenderer = entity.getComponent<Components::MeshRenderer>();
+            if (const Graphics::Mesh* mesh = meshRenderer ? meshRenderer->getMesh() : nullptr) {
+                local = mesh->getLocalBounds();
+            }
+            if (const IComponentManager* components = Registry::instance().getComponentManager()) {
+                if (const Collider* collider = PickingService::FindCollider(*components, entity.getID())) {
+                    const AABB colliderBounds = collider->getLocalBounds();
+                    local.expand(colliderBounds.min);
+                    local.expand(colliderBounds.max);
+                }
+            }
+
+            const glm::mat4 model = transform->getModelMatrix();
+            if (local.isValid()) {
+                bounds = AABB::Transform(local, model);
+            } else {
+                const glm::vec3 position(model[3]);
+                bounds = {position, position};
+            }
+            return true;
+        }
+    }
+
     Scene::Scene(const std::shared_ptr<IDK::Graphics::Camera> & camera): skyboxTexture(0), skyVAO(0), skyVBO(0) {
         std::cerr << "SCENE()" << std::endl;
 
@@ -33,6 +70,12 @@ namespace IDK
 
         lightManager->addDirectionalLight(directionalLight);
 
+        auto& sceneManager = SceneManager::getInstance();
+        entityListener = sceneManager.registerListener([this](const EntityEvent& event) { onEntityEvent(event); });
+        for (const auto& entity : sceneManager.getEntities()) {
+            onEntityEvent({EntityEvent::Type::Added, entity});
+        }
+
         // this->skyboxTexture = skyboxTexture;
         // std::cerr << "Scene::CTOR" << std::endl;
 
@@ -46,6 +89,8 @@ namespace IDK
     }
 
     Scene::~Scene() {
+        SceneManager::getInstance().unregisterListener(entityListener);
+
         for (const auto& comp : components) {
             if (!comp) {
                 std::cerr << "[ERROR] nullptr component before clearing" << std::endl;
@@ -54,6 +99,8 @@ namespace IDK
 
         components.clear();
 
+        if (gridVAO) glDeleteVertexArrays(1, &gridVAO);
+        if (gridVBO) glDeleteBuffers(1, &gridVBO);
         if (skyVAO) glDeleteVertexArrays(1, &skyVAO);
         if (skyVBO) glDeleteBuffers(1, &skyVBO);
         if (skyboxTexture) glDeleteTextures(1, &skyboxTexture);
@@ -227,9 +274,43 @@ namespace IDK
         }*/
     }
 
+    void Scene::onEntityEvent(const EntityEvent& event) {
+        const EntityID id = event.entity->getID();
+
+        if (event.type == EntityEvent::Type::Removed) {
+            if (const auto it = spatialProxies.find(id); it != spatialProxies.end()) {
+                spatialIndex.destroyProxy(it->second.proxy);
+                spatialProxies.erase(it);
+                picking.forget(id);
+            }
+            return;
+        }
+
+        AABB bounds;
+        if (spatialProxies.contains(id) || !worldBounds(*event.entity, bounds)) return;
+        const uint32_t version = event.entity->getComponent<Transform>()->getVersion();
+        spatialProxies.emplace(id, SpatialProxy{event.entity, spatialIndex.createProxy(bounds, id), version});
+    }
+
+    void Scene::updateSpatialIndex() {
+        // Only entities whose transform changed are refitted, and moveProxy
+        // only touches the tree when one leaves its fat box.
+        for (auto& [id, entry] : spatialProxies) {
+            const Transform* transform = entry.entity->getComponent<Transform>();
+            if (!transform || transform->getVersion() == entry.version) continue;
+
+            entry.version = transform->getVersion();
+            AABB bounds;
+            if (worldBounds(*entry.entity, bounds))
+                spatialIndex.moveProxy(entry.proxy, bounds);
+        }
+    }
+
     void Scene::renderSky() {
+        auto& glState = Graphics::GLStateCache::Instance();
+
         glDepthFunc(GL_LEQUAL);
-        glDepthMask(GL_FALSE);
+        glState.setDepthMask(false);
 
         auto skyShader = ShaderManager::Instance().getSkyShader();
         skyShader->Use();
@@ -242,21 +323,19 @@ namespace IDK
         skyShader->setMat4("projection", projection);
         skyShader->setMat4("model", model);
 
-        glActiveTexture(GL_TEXTURE0);
-        glBindTexture(GL_TEXTURE_CUBE_MAP, skyboxTexture);
+        glState.bindTexture(0, GL_TEXTURE_CUBE_MAP, skyboxTexture);
         skyShader->setInt("skybox", 0);
 
-        glEnable(GL_CULL_FACE);
+        glState.setCullFace(true);
         glCullFace(GL_FRONT);
 
-        glBindVertexArray(skyVAO);
+        glState.bindVertexArray(skyVAO);
         glDrawArrays(GL_TRIANGLES, 0, 36);
-        glBindVertexArray(0);
 
-        glDepthMask(GL_TRUE);
+        glState.setDepthMask(true);
         glDepthFunc(GL_LESS);
         glCullFace(GL_BACK);
-        glDisable(GL_CULL_FACE);
+        glState.setCullFace(false);
     }
 
     void Scene::DrawGrid(float gridSize, float gridStep) const {
@@ -264,16 +343,35 @@ namespace IDK
             glm::vec3 position;
         };
 
-        std::vector<Vertex> gridVertices;
+        // Only rebuilt when the grid parameters change; transient vertices come from the frame arena.
+        if (gridVAO == 0 || gridSize != gridCachedSize || gridStep != gridCachedStep) {
+            FrameVector<Vertex> gridVertices;
+
+            for (float i = -gridSize; i <= gridSize; i += gridStep) {
+                // Lines parallel to X-axis
+                gridVertices.push_back({{i, 0.0f, -gridSize}});
+                gridVertices.push_back({{i, 0.0f, gridSize}});
+
+                // Lines parallel to Z-axis
+                gridVertices.push_back({{-gridSize, 0.0f, i}});
+                gridVertices.push_back({{gridSize, 0.0f, i}});
+            }
+
+            if (gridVAO == 0) {
+                glGenVertexArrays(1, &gridVAO);
+                glGenBuffers(1, &gridVBO);
+            }
+
+            Graphics::GLStateCache::Instance().bindVertexArray(gridVAO);
+            glBindBuffer(GL_ARRAY_BUFFER, gridVBO);
+            glBufferData(GL_ARRAY_BUFFER, gridVertices.size() * sizeof(Vertex), gridVertices.data(), GL_STATIC_DRAW);
 
-        for (float i = -gridSize; i <= gridSize; i += gridStep) {
-            // Lines parallel to X-axis
-            gridVertices.push_back({{i, 0.0f, -gridSize}});
-            gridVertices.push_back({{i, 0.0f, gridSize}});
+            glEnableVertexAttribArray(0);
+            glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void *) nullptr);
 
-            // Lines parallel to Z-axis
-            gridVertices.push_back({{-gridSize, 0.0f, i}});
-            gridVertices.push_back({{gridSize, 0.0f, i}});
+            gridVertexCount = static_cast<GLsizei>(gridVertices.size());
+            gridCachedSize = gridSize;
+            gridCachedStep = gridStep;
         }
 
         const auto & shaderProgram = ShaderManager::Instance().getShaderProgram();
@@ -284,23 +382,8 @@ namespace IDK
         glm::mat4 model = gridTransform.getModelMatrix();
         shaderProgram->setMat4("model", model);
 
-        GLuint gridVAO;
-        glGenVertexArrays(1, &gridVAO);
-        glBindVertexArray(gridVAO);
-
-        GLuint gridVBO;
-        glGenBuffers(1, &gridVBO);
-        glBindBuffer(GL_ARRAY_BUFFER, gridVBO);
-        glBufferData(GL_ARRAY_BUFFER, gridVertices.size() * sizeof(Vertex), gridVertices.data(), GL_STATIC_DRAW);
-
-        glEnableVertexAttribArray(0);
-        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void *) nullptr);
-
-        glBindVertexArray(gridVAO);
-        glDrawArrays(GL_LINES, 0, gridVertices.size());
-
-        glDeleteVertexArrays(1, &gridVAO);
-        glDeleteBuffers(1, &gridVBO);
+        Graphics::GLStateCache::Instance().bindVertexArray(gridVAO);
+        glDrawArrays(GL_LINES, 0, gridVertexCount);
     }
 
 
@@ -353,7 +436,7 @@ namespace IDK
         glGenVertexArrays(1, &skyVAO);
         glGenBuffers(1, &skyVBO);
 
-        glBindVertexArray(skyVAO);
+        Graphics::GLStateCache::Instance().bindVertexArray(skyVAO);
         glBindBuffer(GL_ARRAY_BUFFER, skyVBO);
         glBufferData(GL_ARRAY_BUFFER, sizeof(skyboxVertices), skyboxVertices, GL_STATIC_DRAW);
 
@@ -361,6 +444,6 @@ namespace IDK
         glEnableVertexAttribArray(0);
 
         glBindBuffer(GL_ARRAY_BUFFER, 0);
-        glBindVertexArray(0);
+        Graphics::GLStateCache::Instance().bindVertexArray(0);
     }
-}
\ No newline at end of file
+}
\ No newline at end of file
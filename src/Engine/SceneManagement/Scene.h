@@ -5,11 +5,16 @@
 #ifndef Core_SCENE_H
 #define Core_SCENE_H
 
+#include <unordered_map>
+
 #include "AssetItem.h"
 #include "Camera.h"
+#include "DynamicAABBTree.h"
 #include "Entity.h"
 #include "LightManager.h"
 #include "GameObject.h"
+#include "PickingService.h"
+#include "SceneManager.h"
 #include "Shader.h"
 
 namespace IDK
@@ -41,6 +46,12 @@ namespace IDK
             return lightManager;
         }
 
+        // Refits the spatial index to transforms that changed; once per frame
+        // after the transform hierarchy update and before anything queries it.
+        void updateSpatialIndex();
+        const DynamicAABBTree& getSpatialIndex() const { return spatialIndex; }
+        const PickingService& getPicking() const { return picking; }
+
     private:
         GLuint skyboxTexture;
         GLuint skyVAO, skyVBO;
@@ -48,10 +59,27 @@ namespace IDK
         std::shared_ptr<IDK::Graphics::Shader> finalPassShader;
 
         Transform gridTransform;
+        mutable GLuint gridVAO = 0, gridVBO = 0;
+        mutable GLsizei gridVertexCount = 0;
+        mutable float gridCachedSize = 0.0f, gridCachedStep = 0.0f;
         std::vector<std::shared_ptr<DirectionalLight>> directionalLights;
 
         std::shared_ptr<IDK::Graphics::Camera> m_Camera;
         std::shared_ptr<LightManager> lightManager;
+
+        // Entities registered with SceneManager, keyed by id; proxy user data is the id.
+        struct SpatialProxy {
+            std::shared_ptr<Entity> entity;
+            int32_t proxy;
+            uint32_t version; // transform version the proxy was last fitted to
+        };
+
+        void onEntityEvent(const EntityEvent& event);
+
+        DynamicAABBTree spatialIndex;
+        PickingService picking{spatialIndex};
+        std::unordered_map<EntityID, SpatialProxy> spatialProxies;
+        size_t entityListener = 0;
     };
 }
 #endif
\ No newline at end of file
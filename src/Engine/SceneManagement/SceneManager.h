@@ -5,14 +5,24 @@
 #ifndef SCENEMANAGER_H
 #define SCENEMANAGER_H
 
+#include <functional>
 #include <vector>
 #include <memory>
 
 #include "Entity.h"
 #include "GameObject.h"
 
+struct EntityEvent {
+    enum class Type { Added, Removed };
+
+    Type type;
+    std::shared_ptr<Entity> entity;
+};
+
 class SceneManager {
 public:
+    using EntityListener = std::function<void(const EntityEvent&)>;
+
     static SceneManager& getInstance() {
         static SceneManager instance;
         return instance;
@@ -21,6 +31,7 @@ public:
     void addEntity(const std::shared_ptr<Entity>& ent) {
         if (ent && std::ranges::find(entities, ent) == entities.end()) {
             entities.push_back(ent);
+            notifyListeners({EntityEvent::Type::Added, ent});
         }
     }
 
@@ -28,9 +39,21 @@ public:
         auto it = std::ranges::find(entities, ent);
         if (it != entities.end()) {
             entities.erase(it);
+            notifyListeners({EntityEvent::Type::Removed, ent});
         }
     }
 
+    // Returns a handle for unregisterListener; listeners must unregister
+    // before they go away since the manager outlives every scene.
+    size_t registerListener(EntityListener listener) {
+        listeners.emplace_back(++lastListenerHandle, std::move(listener));
+        return lastListenerHandle;
+    }
+
+    void unregisterListener(size_t handle) {
+        std::erase_if(listeners, [handle](const auto& entry) { return entry.first == handle; });
+    }
+
     const std::vector<std::shared_ptr<Entity>>& getEntities() const {
         return entities;
     }
@@ -38,6 +61,14 @@ public:
 private:
     SceneManager() = default;
     std::vector<std::shared_ptr<Entity>> entities;
+    std::vector<std::pair<size_t, EntityListener>> listeners;
+    size_t lastListenerHandle = 0;
+
+    void notifyListeners(const EntityEvent& event) const {
+        for (const auto& [handle, listener] : listeners) {
+            listener(event);
+        }
+    }
 };
 
 #endif //SCENEMANAGER_H
@@ -0,0 +1,42 @@
+//
+// Created by SIMEON on 10/17/2026.
+//
+
+#ifndef BOUNDS_H
+#define BOUNDS_H
+
+#include <limits>
+#include "glm.hpp"
+
+namespace IDK
+{
+    struct AABB {
+        glm::vec3 min{std::numeric_limits<float>::max()};
+        glm::vec3 max{std::numeric_limits<float>::lowest()};
+
+        bool isValid() const { return min.x <= max.x && min.y <= max.y && min.z <= max.z; }
+
+        glm::vec3 center() const { return (min + max) * 0.5f; }
+        glm::vec3 extents() const { return (max - min) * 0.5f; }
+
+        void expand(const glm::vec3& point) {
+            min = glm::min(min, point);
+            max = glm::max(max, point);
+        }
+
+        // Tight box around a transformed box: the extents go through the
+        // absolute value of the linear part (Arvo).
+        static AABB Transform(const AABB& local, const glm::mat4& model) {
+            const glm::vec3 center = glm::vec3(model * glm::vec4(local.center(), 1.0f));
+            const glm::vec3 localExtents = local.extents();
+
+            glm::vec3 extents(0.0f);
+            for (int column = 0; column < 3; ++column)
+                extents += glm::abs(glm::vec3(model[column])) * localExtents[column];
+
+            return {center - extents, center + extents};
+        }
+    };
+}
+
+#endif //BOUNDS_H
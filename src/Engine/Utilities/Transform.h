@@ -5,24 +5,44 @@
 #ifndef LUPUSFIRE_CORE_TRANSFORM_H
 #define LUPUSFIRE_CORE_TRANSFORM_H
 
+#include <algorithm>
+#include <cstdint>
+#include <vector>
 #include "../ECS/Component.h"
 #include "gtx/matrix_decompose.hpp"
+#include "TransformHierarchy.h"
 
 class Transform final : public Component {
 public:
     explicit Transform()
         : Component("Transform"),
-          modelMatrix(glm::mat4(1.0f)),
           position(glm::vec3(0.0f)),
           rotation(glm::quat(1.0f, 0.0f, 0.0f, 0.0f)),
           m_scale(glm::vec3(1.0f))
     {
+        IDK::TransformHierarchy::Instance().add(this);
     }
 
+    // Children are left at their local transform, as roots.
+    ~Transform() override {
+        setParent(nullptr);
+        for (Transform* child : m_children) {
+            child->m_parent = nullptr;
+        }
+        IDK::TransformHierarchy::Instance().remove(this);
+    }
+
+    // The hierarchy tracks transforms by address.
+    Transform(const Transform&) = delete;
+    Transform& operator=(const Transform&) = delete;
+
+    void setPosition(const glm::vec3& pos) { position = pos; markDirty(); }
+    void setRotation(const glm::quat& rot) { rotation = rot; markDirty(); }
+    void setScale(const glm::vec3& scale) { m_scale = scale; markDirty(); }
 
-    void setPosition(const glm::vec3& pos) { position = pos; }
-    void setRotation(const glm::quat& rot) { rotation = rot; }
-    void setScale(const glm::vec3& scale) { m_scale = scale; }
+    // Bumped by every setter and whenever the world matrix changes, so caches
+    // of derived matrices can tell when to recompute.
+    uint32_t getVersion() const { return version; }
 
     glm::vec3 getPosition() const { return position; }
     glm::quat getRotation() const { return rotation; }
@@ -36,36 +56,86 @@ public:
         return position;
     }
 
-    glm::mat4 getModelMatrix() const {
-        glm::mat4 transform = glm::mat4(1.0f);
+    void setParent(Transform* parent) {
+        if (parent == m_parent) return;
+        for (const Transform* ancestor = parent; ancestor; ancestor = ancestor->m_parent) {
+            if (ancestor == this) return; // would make a cycle
+        }
+
+        if (m_parent) {
+            std::erase(m_parent->m_children, this);
+        }
+        m_parent = parent;
+        if (m_parent) {
+            m_parent->m_children.push_back(this);
+        }
+        IDK::TransformHierarchy::Instance().markStructureDirty();
+    }
 
-        transform = glm::translate(transform, position);
-        transform *= glm::mat4_cast(rotation);
-        transform = glm::scale(transform, m_scale);
+    Transform* getParent() const { return m_parent; }
+    const std::vector<Transform*>& getChildren() const { return m_children; }
+
+    // translate * rotate * scale, rebuilt only after a setter ran.
+    const glm::mat4& getLocalMatrix() const {
+        if (m_localDirty) {
+            m_localMatrix = glm::translate(glm::mat4(1.0f), position);
+            m_localMatrix *= glm::mat4_cast(rotation);
+            m_localMatrix = glm::scale(m_localMatrix, m_scale);
+            m_localDirty = false;
+        }
+        return m_localMatrix;
+    }
 
-        return transform;
+    // World matrix. Comes from the hierarchy's contiguous store once
+    // TransformHierarchy::update() has caught up, otherwise it is composed
+    // from the parent chain so it is never stale.
+    glm::mat4 getModelMatrix() const {
+        const IDK::TransformHierarchy& hierarchy = IDK::TransformHierarchy::Instance();
+        if (hierarchy.isClean()) {
+            return hierarchy.getWorldMatrix(m_slot);
+        }
+        return m_parent ? m_parent->getModelMatrix() * getLocalMatrix() : getLocalMatrix();
     }
 
     glm::mat4 getRotationMatrix() const {
         return glm::mat4_cast(rotation);
     }
 
+    // Takes the matrix as the local transform.
     void setModelMatrix(const glm::mat4& matrix) {
-        modelMatrix = matrix;
         glm::vec3 skew;
         glm::vec4 perspective;
-        glm::decompose(modelMatrix, m_scale, rotation, position, skew, perspective);
+        glm::decompose(matrix, m_scale, rotation, position, skew, perspective);
 
         // Ensure quaternion is normalized after decomposition
         rotation = glm::normalize(rotation);
+        markDirty();
+    }
 
+private:
+    friend class IDK::TransformHierarchy;
+
+    void markDirty() {
+        m_localDirty = true;
+        ++version;
+        if (!m_queued) {
+            m_queued = true;
+            IDK::TransformHierarchy::Instance().markDirty(this);
+        }
     }
 
-    glm::mat4 modelMatrix;
     glm::vec3 position;
     glm::quat rotation;
     glm::vec3 m_scale;
 
+    Transform* m_parent = nullptr;
+    std::vector<Transform*> m_children;
+
+    mutable glm::mat4 m_localMatrix{1.0f};
+    mutable bool m_localDirty = true;
+    bool m_queued = false;    // already on the hierarchy's dirty list
+    uint32_t m_slot = 0;      // index into the hierarchy's world matrices
+    uint32_t version = 0;
 };
 
 
@@ -0,0 +1,103 @@
+//
+// Created by SIMEON on 10/17/2026.
+//
+
+#include "TransformHierarchy.h"
+
+#include <algorithm>
+#include "Transform.h"
+
+namespace IDK
+{
+    TransformHierarchy& TransformHierarchy::Instance() {
+        // Never destroyed: transforms owned by other singletons (the registry's
+        // pools) are torn down after function-local statics created later.
+        static TransformHierarchy* instance = new TransformHierarchy();
+        return *instance;
+    }
+
+    void TransformHierarchy::add(Transform* transform) {
+        transform->m_slot = static_cast<uint32_t>(m_transforms.size());
+        m_transforms.push_back(transform);
+        m_structureDirty = true;
+    }
+
+    void TransformHierarchy::remove(Transform* transform) {
+        if (transform->m_slot < m_transforms.size() && m_transforms[transform->m_slot] == transform)
+            m_transforms[transform->m_slot] = nullptr;
+        m_structureDirty = true;
+    }
+
+    void TransformHierarchy::markDirty(Transform* transform) {
+        // A pending rebuild recomputes everything anyway.
+        if (!m_structureDirty)
+            m_dirty.push_back(transform->m_slot);
+    }
+
+    void TransformHierarchy::update() {
+        if (m_structureDirty) {
+            rebuild();
+            return;
+        }
+
+        m_lastUpdateCount = 0;
+        if (m_dirty.empty()) return;
+
+        const uint32_t first = *std::min_element(m_dirty.begin(), m_dirty.end());
+        for (const uint32_t slot : m_dirty)
+            m_changed[slot] = 1;
+
+        // Parents precede children, so one forward pass carries a change down
+        // every subtree below a dirty transform.
+        for (size_t slot = first; slot < m_world.size(); ++slot) {
+            const int32_t parent = m_parents[slot];
+            if (parent >= 0 && m_changed[parent])
+                m_changed[slot] = 1;
+            if (!m_changed[slot]) continue;
+
+            Transform* transform = m_transforms[slot];
+            m_world[slot] = parent >= 0 ? m_world[parent] * transform->getLocalMatrix() : transform->getLocalMatrix();
+            transform->m_queued = false;
+            ++transform->version;
+            ++m_lastUpdateCount;
+        }
+
+        std::fill(m_changed.begin() + first, m_changed.end(), 0);
+        m_dirty.clear();
+    }
+
+    void TransformHierarchy::rebuild() {
+        // Breadth-first from the roots, which also groups slots by depth.
+        std::vector<Transform*> order;
+        order.reserve(m_transforms.size());
+        for (Transform* transform : m_transforms) {
+            if (transform && !transform->m_parent)
+                order.push_back(transform);
+        }
+        for (size_t i = 0; i < order.size(); ++i) {
+            for (Transform* child : order[i]->m_children)
+                order.push_back(child);
+        }
+
+        m_transforms = std::move(order);
+        const size_t count = m_transforms.size();
+        m_parents.resize(count);
+        m_world.resize(count);
+        m_changed.assign(count, 0);
+
+        for (size_t slot = 0; slot < count; ++slot) {
+            Transform* transform = m_transforms[slot];
+            transform->m_slot = static_cast<uint32_t>(slot);
+
+            const Transform* parent = transform->m_parent;
+            m_parents[slot] = parent ? static_cast<int32_t>(parent->m_slot) : -1;
+            m_world[slot] = parent ? m_world[parent->m_slot] * transform->getLocalMatrix() : transform->getLocalMatrix();
+            transform->m_queued = false;
+            ++transform->version;
+        }
+
+        m_dirty.clear();
+        m_structureDirty = false;
+        m_lastUpdateCount = count;
+    }
+}
@@ -0,0 +1,58 @@
+//
+// Created by SIMEON on 10/17/2026.
+//
+
+#ifndef TRANSFORMHIERARCHY_H
+#define TRANSFORMHIERARCHY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "glm.hpp"
+
+class Transform;
+
+namespace IDK
+{
+    // World matrices of every Transform, stored contiguously in breadth-first
+    // order so a parent always comes before its children. Setters queue their
+    // transform; update() then walks forward once from the first dirty slot,
+    // recomputing dirty transforms and everything below them. A frame where
+    // nothing moved returns straight away.
+    //
+    // Main thread only, like the rest of the scene.
+    class TransformHierarchy
+    {
+    public:
+        static TransformHierarchy& Instance();
+
+        void add(Transform* transform);
+        void remove(Transform* transform);
+        void markDirty(Transform* transform);
+        void markStructureDirty() { m_structureDirty = true; }
+
+        void update();
+
+        // True when every cached world matrix is current.
+        bool isClean() const { return !m_structureDirty && m_dirty.empty(); }
+        const glm::mat4& getWorldMatrix(uint32_t slot) const { return m_world[slot]; }
+
+        size_t size() const { return m_world.size(); }
+        size_t getLastUpdateCount() const { return m_lastUpdateCount; }
+
+    private:
+        TransformHierarchy() = default;
+
+        void rebuild();
+
+        std::vector<Transform*> m_transforms; // by slot; null for removed ones until the next rebuild
+        std::vector<int32_t> m_parents;       // parent slot, -1 for roots
+        std::vector<glm::mat4> m_world;
+        std::vector<uint8_t> m_changed;
+        std::vector<uint32_t> m_dirty;
+        bool m_structureDirty = false;
+        size_t m_lastUpdateCount = 0;
+    };
+}
+
+#endif //TRANSFORMHIERARCHY_H
@@ -11,17 +11,34 @@ uniform vec3 objectColor;
 uniform vec3 wireframeColor;
 uniform bool wireframe;
 
+// Compact G-buffer: gPosition is not bound (position comes from depth) and
+// gNormal is RG16, holding the octahedral encoding remapped to [0, 1].
+uniform bool packedNormals;
+
+vec2 octEncode(vec3 n)
+{
+    n /= abs(n.x) + abs(n.y) + abs(n.z);
+    if (n.z >= 0.0)
+        return n.xy;
+    return (1.0 - abs(n.yx)) * vec2(n.x >= 0.0 ? 1.0 : -1.0, n.y >= 0.0 ? 1.0 : -1.0);
+}
+
+vec3 encodeNormal(vec3 n)
+{
+    return packedNormals ? vec3(octEncode(n) * 0.5 + 0.5, 0.0) : n;
+}
+
 void main()
 {
     if (wireframe) {
         // Render the wireframe color
         gPosition = FragPos;
-        gNormal = normalize(Normal);
+        gNormal = encodeNormal(normalize(Normal));
         gAlbedoSpec = vec4(wireframeColor, 1.0);  // Wireframe color
     } else {
         // Normal G-buffer rendering
         gPosition = FragPos;
-        gNormal = normalize(Normal);
+        gNormal = encodeNormal(normalize(Normal));
         gAlbedoSpec = vec4(objectColor, 1.0);
     }
 
@@ -11,10 +11,29 @@ uniform mat4 model;
 uniform mat4 view;
 uniform mat4 projection;
 
+// Compact meshes store bounds-relative positions and octahedral normals (see VertexCompression.h).
+uniform vec3 positionOffset = vec3(0.0);
+uniform vec3 positionScale = vec3(1.0);
+uniform bool octNormals = false;
+
+// (0, 0) is what OctEncode stores for a zero normal; it decodes to +Z, and no
+// input makes n zero before the normalize.
+vec3 octDecode(vec2 e)
+{
+    vec3 n = vec3(e, 1.0 - abs(e.x) - abs(e.y));
+    float t = max(-n.z, 0.0);
+    n.x += n.x >= 0.0 ? -t : t;
+    n.y += n.y >= 0.0 ? -t : t;
+    return normalize(n);
+}
+
 void main()
 {
-    FragPos = vec3(model * vec4(aPos, 1.0));
-    Normal = mat3(transpose(inverse(model))) * aNormal;
+    vec3 position = positionOffset + positionScale * aPos;
+    vec3 normal = octNormals ? octDecode(aNormal.xy) : aNormal;
+
+    FragPos = vec3(model * vec4(position, 1.0));
+    Normal = mat3(transpose(inverse(model))) * normal;
     TexCoords = aTexCoords;
 
     gl_Position = projection * view * vec4(FragPos, 1.0);
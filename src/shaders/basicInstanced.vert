@@ -0,0 +1,46 @@
+#version 450 core
+layout(location = 0) in vec3 aPos;
+layout(location = 1) in vec3 aNormal;
+layout(location = 2) in vec2 aTexCoords;
+// Per-instance model matrix, one column per location (see Mesh::DrawInstanced).
+layout(location = 3) in mat4 aModel;
+
+out vec3 FragPos;
+out vec3 Normal;
+out vec2 TexCoords;
+
+// Per-frame camera data, streamed through DeferredRenderer's frame ring
+layout(std140, binding = 0) uniform FrameData {
+    mat4 view;
+    mat4 projection;
+    mat4 inverseViewProjection;
+    vec3 viewPos;
+};
+
+// Compact meshes store bounds-relative positions and octahedral normals (see VertexCompression.h).
+uniform vec3 positionOffset = vec3(0.0);
+uniform vec3 positionScale = vec3(1.0);
+uniform bool octNormals = false;
+
+// (0, 0) is what OctEncode stores for a zero normal; it decodes to +Z, and no
+// input makes n zero before the normalize.
+vec3 octDecode(vec2 e)
+{
+    vec3 n = vec3(e, 1.0 - abs(e.x) - abs(e.y));
+    float t = max(-n.z, 0.0);
+    n.x += n.x >= 0.0 ? -t : t;
+    n.y += n.y >= 0.0 ? -t : t;
+    return normalize(n);
+}
+
+void main()
+{
+    vec3 position = positionOffset + positionScale * aPos;
+    vec3 normal = octNormals ? octDecode(aNormal.xy) : aNormal;
+
+    FragPos = vec3(aModel * vec4(position, 1.0));
+    Normal = mat3(transpose(inverse(aModel))) * normal;
+    TexCoords = aTexCoords;
+
+    gl_Position = projection * view * vec4(FragPos, 1.0);
+}
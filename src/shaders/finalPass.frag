@@ -5,16 +5,51 @@ uniform sampler2D gNormal;
 uniform sampler2D gAlbedoSpec;
 uniform sampler2D lightingTexture;
 
+// Compact G-buffer: no position target; world position is rebuilt from
+// depth and normals are octahedral-encoded in RG16.
+uniform bool compactGBuffer;
+uniform sampler2D gDepth;
+
+// Per-frame camera data, streamed through DeferredRenderer's frame ring
+layout(std140, binding = 0) uniform FrameData {
+    mat4 view;
+    mat4 projection;
+    mat4 inverseViewProjection;
+    vec3 viewPos;
+};
+
+vec3 octDecode(vec2 e)
+{
+    vec3 n = vec3(e, 1.0 - abs(e.x) - abs(e.y));
+    float t = max(-n.z, 0.0);
+    n.x += n.x >= 0.0 ? -t : t;
+    n.y += n.y >= 0.0 ? -t : t;
+    return normalize(n);
+}
+
+vec3 gBufferPosition(vec2 uv)
+{
+    if (!compactGBuffer)
+        return texture(gPosition, uv).rgb;
+
+    vec4 world = inverseViewProjection * vec4(vec3(uv, texture(gDepth, uv).r) * 2.0 - 1.0, 1.0);
+    return world.xyz / world.w;
+}
+
+vec3 gBufferNormal(vec2 uv)
+{
+    return compactGBuffer ? octDecode(texture(gNormal, uv).rg * 2.0 - 1.0)
+                          : normalize(texture(gNormal, uv).rgb);
+}
+
 out vec4 FragColor;
 in vec2 TexCoords;
 
-uniform vec3 viewPos;  // Camera position
-
 void main()
 {
     // Retrieve data from the G-buffer
-    vec3 FragPos = texture(gPosition, TexCoords).rgb;  // World space position
-    vec3 Normal = normalize(texture(gNormal, TexCoords).rgb);  // Normal vector
+    vec3 FragPos = gBufferPosition(TexCoords);  // World space position
+    vec3 Normal = gBufferNormal(TexCoords);  // Normal vector
     vec3 Albedo = texture(gAlbedoSpec, TexCoords).rgb;  // Color of the object
 
     // Retrieve lighting data (from the lighting pass)
@@ -0,0 +1,28 @@
+#version 450 core
+
+in vec3 FragPos;
+in vec3 Normal;
+
+out vec4 FragColor;
+
+layout(std140, binding = 0) uniform FrameData {
+    mat4 view;
+    mat4 projection;
+    vec4 frustumPlanes[6];
+    vec4 lightDirection;  // w is 1 when the scene has a directional light
+    vec4 lightAmbient;
+    vec4 lightDiffuse;
+};
+
+uniform vec3 objectColor;
+
+void main()
+{
+    vec3 lighting = vec3(1.0);
+    if (lightDirection.w > 0.0) {
+        float diff = max(dot(normalize(Normal), -lightDirection.xyz), 0.0);
+        lighting = lightAmbient.rgb + diff * lightDiffuse.rgb;
+    }
+
+    FragColor = vec4(objectColor * lighting, 1.0);
+}
@@ -0,0 +1,26 @@
+#version 450 core
+layout(location = 0) in vec3 aPos;
+layout(location = 1) in vec3 aNormal;
+// The object's model matrix, fetched from the object buffer at the draw
+// command's base instance (see GPUDrivenRenderer).
+layout(location = 3) in mat4 aModel;
+
+out vec3 FragPos;
+out vec3 Normal;
+
+layout(std140, binding = 0) uniform FrameData {
+    mat4 view;
+    mat4 projection;
+    vec4 frustumPlanes[6];
+    vec4 lightDirection;
+    vec4 lightAmbient;
+    vec4 lightDiffuse;
+};
+
+void main()
+{
+    FragPos = vec3(aModel * vec4(aPos, 1.0));
+    Normal = mat3(transpose(inverse(aModel))) * aNormal;
+
+    gl_Position = projection * view * vec4(FragPos, 1.0);
+}
@@ -8,6 +8,43 @@ uniform sampler2D gPosition;
 uniform sampler2D gNormal;
 uniform sampler2D gAlbedoSpec;
 
+// Compact G-buffer: no position target; world position is rebuilt from
+// depth and normals are octahedral-encoded in RG16.
+uniform bool compactGBuffer;
+uniform sampler2D gDepth;
+
+// Per-frame camera data, streamed through DeferredRenderer's frame ring
+layout(std140, binding = 0) uniform FrameData {
+    mat4 view;
+    mat4 projection;
+    mat4 inverseViewProjection;
+    vec3 viewPos;
+};
+
+vec3 octDecode(vec2 e)
+{
+    vec3 n = vec3(e, 1.0 - abs(e.x) - abs(e.y));
+    float t = max(-n.z, 0.0);
+    n.x += n.x >= 0.0 ? -t : t;
+    n.y += n.y >= 0.0 ? -t : t;
+    return normalize(n);
+}
+
+vec3 gBufferPosition(vec2 uv)
+{
+    if (!compactGBuffer)
+        return texture(gPosition, uv).rgb;
+
+    vec4 world = inverseViewProjection * vec4(vec3(uv, texture(gDepth, uv).r) * 2.0 - 1.0, 1.0);
+    return world.xyz / world.w;
+}
+
+vec3 gBufferNormal(vec2 uv)
+{
+    return compactGBuffer ? octDecode(texture(gNormal, uv).rg * 2.0 - 1.0)
+                          : normalize(texture(gNormal, uv).rgb);
+}
+
 // Directional light properties
 struct DirectionalLight {
     vec3 direction;
@@ -17,13 +54,111 @@ struct DirectionalLight {
 };
 
 uniform DirectionalLight dirLight;
-uniform vec3 viewPos; // Camera position in world space
+
+// Point and spot lights, binned per froxel by LightClusterer on the CPU
+struct ClusterLight {
+    vec4 positionRange;     // xyz position, w range
+    vec4 colorIntensity;    // rgb color, a intensity
+    vec4 directionCosOuter; // xyz spot direction, w cos(outer angle); -2 for point lights
+    vec4 spotScale;         // x 1 / (cos(inner) - cos(outer))
+};
+
+layout(std430, binding = 0) readonly buffer ClusterLights {
+    ClusterLight clusterLights[];
+};
+
+layout(std430, binding = 1) readonly buffer ClusterGrid {
+    uvec4 clusterSize;      // x, y, z cluster counts, w light count
+    vec4 clusterSlicing;    // slice = floor(log(depth) * x + y)
+    uvec2 clusterRanges[];  // offset, count into clusterLightIndices
+};
+
+layout(std430, binding = 2) readonly buffer ClusterLightIndices {
+    uint clusterLightIndices[];
+};
+
+// Cascaded shadow map of dirLight, one layer per cascade (see ShadowCascades)
+uniform sampler2DArrayShadow shadowMap;
+
+layout(std140, binding = 1) uniform ShadowData {
+    mat4 shadowCascades[4];
+    int shadowCascadeCount;
+};
+
+// Uses the first cascade that covers the fragment; past the last one it is lit.
+float directionalShadow(vec3 fragPos)
+{
+    for (int c = 0; c < shadowCascadeCount; ++c) {
+        vec4 lightClip = shadowCascades[c] * vec4(fragPos, 1.0);
+        vec3 coord = lightClip.xyz / lightClip.w * 0.5 + 0.5;
+        if (any(lessThan(coord, vec3(0.0))) || any(greaterThan(coord, vec3(1.0))))
+            continue;
+
+        // 3x3 taps, each a bilinear 2x2 comparison
+        vec2 texel = 1.0 / vec2(textureSize(shadowMap, 0).xy);
+        float lit = 0.0;
+        for (int x = -1; x <= 1; ++x)
+            for (int y = -1; y <= 1; ++y)
+                lit += texture(shadowMap, vec4(coord.xy + vec2(x, y) * texel, float(c), coord.z));
+        return lit / 9.0;
+    }
+    return 1.0;
+}
+
+vec3 shadeClusteredLights(vec3 fragPos, vec3 normal, vec3 albedo, vec3 viewDir, float shininess)
+{
+    if (clusterSize.w == 0u)
+        return vec3(0.0);
+
+    vec4 viewSpace = view * vec4(fragPos, 1.0);
+    float depth = -viewSpace.z;
+    vec4 clip = projection * viewSpace;
+    if (depth <= 0.0 || clip.w <= 0.0)
+        return vec3(0.0);
+
+    vec2 tile = (clip.xy / clip.w * 0.5 + 0.5) * vec2(clusterSize.xy);
+    uvec3 cell = uvec3(clamp(ivec2(tile), ivec2(0), ivec2(clusterSize.xy) - 1),
+                       clamp(int(floor(log(depth) * clusterSlicing.x + clusterSlicing.y)), 0, int(clusterSize.z) - 1));
+    uvec2 range = clusterRanges[cell.x + clusterSize.x * (cell.y + clusterSize.y * cell.z)];
+
+    vec3 result = vec3(0.0);
+    for (uint i = 0u; i < range.y; ++i) {
+        ClusterLight light = clusterLights[clusterLightIndices[range.x + i]];
+
+        vec3 toLight = light.positionRange.xyz - fragPos;
+        float distance = length(toLight);
+        float lightRange = light.positionRange.w;
+        if (distance >= lightRange)
+            continue;
+
+        vec3 lightDir = toLight / max(distance, 1e-4);
+
+        // Inverse square with a window that reaches zero at the range
+        float window = clamp(1.0 - pow(distance / lightRange, 4.0), 0.0, 1.0);
+        float attenuation = window * window / (distance * distance + 1.0);
+
+        float cone = clamp((dot(-lightDir, light.directionCosOuter.xyz) - light.directionCosOuter.w) * light.spotScale.x, 0.0, 1.0);
+
+        float diff = max(dot(normal, lightDir), 0.0);
+        float spec = pow(max(dot(viewDir, reflect(-lightDir, normal)), 0.0), shininess);
+
+        vec3 radiance = light.colorIntensity.rgb * light.colorIntensity.a * attenuation * cone;
+        result += radiance * (diff * albedo + spec);
+    }
+    return result;
+}
 
 void main()
 {
+    // Background: nothing was drawn, so leave it unlit
+    if (compactGBuffer && texture(gDepth, TexCoords).r >= 1.0) {
+        FragColor = vec4(0.0, 0.0, 0.0, 1.0);
+        return;
+    }
+
     // Retrieve data from G-buffer (if applicable)
-    vec3 FragPos = texture(gPosition, TexCoords).rgb;
-    vec3 Normal  = normalize(texture(gNormal, TexCoords).rgb);
+    vec3 FragPos = gBufferPosition(TexCoords);
+    vec3 Normal  = gBufferNormal(TexCoords);
     vec3 Albedo  = texture(gAlbedoSpec, TexCoords).rgb;
 
     // Set directional light properties to white
@@ -40,8 +175,13 @@ void main()
     float spec      = pow(max(dot(viewDir, reflectDir), 0.0), shininess);
     vec3 specular  = dirLight.specular * spec * vec3(1.0); // White specular
 
+    float shadow = directionalShadow(FragPos);
+    diffuse  *= shadow;
+    specular *= shadow;
+
     // Combine results
     vec3 lighting = ambient + diffuse + specular;
+    lighting += shadeClusteredLights(FragPos, Normal, Albedo, viewDir, shininess);
 
     // Output final color
     FragColor = vec4(lighting, 1.0);
@@ -0,0 +1,16 @@
+#version 450 core
+layout(location = 0) in vec3 aPos;
+// Per-instance model matrix, one column per location (see Mesh::DrawInstanced).
+layout(location = 3) in mat4 aModel;
+
+// Cascade being drawn, from ShadowCascades::fit().
+uniform mat4 lightViewProjection;
+
+// Compact meshes store bounds-relative positions (see VertexCompression.h).
+uniform vec3 positionOffset = vec3(0.0);
+uniform vec3 positionScale = vec3(1.0);
+
+void main()
+{
+    gl_Position = lightViewProjection * aModel * vec4(positionOffset + positionScale * aPos, 1.0);
+}
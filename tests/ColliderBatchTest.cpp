@@ -0,0 +1,183 @@
+//
+// Created by SIMEON on 10/17/2026.
+//
+
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "gtc/matrix_transform.hpp"
+
+#include "BoxCollider.h"
+#include "CapsuleCollider.h"
+#include "ColliderBatch.h"
+#include "CylinderCollider.h"
+#include "SphereCollider.h"
+#include "Test.h"
+
+// Every lane of the batched kernels (AVX or SSE2, whichever this build
+// targets, plus the scalar remainder) against the collider's own
+// intersectsRay / intersectsLocalRay.
+namespace
+{
+    constexpr float Infinity = std::numeric_limits<float>::infinity();
+    constexpr float MaxDistance = 60.0f;
+
+    // There is no GL context in a test, but the collider constructors build
+    // their wireframe buffers, so the entry points they call are no-ops here.
+    void APIENTRY GenerateNames(GLsizei count, GLuint* names) {
+        for (GLsizei i = 0; i < count; ++i) names[i] = static_cast<GLuint>(i + 1);
+    }
+    void APIENTRY DeleteNames(GLsizei, const GLuint*) {}
+    void APIENTRY BindName(GLenum, GLuint) {}
+    void APIENTRY BindVertexArray(GLuint) {}
+    void APIENTRY BufferData(GLenum, GLsizeiptr, const void*, GLenum) {}
+    void APIENTRY VertexAttribPointer(GLuint, GLint, GLenum, GLboolean, GLsizei, const void*) {}
+    void APIENTRY EnableVertexAttribArray(GLuint) {}
+
+    void StubGL() {
+        glGenVertexArrays = GenerateNames;
+        glGenBuffers = GenerateNames;
+        glDeleteVertexArrays = DeleteNames;
+        glDeleteBuffers = DeleteNames;
+        glBindBuffer = BindName;
+        glBindVertexArray = BindVertexArray;
+        glBufferData = BufferData;
+        glVertexAttribPointer = VertexAttribPointer;
+        glEnableVertexAttribArray = EnableVertexAttribArray;
+    }
+
+    // Translated, rotated and non-uniformly scaled, so the lanes' inverse
+    // frames are exercised as well as the shape tests.
+    glm::mat4 RandomModel(std::mt19937& rng) {
+        std::uniform_real_distribution<float> position(-20.0f, 20.0f), angle(0.0f, 6.2831853f), scale(0.4f, 2.5f);
+        glm::mat4 model = glm::translate(glm::mat4(1.0f), glm::vec3(position(rng), position(rng), position(rng)));
+        const glm::vec3 axis = glm::normalize(glm::vec3(position(rng), position(rng), position(rng)) + glm::vec3(0.01f));
+        model = glm::rotate(model, angle(rng), axis);
+        return glm::scale(model, glm::vec3(scale(rng), scale(rng), scale(rng)));
+    }
+
+    std::unique_ptr<BoxCollider> MakeCollider(std::mt19937& rng, const BoxCollider*) {
+        std::uniform_real_distribution<float> offset(-1.0f, 1.0f), size(0.2f, 3.0f);
+        const glm::vec3 min(offset(rng), offset(rng), offset(rng));
+        return std::make_unique<BoxCollider>(glm::vec3(0.0f), min, min + glm::vec3(size(rng), size(rng), size(rng)));
+    }
+
+    std::unique_ptr<SphereCollider> MakeCollider(std::mt19937& rng, const SphereCollider*) {
+        std::uniform_real_distribution<float> offset(-1.0f, 1.0f), radius(0.2f, 3.0f);
+        return std::make_unique<SphereCollider>(glm::vec3(0.0f), radius(rng), glm::vec3(offset(rng), offset(rng), offset(rng)));
+    }
+
+    std::unique_ptr<CapsuleCollider> MakeCollider(std::mt19937& rng, const CapsuleCollider*) {
+        std::uniform_real_distribution<float> offset(-1.0f, 1.0f), radius(0.2f, 2.0f), height(0.2f, 4.0f);
+        return std::make_unique<CapsuleCollider>(glm::vec3(offset(rng), offset(rng), offset(rng)), radius(rng), height(rng));
+    }
+
+    std::unique_ptr<CylinderCollider> MakeCollider(std::mt19937& rng, const CylinderCollider*) {
+        std::uniform_real_distribution<float> radius(0.2f, 2.0f), height(0.2f, 4.0f);
+        return std::make_unique<CylinderCollider>(glm::vec3(0.0f), height(rng), radius(rng));
+    }
+
+    template<typename ColliderType>
+    void LanesMatchScalar(const char* shape) {
+        std::mt19937 rng(29);
+        std::uniform_real_distribution<float> position(-30.0f, 30.0f), direction(-1.0f, 1.0f);
+
+        // Every remainder of the 8- and 4-wide loops, plus a large batch.
+        for (size_t count : {1u, 3u, 4u, 7u, 8u, 9u, 15u, 17u, 501u}) {
+            std::vector<std::unique_ptr<ColliderType>> colliders;
+            std::vector<glm::mat4> models;
+            IDK::ColliderBatch<ColliderType> batch;
+            batch.reserve(count);
+            for (size_t i = 0; i < count; ++i) {
+                colliders.push_back(MakeCollider(rng, static_cast<const ColliderType*>(nullptr)));
+                models.push_back(RandomModel(rng));
+                IDK_CHECK(batch.add(*colliders.back(), models.back()) == i);
+            }
+            IDK_CHECK(batch.size() == count);
+
+            std::vector<float> distances;
+            size_t mismatches = 0, hits = 0;
+            for (int r = 0; r < 64; ++r) {
+                // A quarter of the rays start at a collider's origin, which is
+                // inside most shapes.
+                const glm::vec3 origin = r % 4 == 0 ? glm::vec3(models[r % count][3])
+                                                    : glm::vec3(position(rng), position(rng), position(rng));
+                const Ray ray(origin, glm::normalize(glm::vec3(direction(rng), direction(rng), direction(rng)) + glm::vec3(1e-3f)));
+                batch.raycast(ray.getOrigin(), ray.getDirection(), MaxDistance, distances);
+                IDK_CHECK(distances.size() == count);
+
+                float nearest = Infinity;
+                for (size_t i = 0; i < count && i < distances.size(); ++i) {
+                    const glm::mat4 inverse = glm::inverse(models[i]);
+                    float expected;
+                    const bool hit = colliders[i]->intersectsLocalRay(glm::vec3(inverse * glm::vec4(ray.getOrigin(), 1.0f)),
+                                                                      glm::vec3(inverse * glm::vec4(ray.getDirection(), 0.0f)),
+                                                                      MaxDistance, expected);
+                    IDK_CHECK(colliders[i]->intersectsRay(ray, models[i], MaxDistance) == hit);
+
+                    if (!hit) {
+                        mismatches += distances[i] != Infinity;
+                        continue;
+                    }
+                    ++hits;
+                    nearest = std::min(nearest, expected);
+                    mismatches += !(std::fabs(distances[i] - expected) <= 1e-3f * std::max(1.0f, expected));
+                }
+
+                float distance;
+                const int32_t index = batch.raycastNearest(ray.getOrigin(), ray.getDirection(), MaxDistance, distance);
+                if (nearest == Infinity) {
+                    IDK_CHECK(index == -1);
+                } else {
+                    IDK_CHECK(index >= 0);
+                    IDK_CHECK_NEAR(distance, nearest, 1e-3f * std::max(1.0f, nearest));
+                }
+            }
+
+            if (mismatches != 0)
+                std::fprintf(stderr, "%s, %zu colliders: %zu of 64 x %zu lanes differ\n", shape, count, mismatches, count);
+            IDK_CHECK(mismatches == 0);
+            if (count > 100) IDK_CHECK(hits > 0);
+        }
+    }
+
+    void EmptyBatch() {
+        IDK::BoxColliderBatch batch;
+        std::vector<float> distances(3, 0.0f);
+        batch.raycast(glm::vec3(0.0f), glm::vec3(1.0f, 0.0f, 0.0f), MaxDistance, distances);
+        IDK_CHECK(distances.empty());
+
+        float distance;
+        IDK_CHECK(batch.raycastNearest(glm::vec3(0.0f), glm::vec3(1.0f, 0.0f, 0.0f), MaxDistance, distance) == -1);
+    }
+
+    // From inside an end sphere the capsule reports where the ray leaves
+    // that sphere, as the scalar test always has; the lanes must agree.
+    void CapsuleFromInside() {
+        const CapsuleCollider capsule(glm::vec3(0.0f), 1.0f, 2.0f);
+        IDK::CapsuleColliderBatch batch;
+        for (int i = 0; i < 9; ++i) batch.add(capsule, glm::mat4(1.0f));
+
+        const glm::vec3 origin(0.0f, 1.5f, 0.0f), direction(1.0f, 0.0f, 0.0f);
+        float expected;
+        IDK_CHECK(capsule.intersectsLocalRay(origin, direction, MaxDistance, expected));
+
+        std::vector<float> distances;
+        batch.raycast(origin, direction, MaxDistance, distances);
+        for (float distance : distances) IDK_CHECK_NEAR(distance, expected, 1e-5f);
+    }
+}
+
+int main() {
+    StubGL();
+    LanesMatchScalar<BoxCollider>("box");
+    LanesMatchScalar<SphereCollider>("sphere");
+    LanesMatchScalar<CapsuleCollider>("capsule");
+    LanesMatchScalar<CylinderCollider>("cylinder");
+    EmptyBatch();
+    CapsuleFromInside();
+    return IDK_TEST_RESULT();
+}
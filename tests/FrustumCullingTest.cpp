@@ -0,0 +1,95 @@
+//
+// Created by SIMEON on 10/17/2026.
+//
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "gtc/matrix_transform.hpp"
+
+#include "FrustumCulling.h"
+#include "Test.h"
+
+using namespace IDK::Graphics;
+
+// The SIMD kernels (AVX or SSE2, whichever this build targets) against a
+// plain per-box plane test.
+namespace
+{
+    Frustum CameraFrustum() {
+        const glm::mat4 projection = glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 200.0f);
+        const glm::mat4 view = glm::lookAt(glm::vec3(0.0f, 5.0f, 20.0f), glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+        return Frustum::FromMatrix(projection * view);
+    }
+
+    // Smallest plane distance of the box's most positive corner; negative
+    // means outside. Boxes within a rounding error of a plane are skipped.
+    float Margin(const Frustum& frustum, const IDK::AABB& box) {
+        float margin = std::numeric_limits<float>::max();
+        for (const glm::vec4& plane : frustum.planes) {
+            const glm::vec3 corner(plane.x >= 0.0f ? box.max.x : box.min.x,
+                                   plane.y >= 0.0f ? box.max.y : box.min.y,
+                                   plane.z >= 0.0f ? box.max.z : box.min.z);
+            margin = std::min(margin, glm::dot(glm::vec3(plane), corner) + plane.w);
+        }
+        return margin;
+    }
+
+    std::vector<IDK::AABB> RandomBoxes(size_t count, std::mt19937& rng) {
+        std::uniform_real_distribution<float> position(-150.0f, 150.0f), size(0.1f, 8.0f);
+        std::vector<IDK::AABB> boxes;
+        for (size_t i = 0; i < count; ++i) {
+            const glm::vec3 center(position(rng), position(rng) * 0.2f, position(rng));
+            const glm::vec3 extents(size(rng), size(rng), size(rng));
+            boxes.push_back({center - extents, center + extents});
+        }
+        return boxes;
+    }
+
+    void KernelsMatchThePlaneTest() {
+        const Frustum frustum = CameraFrustum();
+        std::mt19937 rng(11);
+
+        // Every remainder of the 8- and 4-wide loops, plus a large batch.
+        for (size_t count : {0u, 1u, 3u, 4u, 7u, 8u, 9u, 15u, 17u, 10001u}) {
+            const std::vector<IDK::AABB> boxes = RandomBoxes(count, rng);
+
+            FrustumCuller culler;
+            for (const IDK::AABB& box : boxes) culler.add(box);
+            std::vector<uint8_t> visible;
+            culler.classify(frustum, visible);
+
+            IDK_CHECK(visible.size() == count);
+            size_t mismatches = 0;
+            for (size_t i = 0; i < count && i < visible.size(); ++i) {
+                const float margin = Margin(frustum, boxes[i]);
+                if (std::fabs(margin) < 1e-3f) continue;
+                mismatches += (margin >= 0.0f) != (visible[i] != 0);
+            }
+            IDK_CHECK(mismatches == 0);
+        }
+    }
+
+    void KnownBoxes() {
+        const Frustum frustum = CameraFrustum();
+        FrustumCuller culler;
+        culler.add({glm::vec3(-1.0f), glm::vec3(1.0f)});                                    // in front of the camera
+        culler.add({glm::vec3(-1.0f, -1.0f, 40.0f), glm::vec3(1.0f, 1.0f, 42.0f)});          // behind it
+        culler.add({glm::vec3(-1.0f, -1.0f, -500.0f), glm::vec3(1.0f, 1.0f, -400.0f)});      // past the far plane
+        culler.add({glm::vec3(-1000.0f, -1.0f, -1.0f), glm::vec3(1000.0f, 1.0f, 1.0f)});     // crosses the side planes
+
+        FrustumCuller::ResetStats();
+        std::vector<uint8_t> visible;
+        culler.cull(frustum, visible);
+        IDK_CHECK(visible == (std::vector<uint8_t>{1, 0, 0, 1}));
+        IDK_CHECK(FrustumCuller::GetStats().visible == 2 && FrustumCuller::GetStats().culled == 2);
+    }
+}
+
+int main() {
+    KernelsMatchThePlaneTest();
+    KnownBoxes();
+    return IDK_TEST_RESULT();
+}
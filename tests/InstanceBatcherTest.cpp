@@ -0,0 +1,156 @@
+//
+// Created by SIMEON on 10/17/2026.
+//
+
+#include <cstdint>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "InstanceBatcher.h"
+#include "Test.h"
+
+using namespace IDK::Graphics;
+
+// InstanceBatcher's ordering contract: one batch per (mesh, shader) in order
+// of first submission, each batch a contiguous slice of the instance data,
+// matrices in submission order within it, and nothing carried across clear().
+namespace
+{
+    // The batcher only compares the pointers, so they need not point at anything.
+    const Mesh* MeshAt(uintptr_t id) { return reinterpret_cast<const Mesh*>(0x1000 + id * 0x100); }
+    const Shader* ShaderAt(uintptr_t id) { return reinterpret_cast<const Shader*>(0x80000 + id * 0x100); }
+
+    struct Submission {
+        const Mesh* mesh;
+        const Shader* shader;
+    };
+
+    // Draws spread over meshes x shaders, partly in runs as RenderQueue's
+    // sorted output arrives and partly interleaved.
+    std::vector<Submission> RandomFrame(std::mt19937& rng, uintptr_t meshes, uintptr_t shaders, size_t count) {
+        std::uniform_int_distribution<uintptr_t> mesh(0, meshes - 1), shader(0, shaders - 1);
+        std::uniform_int_distribution<size_t> runLength(1, 6);
+        std::vector<Submission> frame;
+        while (frame.size() < count) {
+            const Submission submission{MeshAt(mesh(rng)), ShaderAt(shader(rng))};
+            for (size_t run = runLength(rng); run > 0 && frame.size() < count; --run)
+                frame.push_back(submission);
+        }
+        return frame;
+    }
+
+    // Submission i carries i in its translation, so it can be traced through the packing.
+    void Submit(InstanceBatcher& batcher, const std::vector<Submission>& frame) {
+        for (size_t i = 0; i < frame.size(); ++i) {
+            glm::mat4 model(1.0f);
+            model[3][0] = static_cast<float>(i);
+            batcher.add(frame[i].mesh, frame[i].shader, model);
+        }
+    }
+
+    // Checks every part of the contract for one built frame.
+    void CheckFrame(const InstanceBatcher& batcher, const std::vector<Submission>& frame) {
+        std::vector<std::pair<const Mesh*, const Shader*>> expectedOrder;
+        for (const Submission& submission : frame) {
+            bool seen = false;
+            for (const auto& key : expectedOrder)
+                seen |= key.first == submission.mesh && key.second == submission.shader;
+            if (!seen) expectedOrder.emplace_back(submission.mesh, submission.shader);
+        }
+
+        const std::vector<InstanceBatch>& batches = batcher.getBatches();
+        const std::vector<glm::mat4>& instances = batcher.getInstanceData();
+        IDK_CHECK(batcher.getInstanceCount() == frame.size());
+        IDK_CHECK(instances.size() == frame.size());
+        IDK_CHECK(batches.size() == expectedOrder.size());
+        if (batches.size() != expectedOrder.size() || instances.size() != frame.size()) return;
+
+        uint32_t next = 0;
+        for (size_t b = 0; b < batches.size(); ++b) {
+            const InstanceBatch& batch = batches[b];
+            IDK_CHECK(batch.mesh == expectedOrder[b].first && batch.shader == expectedOrder[b].second);
+
+            // Ranges follow each other with no gap or overlap...
+            IDK_CHECK(batch.firstInstance == next);
+            IDK_CHECK(batch.instanceCount > 0);
+            next = batch.firstInstance + batch.instanceCount;
+            if (next > instances.size()) break;
+
+            // ...and hold exactly this pair's submissions, in submission order.
+            size_t expected = 0;
+            for (uint32_t i = batch.firstInstance; i < next; ++i) {
+                while (expected < frame.size() && (frame[expected].mesh != batch.mesh || frame[expected].shader != batch.shader))
+                    ++expected;
+                IDK_CHECK(instances[i][3][0] == static_cast<float>(expected));
+                ++expected;
+            }
+            while (expected < frame.size() && (frame[expected].mesh != batch.mesh || frame[expected].shader != batch.shader))
+                ++expected;
+            IDK_CHECK(expected == frame.size());
+        }
+        IDK_CHECK(next == frame.size());
+    }
+
+    void BatchesFollowSubmission() {
+        std::mt19937 rng(41);
+        InstanceBatcher batcher;
+        for (size_t count : {1u, 2u, 17u, 500u, 5000u}) {
+            const std::vector<Submission> frame = RandomFrame(rng, 9, 4, count);
+            batcher.clear();
+            Submit(batcher, frame);
+            batcher.build();
+            CheckFrame(batcher, frame);
+        }
+    }
+
+    // The same mesh under two shaders, and two meshes under one shader, are
+    // separate batches even when they alternate draw by draw.
+    void PairsAreDistinct() {
+        const std::vector<Submission> frame = {
+            {MeshAt(0), ShaderAt(0)}, {MeshAt(0), ShaderAt(1)}, {MeshAt(1), ShaderAt(0)},
+            {MeshAt(0), ShaderAt(0)}, {MeshAt(0), ShaderAt(1)}, {MeshAt(1), ShaderAt(0)},
+        };
+        InstanceBatcher batcher;
+        Submit(batcher, frame);
+        batcher.build();
+        IDK_CHECK(batcher.getBatches().size() == 3);
+        CheckFrame(batcher, frame);
+    }
+
+    // A busy frame, then clear() and a smaller one with other pairs: only the
+    // second frame's batches and matrices remain. Building twice without a
+    // clear gives the same result as building once.
+    void ClearDropsPreviousFrame() {
+        std::mt19937 rng(43);
+        InstanceBatcher batcher;
+        Submit(batcher, RandomFrame(rng, 16, 4, 3000));
+        batcher.build();
+
+        batcher.clear();
+        IDK_CHECK(batcher.getBatches().empty());
+        IDK_CHECK(batcher.getInstanceData().empty());
+        IDK_CHECK(batcher.getInstanceCount() == 0);
+
+        std::vector<Submission> frame = RandomFrame(rng, 3, 1, 40);
+        for (Submission& submission : frame)
+            submission.mesh = MeshAt(100 + (submission.mesh == MeshAt(0)));
+        Submit(batcher, frame);
+        batcher.build();
+        CheckFrame(batcher, frame);
+        batcher.build();
+        CheckFrame(batcher, frame);
+
+        batcher.clear();
+        batcher.build();
+        IDK_CHECK(batcher.getBatches().empty());
+        IDK_CHECK(batcher.getInstanceData().empty());
+    }
+}
+
+int main() {
+    BatchesFollowSubmission();
+    PairsAreDistinct();
+    ClearDropsPreviousFrame();
+    return IDK_TEST_RESULT();
+}
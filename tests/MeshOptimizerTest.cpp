@@ -0,0 +1,228 @@
+//
+// Created by SIMEON on 10/17/2026.
+//
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "glm.hpp"
+#include "gtc/constants.hpp"
+
+#include "MeshOptimizer.h"
+#include "Test.h"
+
+namespace MeshOptimizer = IDK::Graphics::MeshOptimizer;
+
+// The contracts Mesh::Optimize() relies on: welding and reordering keep the
+// same triangles, the reorder pays for itself in cache misses, the fetch
+// remap numbers vertices by first use, and the cache model counts misses the
+// way a FIFO post-transform cache does.
+namespace
+{
+    // Same layout as Graphics::Vertex, so welding compares the same bytes.
+    struct Vertex {
+        glm::vec3 position;
+        glm::vec3 normal;
+    };
+
+    struct TestMesh {
+        std::vector<Vertex> vertices;
+        std::vector<unsigned int> indices;
+    };
+
+    // Stack/sector layout of Mesh::CreateSphere.
+    TestMesh Sphere(unsigned int stacks, unsigned int sectors) {
+        TestMesh mesh;
+        for (unsigned int i = 0; i <= stacks; ++i) {
+            const float phi = glm::pi<float>() * static_cast<float>(i) / static_cast<float>(stacks);
+            for (unsigned int j = 0; j <= sectors; ++j) {
+                const float theta = glm::two_pi<float>() * static_cast<float>(j) / static_cast<float>(sectors);
+                const glm::vec3 p(std::sin(phi) * std::cos(theta), std::cos(phi), std::sin(phi) * std::sin(theta));
+                mesh.vertices.push_back({p * 0.5f, p});
+            }
+        }
+        for (unsigned int i = 0; i < stacks; ++i) {
+            for (unsigned int j = 0; j < sectors; ++j) {
+                const unsigned int a = i * (sectors + 1) + j;
+                const unsigned int b = a + sectors + 1;
+                mesh.indices.insert(mesh.indices.end(), {a, b, a + 1, b, b + 1, a + 1});
+            }
+        }
+        return mesh;
+    }
+
+    TestMesh Grid(unsigned int size) {
+        TestMesh mesh;
+        for (unsigned int z = 0; z <= size; ++z)
+            for (unsigned int x = 0; x <= size; ++x)
+                mesh.vertices.push_back({glm::vec3(x, 0.0f, z), glm::vec3(0.0f, 1.0f, 0.0f)});
+        for (unsigned int z = 0; z < size; ++z) {
+            for (unsigned int x = 0; x < size; ++x) {
+                const unsigned int a = z * (size + 1) + x;
+                const unsigned int b = a + size + 1;
+                mesh.indices.insert(mesh.indices.end(), {a, b, a + 1, b, b + 1, a + 1});
+            }
+        }
+        return mesh;
+    }
+
+    void Shuffle(std::vector<unsigned int>& indices, std::mt19937& rng) {
+        for (size_t i = indices.size() / 3 - 1; i > 0; --i) {
+            const size_t j = std::uniform_int_distribution<size_t>(0, i)(rng);
+            for (size_t k = 0; k < 3; ++k)
+                std::swap(indices[i * 3 + k], indices[j * 3 + k]);
+        }
+    }
+
+    using Triangle = std::array<unsigned int, 3>;
+
+    // Triangles rotated to start at their smallest index, which keeps the
+    // winding, then sorted: equal lists hold the same triangles.
+    std::vector<Triangle> CanonicalTriangles(const std::vector<unsigned int>& indices) {
+        std::vector<Triangle> triangles;
+        for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+            Triangle t{indices[i], indices[i + 1], indices[i + 2]};
+            std::rotate(t.begin(), std::min_element(t.begin(), t.end()), t.end());
+            triangles.push_back(t);
+        }
+        std::sort(triangles.begin(), triangles.end());
+        return triangles;
+    }
+
+    // An unindexed sphere (three vertices per triangle) welded: every
+    // triangle still has the same corner positions in the same order, and the
+    // unique count is the number of distinct vertex byte patterns.
+    void WeldKeepsTriangles() {
+        const TestMesh indexed = Sphere(12, 16);
+        std::vector<Vertex> soup;
+        for (unsigned int index : indexed.indices) soup.push_back(indexed.vertices[index]);
+
+        std::vector<unsigned int> remap;
+        const size_t unique = MeshOptimizer::BuildWeldRemap(remap, soup.data(), soup.size(), sizeof(Vertex), nullptr, 0);
+
+        std::vector<Vertex> distinct;
+        for (const Vertex& vertex : soup) {
+            const bool seen = std::any_of(distinct.begin(), distinct.end(), [&](const Vertex& other) {
+                return std::memcmp(&vertex, &other, sizeof(Vertex)) == 0;
+            });
+            if (!seen) distinct.push_back(vertex);
+        }
+        IDK_CHECK(unique == distinct.size());
+        IDK_CHECK(unique < soup.size());
+
+        std::vector<Vertex> welded = soup;
+        MeshOptimizer::RemapVertices(welded, remap, unique);
+        IDK_CHECK(welded.size() == unique);
+        for (size_t i = 0; i < soup.size(); ++i) {
+            IDK_CHECK(remap[i] < unique);
+            if (remap[i] < unique) IDK_CHECK(welded[remap[i]].position == soup[i].position);
+        }
+
+        // Indexed input: a vertex no index refers to is dropped.
+        TestMesh grid = Grid(4);
+        grid.vertices.push_back({glm::vec3(-1.0f), glm::vec3(0.0f)});
+        const size_t gridUnique = MeshOptimizer::BuildWeldRemap(remap, grid.vertices.data(), grid.vertices.size(),
+                                                                sizeof(Vertex), grid.indices.data(), grid.indices.size());
+        IDK_CHECK(gridUnique == grid.vertices.size() - 1);
+        IDK_CHECK(remap.back() == ~0u);
+    }
+
+    // Shuffled grid and sphere: the reorder returns the same triangles with
+    // the same winding and fewer cache misses than it was given.
+    void ReorderIsPermutation() {
+        std::mt19937 rng(7);
+        for (TestMesh mesh : {Grid(40), Sphere(32, 48)}) {
+            Shuffle(mesh.indices, rng);
+            const std::vector<Triangle> before = CanonicalTriangles(mesh.indices);
+            const MeshOptimizer::CacheStats shuffled =
+                MeshOptimizer::AnalyzeVertexCache(mesh.indices.data(), mesh.indices.size(), mesh.vertices.size());
+
+            MeshOptimizer::OptimizeVertexCache(mesh.indices.data(), mesh.indices.size(), mesh.vertices.size());
+            IDK_CHECK(CanonicalTriangles(mesh.indices) == before);
+
+            const MeshOptimizer::CacheStats optimized =
+                MeshOptimizer::AnalyzeVertexCache(mesh.indices.data(), mesh.indices.size(), mesh.vertices.size());
+            IDK_CHECK(optimized.acmr < shuffled.acmr);
+            IDK_CHECK(optimized.acmr < 1.0f);
+            IDK_CHECK(optimized.atvr >= 1.0f);
+        }
+    }
+
+    // After the reorder, vertices are renumbered 0, 1, 2... in the order the
+    // index buffer first touches them, and the remapped buffer draws the same
+    // positions.
+    void FetchRemapFollowsFirstUse() {
+        std::mt19937 rng(13);
+        TestMesh mesh = Grid(16);
+        Shuffle(mesh.indices, rng);
+        MeshOptimizer::OptimizeVertexCache(mesh.indices.data(), mesh.indices.size(), mesh.vertices.size());
+        mesh.vertices.push_back({glm::vec3(-1.0f), glm::vec3(0.0f)}); // unreferenced
+
+        std::vector<unsigned int> remap;
+        const size_t count = MeshOptimizer::BuildFetchRemap(remap, mesh.indices.data(), mesh.indices.size(), mesh.vertices.size());
+        IDK_CHECK(count == mesh.vertices.size() - 1);
+        IDK_CHECK(remap.back() == ~0u);
+
+        std::vector<unsigned int> remapped(mesh.indices.size());
+        unsigned int highest = 0;
+        bool firstUseOrder = true;
+        for (size_t i = 0; i < mesh.indices.size(); ++i) {
+            remapped[i] = remap[mesh.indices[i]];
+            if (remapped[i] > highest) {
+                firstUseOrder &= remapped[i] == highest + 1;
+                highest = remapped[i];
+            }
+        }
+        IDK_CHECK(remapped[0] == 0);
+        IDK_CHECK(firstUseOrder);
+        IDK_CHECK(highest + 1 == count);
+
+        std::vector<Vertex> vertices = mesh.vertices;
+        MeshOptimizer::RemapVertices(vertices, remap, count);
+        IDK_CHECK(vertices.size() == count);
+        for (size_t i = 0; i < mesh.indices.size(); ++i)
+            IDK_CHECK(vertices[remapped[i]].position == mesh.vertices[mesh.indices[i]].position);
+    }
+
+    // Miss counts worked out by hand.
+    void AnalyzeKnownMeshes() {
+        // A quad: four misses over two triangles and four vertices.
+        const unsigned int quad[] = {0, 1, 2, 2, 1, 3};
+        MeshOptimizer::CacheStats stats = MeshOptimizer::AnalyzeVertexCache(quad, 6, 4);
+        IDK_CHECK_NEAR(stats.acmr, 2.0f, 1e-6f);
+        IDK_CHECK_NEAR(stats.atvr, 1.0f, 1e-6f);
+
+        // With three entries the second triangle evicts the first, which then misses again.
+        const unsigned int revisit[] = {0, 1, 2, 3, 4, 5, 0, 1, 2};
+        stats = MeshOptimizer::AnalyzeVertexCache(revisit, 9, 6, 3);
+        IDK_CHECK_NEAR(stats.acmr, 3.0f, 1e-6f);
+        IDK_CHECK_NEAR(stats.atvr, 1.5f, 1e-6f);
+        stats = MeshOptimizer::AnalyzeVertexCache(revisit, 9, 6);
+        IDK_CHECK_NEAR(stats.acmr, 2.0f, 1e-6f);
+        IDK_CHECK_NEAR(stats.atvr, 1.0f, 1e-6f);
+
+        // A fan around vertex 0 with four entries. A hit does not refresh an
+        // entry in a FIFO, so 0 misses on the third triangle although it was
+        // used by the second (an LRU cache would still hold it): 8 misses.
+        const unsigned int fan[] = {0, 1, 2, 0, 3, 4, 0, 5, 6};
+        stats = MeshOptimizer::AnalyzeVertexCache(fan, 9, 7, 4);
+        IDK_CHECK_NEAR(stats.acmr, 8.0f / 3.0f, 1e-6f);
+        IDK_CHECK_NEAR(stats.atvr, 8.0f / 7.0f, 1e-6f);
+
+        // Nothing to draw.
+        stats = MeshOptimizer::AnalyzeVertexCache(quad, 2, 4);
+        IDK_CHECK(stats.acmr == 0.0f && stats.atvr == 0.0f);
+    }
+}
+
+int main() {
+    WeldKeepsTriangles();
+    ReorderIsPermutation();
+    FetchRemapFollowsFirstUse();
+    AnalyzeKnownMeshes();
+    return IDK_TEST_RESULT();
+}
@@ -0,0 +1,166 @@
+//
+// Created by SIMEON on 10/17/2026.
+//
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <new>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include "PoolAllocator.h"
+#include "Test.h"
+
+// MeshPoolAllocator and MeshSharedAllocator (MainAllocator.h) are aliases
+// of PoolAllocator; this covers them without pulling in GLFW.
+using IDK::BlockPool;
+using IDK::PoolAllocator;
+
+namespace
+{
+    bool Aligned(const void* ptr, size_t alignment) {
+        return reinterpret_cast<uintptr_t>(ptr) % alignment == 0;
+    }
+
+    size_t Outstanding(size_t blockSize) {
+        for (const auto& stats : BlockPool::GetStats())
+            if (stats.blockSize == blockSize) return stats.blocksOutstanding;
+        return 0;
+    }
+
+    void FreedBlockIsReused() {
+        void* first = BlockPool::Allocate(24);
+        BlockPool::Deallocate(first, 24);
+
+        // 24 and 32 bytes share the 32-byte class; the per-thread free list is LIFO.
+        void* second = BlockPool::Allocate(32);
+        IDK_CHECK(second == first);
+        BlockPool::Deallocate(second, 32);
+    }
+
+    void BlocksAreDistinctAndAligned() {
+        constexpr size_t Count = 5000;  // spans several slabs of the 64-byte class
+        std::vector<std::byte*> blocks;
+        for (size_t i = 0; i < Count; ++i) {
+            auto* block = static_cast<std::byte*>(BlockPool::Allocate(64, 64));
+            std::memset(block, static_cast<int>(i & 0xFF), 64);
+            blocks.push_back(block);
+        }
+
+        std::set<std::byte*> unique(blocks.begin(), blocks.end());
+        IDK_CHECK(unique.size() == Count);
+        IDK_CHECK(std::all_of(blocks.begin(), blocks.end(), [](const std::byte* b) { return Aligned(b, 64); }));
+
+        // No block overlaps its neighbour: each still holds its own fill byte.
+        bool intact = true;
+        for (size_t i = 0; i < Count; ++i)
+            intact &= blocks[i][0] == static_cast<std::byte>(i & 0xFF) && blocks[i][63] == static_cast<std::byte>(i & 0xFF);
+        IDK_CHECK(intact);
+
+        for (std::byte* block : blocks)
+            BlockPool::Deallocate(block, 64, 64);
+    }
+
+    void OversizedAndOveralignedBypassThePool() {
+        void* large = BlockPool::Allocate(BlockPool::MaxBlockSize + 1);
+        IDK_CHECK(large != nullptr);
+        BlockPool::Deallocate(large, BlockPool::MaxBlockSize + 1);
+
+        void* overaligned = BlockPool::Allocate(32, 256);
+        IDK_CHECK(Aligned(overaligned, 256));
+        BlockPool::Deallocate(overaligned, 32, 256);
+
+        void* empty = BlockPool::Allocate(0);
+        IDK_CHECK(empty != nullptr);
+        BlockPool::Deallocate(empty, 0);
+    }
+
+    void ExitingThreadReturnsItsCache() {
+        constexpr size_t BlockSize = 128;
+        const size_t before = Outstanding(BlockSize);
+
+        std::thread worker([] {
+            std::vector<void*> blocks;
+            for (int i = 0; i < 1000; ++i) blocks.push_back(BlockPool::Allocate(BlockSize));
+            for (void* block : blocks) BlockPool::Deallocate(block, BlockSize);
+        });
+        worker.join();
+
+        IDK_CHECK(Outstanding(BlockSize) == before);
+    }
+
+    void BlocksFreedOnAnotherThread() {
+        constexpr size_t BlockSize = 256;
+        std::vector<void*> blocks;
+        for (int i = 0; i < 500; ++i) blocks.push_back(BlockPool::Allocate(BlockSize));
+
+        std::thread worker([&] {
+            for (void* block : blocks) BlockPool::Deallocate(block, BlockSize);
+        });
+        worker.join();
+
+        // The worker's cache went back to the shared list, so the blocks can be handed out again.
+        std::set<void*> freed(blocks.begin(), blocks.end());
+        size_t reused = 0;
+        std::vector<void*> again;
+        for (int i = 0; i < 2000; ++i) {
+            again.push_back(BlockPool::Allocate(BlockSize));
+            reused += freed.count(again.back());
+        }
+        IDK_CHECK(reused > 0);
+        for (void* block : again) BlockPool::Deallocate(block, BlockSize);
+    }
+
+    void AllocatorsCompareEqual() {
+        const PoolAllocator<int> ints;
+        PoolAllocator<int> otherInts;
+        const PoolAllocator<double> doubles;
+        const PoolAllocator<double> rebound(ints);
+
+        IDK_CHECK(ints == otherInts);
+        IDK_CHECK(!(ints != otherInts));
+        IDK_CHECK(ints == doubles);
+        IDK_CHECK(!(ints != doubles));
+        IDK_CHECK(rebound == ints);
+
+        // Equal allocators may free each other's memory.
+        int* values = PoolAllocator<int>().allocate(16);
+        otherInts.deallocate(values, 16);
+        IDK_CHECK(std::allocator_traits<PoolAllocator<int>>::is_always_equal::value);
+    }
+
+    void ContainersAndSharedPointers() {
+        std::vector<uint32_t, PoolAllocator<uint32_t>> indices;
+        for (uint32_t i = 0; i < 100000; ++i) indices.push_back(i);
+        IDK_CHECK(indices.size() == 100000 && indices.front() == 0 && indices.back() == 99999);
+
+        std::vector<uint32_t, PoolAllocator<uint32_t>> copy(indices, PoolAllocator<uint32_t>());
+        IDK_CHECK(copy == indices);
+
+        auto shared = std::allocate_shared<std::vector<float>>(PoolAllocator<std::vector<float>>(), 8, 1.5f);
+        IDK_CHECK(shared->size() == 8 && (*shared)[7] == 1.5f);
+
+        bool threw = false;
+        try {
+            PoolAllocator<uint64_t>().allocate(std::numeric_limits<size_t>::max() / 4);
+        } catch (const std::bad_array_new_length&) {
+            threw = true;
+        }
+        IDK_CHECK(threw);
+    }
+}
+
+int main() {
+    FreedBlockIsReused();
+    BlocksAreDistinctAndAligned();
+    OversizedAndOveralignedBypassThePool();
+    ExitingThreadReturnsItsCache();
+    BlocksFreedOnAnotherThread();
+    AllocatorsCompareEqual();
+    ContainersAndSharedPointers();
+    return IDK_TEST_RESULT();
+}
@@ -0,0 +1,114 @@
+//
+// Created by SIMEON on 10/17/2026.
+//
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "RenderQueue.h"
+#include "Test.h"
+
+using namespace IDK::Graphics;
+
+namespace
+{
+    // Distinct addresses stand in for meshes and shaders; the queue never
+    // dereferences them.
+    const Mesh* FakeMesh(const std::vector<char>& storage, size_t i) {
+        return reinterpret_cast<const Mesh*>(storage.data() + i);
+    }
+
+    uint32_t MeshId(uint64_t key) {
+        return static_cast<uint32_t>((key >> SortKey::DepthBits) & ((1u << SortKey::MeshBits) - 1));
+    }
+
+    void RadixSortMatchesStableSort() {
+        std::mt19937_64 rng(7);
+        std::vector<RenderCommand> commands(50000);
+        for (uint32_t i = 0; i < commands.size(); ++i) {
+            // Few distinct high bits, like real keys, plus fully random ones.
+            const uint64_t key = i % 2 ? rng() : (rng() & 0x00F0'00FF'0000'FFFFull);
+            commands[i] = {key, nullptr, nullptr, i};
+        }
+
+        std::vector<RenderCommand> expected = commands;
+        std::stable_sort(expected.begin(), expected.end(),
+                         [](const RenderCommand& a, const RenderCommand& b) { return a.key < b.key; });
+
+        std::vector<RenderCommand> scratch;
+        RenderQueue::RadixSort(commands, scratch);
+
+        bool same = true;
+        for (size_t i = 0; i < commands.size(); ++i)
+            same &= commands[i].key == expected[i].key && commands[i].transform == expected[i].transform;
+        IDK_CHECK(same);
+    }
+
+    void IdsStayStableWhenTheTableFills() {
+        constexpr size_t Meshes = (size_t(1) << SortKey::MeshBits) + 100;
+        const std::vector<char> storage(Meshes);
+        const glm::mat4 model(1.0f);
+
+        RenderQueue queue;
+        for (size_t i = 0; i < Meshes; ++i)
+            queue.record(RenderPass::Opaque, FakeMesh(storage, i), nullptr, nullptr, model, 0);
+        // Objects seen before the table filled keep their ids for the whole frame.
+        queue.record(RenderPass::Opaque, FakeMesh(storage, 0), nullptr, nullptr, model, 0);
+        queue.record(RenderPass::Opaque, FakeMesh(storage, 1000), nullptr, nullptr, model, 0);
+
+        const auto& commands = queue.getCommands();
+        const uint32_t overflowId = (1u << SortKey::MeshBits) - 1;
+        IDK_CHECK(MeshId(commands[0].key) == 1);
+        IDK_CHECK(MeshId(commands[Meshes].key) == MeshId(commands[0].key));
+        IDK_CHECK(MeshId(commands[Meshes + 1].key) == MeshId(commands[1000].key));
+        IDK_CHECK(MeshId(commands[overflowId - 2].key) == overflowId - 1);
+        IDK_CHECK(MeshId(commands[overflowId - 1].key) == overflowId);
+        IDK_CHECK(MeshId(commands[Meshes - 1].key) == overflowId);
+
+        // Every mesh with its own id sorts ahead of the ones sharing the overflow id.
+        queue.sort();
+        bool ordered = true;
+        for (size_t i = 1; i < queue.getCommands().size(); ++i)
+            ordered &= queue.getCommands()[i - 1].key <= queue.getCommands()[i].key;
+        IDK_CHECK(ordered);
+
+        // The next frame starts over, so the latest meshes get ids of their own.
+        queue.clear();
+        queue.record(RenderPass::Opaque, FakeMesh(storage, Meshes - 1), nullptr, nullptr, model, 0);
+        queue.record(RenderPass::Opaque, FakeMesh(storage, 0), nullptr, nullptr, model, 0);
+        IDK_CHECK(MeshId(queue.getCommands()[0].key) == 1);
+        IDK_CHECK(MeshId(queue.getCommands()[1].key) == 2);
+    }
+
+    void IdsPersistAcrossFramesUntilFull() {
+        const std::vector<char> storage(4);
+        const glm::mat4 model(1.0f);
+
+        RenderQueue queue;
+        queue.record(RenderPass::Opaque, FakeMesh(storage, 2), nullptr, nullptr, model, 0);
+        queue.record(RenderPass::Opaque, FakeMesh(storage, 3), nullptr, nullptr, model, 0);
+        queue.clear();
+        queue.record(RenderPass::Opaque, FakeMesh(storage, 3), nullptr, nullptr, model, 0);
+        IDK_CHECK(MeshId(queue.getCommands()[0].key) == 2);
+        IDK_CHECK(queue.getTransforms().size() == 1);
+    }
+
+    void TransparentSortsBackToFront() {
+        const uint64_t near = SortKey::Make(RenderPass::Transparent, 1, 1, 1, SortKey::QuantizeDepth(1.0f, 100.0f));
+        const uint64_t far = SortKey::Make(RenderPass::Transparent, 1, 1, 1, SortKey::QuantizeDepth(50.0f, 100.0f));
+        const uint64_t opaque = SortKey::Make(RenderPass::Opaque, 4095, 4095, 65535, 0);
+        IDK_CHECK(far < near);
+        IDK_CHECK(opaque < far);
+        IDK_CHECK(SortKey::StateBits(near) == SortKey::StateBits(far));
+    }
+}
+
+int main() {
+    RadixSortMatchesStableSort();
+    IdsStayStableWhenTheTableFills();
+    IdsPersistAcrossFramesUntilFull();
+    TransparentSortsBackToFront();
+    return IDK_TEST_RESULT();
+}
@@ -0,0 +1,165 @@
+//
+// Created by SIMEON on 10/17/2026.
+//
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+#include "gtc/matrix_transform.hpp"
+
+#include "ShadowCascades.h"
+#include "Test.h"
+
+using namespace IDK::Graphics;
+
+// The stability guarantees ShadowCascades makes: splits cover the range in
+// order, each cascade's sphere holds its slice, moving the camera shifts the
+// light-space origin by whole texels and turning it leaves the radius alone.
+namespace
+{
+    constexpr float FovY = 1.0471976f; // 60 degrees
+    constexpr float Aspect = 16.0f / 9.0f;
+    constexpr float NearPlane = 0.1f;
+    constexpr float FarPlane = 500.0f;
+
+    const glm::vec3 LightDirection(-0.4f, -1.0f, -0.3f);
+
+    glm::mat4 CameraView(const glm::vec3& eye, float yaw) {
+        const glm::vec3 forward(std::sin(yaw), -0.2f, -std::cos(yaw));
+        return glm::lookAt(eye, eye + forward, glm::vec3(0.0f, 1.0f, 0.0f));
+    }
+
+    void SplitsAreMonotonic() {
+        for (uint32_t count = 1; count <= ShadowCascades::MaxCascades; ++count) {
+            for (float lambda : {0.0f, 0.5f, 0.75f, 1.0f}) {
+                for (float farPlane : {1.0f, 150.0f, 5000.0f}) {
+                    float splits[ShadowCascades::MaxCascades + 1];
+                    ShadowCascades::ComputeSplits(NearPlane, farPlane, count, lambda, splits);
+
+                    IDK_CHECK(splits[0] == NearPlane);
+                    IDK_CHECK(splits[count] == farPlane);
+                    for (uint32_t i = 0; i < count; ++i)
+                        IDK_CHECK(splits[i] < splits[i + 1]);
+                }
+            }
+        }
+    }
+
+    // All eight corners of the slice lie within the sphere, and some corner
+    // lies on it, so the sphere is no larger than it needs to be.
+    void SphereHoldsSlice() {
+        std::mt19937 rng(5);
+        std::uniform_real_distribution<float> depth(0.05f, 300.0f), fov(0.3f, 2.5f), aspect(0.5f, 3.0f);
+        for (int i = 0; i < 1000; ++i) {
+            float sliceNear = depth(rng), sliceFar = depth(rng);
+            if (sliceNear > sliceFar) std::swap(sliceNear, sliceFar);
+            sliceFar += 0.01f;
+            const float tanHalfFovY = std::tan(0.5f * fov(rng));
+            const float sliceAspect = aspect(rng);
+
+            float centerDepth, radius;
+            ShadowCascades::SliceBoundingSphere(sliceNear, sliceFar, tanHalfFovY, sliceAspect, centerDepth, radius);
+            const glm::vec3 center(0.0f, 0.0f, -centerDepth);
+
+            float farthest = 0.0f;
+            for (float d : {sliceNear, sliceFar}) {
+                const float x = d * tanHalfFovY * sliceAspect, y = d * tanHalfFovY;
+                for (const glm::vec2& sign : {glm::vec2(1.0f), glm::vec2(-1.0f, 1.0f), glm::vec2(1.0f, -1.0f), glm::vec2(-1.0f)})
+                    farthest = std::max(farthest, glm::length(glm::vec3(sign.x * x, sign.y * y, -d) - center));
+            }
+            IDK_CHECK(farthest <= radius * (1.0f + 1e-5f));
+            IDK_CHECK_NEAR(farthest, radius, radius * 1e-5f);
+        }
+    }
+
+    // World-space corners of every cascade's slice land inside its
+    // orthographic box. Snapping moves the box by less than a texel, which
+    // the sphere's rounding up does not always cover, so a texel is allowed.
+    void CascadesHoldTheirSlices() {
+        ShadowCascades cascades;
+        const float tanHalfFovY = std::tan(0.5f * FovY);
+        for (int step = 0; step < 36; ++step) {
+            const glm::mat4 view = CameraView(glm::vec3(3.0f * step, 2.0f, -1.5f * step), glm::radians(10.0f * step));
+            cascades.fit(view, FovY, Aspect, NearPlane, FarPlane, LightDirection);
+            const glm::mat4 cameraWorld = glm::inverse(view);
+
+            for (uint32_t c = 0; c < cascades.getCascadeCount(); ++c) {
+                const ShadowCascade& cascade = cascades.getCascade(c);
+                const float allowance = 1.0f + cascade.texelSize / cascade.radius;
+                for (float d : {cascade.splitNear, cascade.splitFar}) {
+                    const float x = d * tanHalfFovY * Aspect, y = d * tanHalfFovY;
+                    for (const glm::vec2& sign : {glm::vec2(1.0f), glm::vec2(-1.0f, 1.0f), glm::vec2(1.0f, -1.0f), glm::vec2(-1.0f)}) {
+                        const glm::vec4 world = cameraWorld * glm::vec4(sign.x * x, sign.y * y, -d, 1.0f);
+                        const glm::vec4 clip = cascade.viewProjection * world;
+                        IDK_CHECK(std::abs(clip.x) <= allowance);
+                        IDK_CHECK(std::abs(clip.y) <= allowance);
+                        IDK_CHECK(clip.z >= -1.0f && clip.z <= 1.0f);
+                    }
+                }
+            }
+        }
+    }
+
+    // 500 camera translations, fixed orientation: the texel size never
+    // changes, and each cascade's light-space origin moves by whole texels.
+    void TranslationSnapsToTexels() {
+        ShadowCascades cascades;
+        cascades.fit(CameraView(glm::vec3(0.0f), 0.3f), FovY, Aspect, NearPlane, FarPlane, LightDirection);
+
+        float texelSize[ShadowCascades::MaxCascades];
+        glm::vec2 origin[ShadowCascades::MaxCascades];
+        for (uint32_t c = 0; c < cascades.getCascadeCount(); ++c) {
+            texelSize[c] = cascades.getCascade(c).texelSize;
+            origin[c] = glm::vec2(cascades.getCascade(c).view[3]);
+        }
+
+        std::mt19937 rng(17);
+        std::uniform_real_distribution<float> position(-40.0f, 40.0f);
+        size_t fractional = 0;
+        for (int step = 0; step < 500; ++step) {
+            const glm::vec3 eye(position(rng), 0.05f * position(rng), position(rng));
+            cascades.fit(CameraView(eye, 0.3f), FovY, Aspect, NearPlane, FarPlane, LightDirection);
+
+            for (uint32_t c = 0; c < cascades.getCascadeCount(); ++c) {
+                const ShadowCascade& cascade = cascades.getCascade(c);
+                IDK_CHECK(cascade.texelSize == texelSize[c]);
+
+                const glm::vec2 shift = (glm::vec2(cascade.view[3]) - origin[c]) / texelSize[c];
+                const glm::vec2 offWhole = glm::abs(shift - glm::round(shift));
+                fractional += offWhole.x > 1e-2f || offWhole.y > 1e-2f;
+            }
+        }
+        IDK_CHECK(fractional == 0);
+    }
+
+    // 360 one-degree yaw steps in place: the radius, and so the texel size,
+    // is exactly the same every frame.
+    void RotationKeepsRadius() {
+        ShadowCascades cascades;
+        const glm::vec3 eye(12.0f, 3.0f, -7.0f);
+        cascades.fit(CameraView(eye, 0.0f), FovY, Aspect, NearPlane, FarPlane, LightDirection);
+
+        float radius[ShadowCascades::MaxCascades];
+        for (uint32_t c = 0; c < cascades.getCascadeCount(); ++c)
+            radius[c] = cascades.getCascade(c).radius;
+
+        for (int degree = 1; degree <= 360; ++degree) {
+            cascades.fit(CameraView(eye, glm::radians(static_cast<float>(degree))), FovY, Aspect, NearPlane, FarPlane,
+                         LightDirection);
+            for (uint32_t c = 0; c < cascades.getCascadeCount(); ++c) {
+                IDK_CHECK(cascades.getCascade(c).radius == radius[c]);
+                IDK_CHECK(cascades.getCascade(c).texelSize == 2.0f * radius[c] / 2048.0f);
+            }
+        }
+    }
+}
+
+int main() {
+    SplitsAreMonotonic();
+    SphereHoldsSlice();
+    CascadesHoldTheirSlices();
+    TranslationSnapsToTexels();
+    RotationKeepsRadius();
+    return IDK_TEST_RESULT();
+}
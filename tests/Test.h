@@ -0,0 +1,51 @@
+//
+// Created by SIMEON on 10/17/2026.
+//
+
+#ifndef TEST_H
+#define TEST_H
+
+#include <cmath>
+#include <cstdio>
+
+// Minimal checks for the CPU-side unit tests. Every test is its own
+// executable registered with CTest; it prints each failed check and
+// returns non-zero from IDK_TEST_RESULT() if any failed.
+namespace IDK::Test
+{
+    inline int& Failures() {
+        static int failures = 0;
+        return failures;
+    }
+
+    inline bool Check(bool passed, const char* expression, const char* file, int line) {
+        if (!passed) {
+            std::fprintf(stderr, "%s:%d: check failed: %s\n", file, line, expression);
+            ++Failures();
+        }
+        return passed;
+    }
+
+    inline bool Near(float a, float b, float tolerance) {
+        return std::fabs(a - b) <= tolerance;
+    }
+
+    inline int Result(const char* name) {
+        if (Failures() == 0) {
+            std::printf("%s: all checks passed\n", name);
+            return 0;
+        }
+        std::fprintf(stderr, "%s: %d check(s) failed\n", name, Failures());
+        return 1;
+    }
+}
+
+#define IDK_CHECK(expression) \
+    IDK::Test::Check(static_cast<bool>(expression), #expression, __FILE__, __LINE__)
+
+#define IDK_CHECK_NEAR(a, b, tolerance) \
+    IDK::Test::Check(IDK::Test::Near((a), (b), (tolerance)), #a " ~= " #b, __FILE__, __LINE__)
+
+#define IDK_TEST_RESULT() IDK::Test::Result(__FILE__)
+
+#endif //TEST_H
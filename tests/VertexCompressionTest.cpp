@@ -0,0 +1,140 @@
+//
+// Created by SIMEON on 10/17/2026.
+//
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "VertexCompression.h"
+#include "Test.h"
+
+using namespace IDK::Graphics;
+
+// What CompactHalf and CompactSnorm16 keep of a vertex: octahedral normals
+// come back within snorm16 precision of the input direction, positions
+// within one quantization step of their bounds, and degenerate normals
+// encode to something finite.
+namespace
+{
+    // Unit normals worth checking by hand: the axes, where the octahedron's
+    // folds meet, and the eight diagonals.
+    std::vector<glm::vec3> SpecialNormals() {
+        std::vector<glm::vec3> normals;
+        for (float sign : {1.0f, -1.0f}) {
+            normals.emplace_back(sign, 0.0f, 0.0f);
+            normals.emplace_back(0.0f, sign, 0.0f);
+            normals.emplace_back(0.0f, 0.0f, sign);
+        }
+        for (float x : {1.0f, -1.0f})
+            for (float y : {1.0f, -1.0f})
+                for (float z : {1.0f, -1.0f})
+                    normals.push_back(glm::normalize(glm::vec3(x, y, z)));
+        return normals;
+    }
+
+    std::vector<glm::vec3> RandomNormals(size_t count) {
+        std::mt19937 rng(11);
+        std::normal_distribution<float> gaussian;
+        std::vector<glm::vec3> normals;
+        while (normals.size() < count) {
+            const glm::vec3 n(gaussian(rng), gaussian(rng), gaussian(rng));
+            if (glm::length(n) > 1e-3f) normals.push_back(glm::normalize(n));
+        }
+        return normals;
+    }
+
+    // Unquantized, the mapping is exact up to float rounding; through the two
+    // snorm16 components the decoded normal stays within 1e-4 of the input
+    // (measured as a chord, since float acos is too coarse near zero).
+    void OctRoundTrip() {
+        std::vector<glm::vec3> normals = SpecialNormals();
+        const std::vector<glm::vec3> random = RandomNormals(20000);
+        normals.insert(normals.end(), random.begin(), random.end());
+
+        const PositionQuantization quantization;
+        float worstExact = 0.0f, worstPacked = 0.0f;
+        for (const glm::vec3& n : normals) {
+            const glm::vec2 e = VertexCompression::OctEncode(n);
+            IDK_CHECK(std::abs(e.x) <= 1.0f && std::abs(e.y) <= 1.0f);
+            worstExact = std::max(worstExact, glm::length(VertexCompression::OctDecode(e) - n));
+
+            const CompactVertex packed = VertexCompression::Encode(glm::vec3(0.0f), n, quantization, VertexFormat::CompactSnorm16);
+            worstPacked = std::max(worstPacked, glm::length(VertexCompression::DecodeNormal(packed) - n));
+        }
+        IDK_CHECK(worstExact < 1e-6f);
+        IDK_CHECK(worstPacked < 1e-4f);
+    }
+
+    // A zero normal, one too small to divide by, and a NaN encode to (0, 0)
+    // and decode to +Z instead of carrying a NaN into packSnorm1x16.
+    void DegenerateNormals() {
+        const PositionQuantization quantization;
+        for (const glm::vec3& n : {glm::vec3(0.0f), glm::vec3(1e-45f, 0.0f, 0.0f), glm::vec3(std::nanf(""))}) {
+            const glm::vec2 e = VertexCompression::OctEncode(n);
+            IDK_CHECK(e.x == 0.0f && e.y == 0.0f);
+
+            const CompactVertex packed = VertexCompression::Encode(glm::vec3(0.0f), n, quantization, VertexFormat::CompactSnorm16);
+            IDK_CHECK(packed.normal[0] == 0 && packed.normal[1] == 0);
+            const glm::vec3 decoded = VertexCompression::DecodeNormal(packed);
+            IDK_CHECK(decoded == glm::vec3(0.0f, 0.0f, 1.0f));
+        }
+    }
+
+    // Random points in lopsided bounds, plus every corner of them. snorm16
+    // rounds to the nearest of 65535 levels across the bounds; half keeps an
+    // 11-bit significand, so in [-1, 1] its step is at most 2^-11 of the half-extent.
+    void PositionRoundTrip() {
+        const glm::vec3 boundsMin(-3.0f, 0.25f, -1000.0f), boundsMax(5.0f, 0.75f, 20.0f);
+        const PositionQuantization quantization = VertexCompression::ComputeQuantization(boundsMin, boundsMax);
+
+        std::vector<glm::vec3> positions;
+        for (int corner = 0; corner < 8; ++corner)
+            positions.emplace_back(corner & 1 ? boundsMax.x : boundsMin.x, corner & 2 ? boundsMax.y : boundsMin.y,
+                                   corner & 4 ? boundsMax.z : boundsMin.z);
+        std::mt19937 rng(3);
+        std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+        for (int i = 0; i < 10000; ++i)
+            positions.push_back(boundsMin + (boundsMax - boundsMin) * glm::vec3(unit(rng), unit(rng), unit(rng)));
+
+        const glm::vec3 snormStep = quantization.scale / 32767.0f;
+        const glm::vec3 halfStep = quantization.scale / 2048.0f;
+        for (const glm::vec3& position : positions) {
+            const glm::vec3 snorm = VertexCompression::DecodePosition(
+                VertexCompression::Encode(position, glm::vec3(0.0f, 1.0f, 0.0f), quantization, VertexFormat::CompactSnorm16),
+                quantization, VertexFormat::CompactSnorm16);
+            const glm::vec3 half = VertexCompression::DecodePosition(
+                VertexCompression::Encode(position, glm::vec3(0.0f, 1.0f, 0.0f), quantization, VertexFormat::CompactHalf),
+                quantization, VertexFormat::CompactHalf);
+
+            for (int axis = 0; axis < 3; ++axis) {
+                IDK_CHECK(std::abs(snorm[axis] - position[axis]) <= snormStep[axis]);
+                IDK_CHECK(std::abs(half[axis] - position[axis]) <= halfStep[axis]);
+            }
+        }
+
+        // A flat axis keeps a usable scale and decodes to the plane's coordinate.
+        const PositionQuantization flat = VertexCompression::ComputeQuantization(glm::vec3(0.0f, 2.0f, 0.0f), glm::vec3(1.0f, 2.0f, 1.0f));
+        IDK_CHECK(flat.scale.y == 1.0f);
+        const glm::vec3 onPlane = VertexCompression::DecodePosition(
+            VertexCompression::Encode(glm::vec3(0.5f, 2.0f, 0.5f), glm::vec3(0.0f, 1.0f, 0.0f), flat, VertexFormat::CompactSnorm16),
+            flat, VertexFormat::CompactSnorm16);
+        IDK_CHECK(onPlane.y == 2.0f);
+    }
+
+    // 0x10000 vertices are indices 0..0xFFFF, the last count that fits.
+    void UInt16IndexCutoff() {
+        IDK_CHECK(VertexCompression::FitsUInt16Indices(0));
+        IDK_CHECK(VertexCompression::FitsUInt16Indices(0xFFFF));
+        IDK_CHECK(VertexCompression::FitsUInt16Indices(0x10000));
+        IDK_CHECK(!VertexCompression::FitsUInt16Indices(0x10001));
+    }
+}
+
+int main() {
+    OctRoundTrip();
+    DegenerateNormals();
+    PositionRoundTrip();
+    UInt16IndexCutoff();
+    return IDK_TEST_RESULT();
+}